@@ -121,7 +121,6 @@ const Gfx coin_seg3_dl_start[] = {
 // clear geo
 // 0x030077D0 - 0x03007800
 const Gfx coin_seg3_dl_end[] = {
-    gsSP2Triangles( 0,  1,  2, 0x0,  0,  2,  3, 0x0),
     gsSPTexture(0x0001, 0x0001, 0, G_TX_RENDERTILE, G_OFF),
     gsDPPipeSync(),
     gsDPSetCombineMode(G_CC_SHADE, G_CC_SHADE),
@@ -129,264 +128,280 @@ const Gfx coin_seg3_dl_end[] = {
     gsSPEndDisplayList(),
 };
 
-// YELLOW
-const Gfx coin_seg3_dl_yellow_0[] = {
+// Each frame's texture and each color's quad, which the coins below are made of. Drawing several coins
+// with the same frame loads its texture once, then only draws their quads.
+const Gfx coin_seg3_sub_dl_texture_0[] = {
     gsDPPipeSync(),
     gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_8b, 64, coin_seg3_texture_0_ia8),
-    gsSPDisplayList(coin_seg3_dl_start),
-    gsSPVertex(coin_seg3_vertex_yellow, 4, 0),
-    gsSPBranchList(coin_seg3_dl_end),
+    gsSPBranchList(coin_seg3_dl_start),
 };
 
-const Gfx coin_seg3_dl_yellow_22_5[] = {
+const Gfx coin_seg3_sub_dl_texture_22_5[] = {
     gsDPPipeSync(),
     gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_8b, 64, coin_seg3_texture_22_5_ia8),
-    gsSPDisplayList(coin_seg3_dl_start),
-    gsSPVertex(coin_seg3_vertex_yellow, 4, 0),
-    gsSPBranchList(coin_seg3_dl_end),
+    gsSPBranchList(coin_seg3_dl_start),
 };
 
-const Gfx coin_seg3_dl_yellow_45[] = {
+const Gfx coin_seg3_sub_dl_texture_45[] = {
     gsDPPipeSync(),
     gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_8b, 64, coin_seg3_texture_45_ia8),
-    gsSPDisplayList(coin_seg3_dl_start),
-    gsSPVertex(coin_seg3_vertex_yellow, 4, 0),
-    gsSPBranchList(coin_seg3_dl_end),
+    gsSPBranchList(coin_seg3_dl_start),
 };
 
-const Gfx coin_seg3_dl_yellow_67_5[] = {
+const Gfx coin_seg3_sub_dl_texture_67_5[] = {
     gsDPPipeSync(),
     gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_8b, 64, coin_seg3_texture_67_5_ia8),
-    gsSPDisplayList(coin_seg3_dl_start),
-    gsSPVertex(coin_seg3_vertex_yellow, 4, 0),
-    gsSPBranchList(coin_seg3_dl_end),
+    gsSPBranchList(coin_seg3_dl_start),
 };
 
-const Gfx coin_seg3_dl_yellow_90[] = {
+const Gfx coin_seg3_sub_dl_texture_90[] = {
     gsDPPipeSync(),
     gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_8b, 64, coin_seg3_texture_90_ia8),
-    gsSPDisplayList(coin_seg3_dl_start),
+    gsSPBranchList(coin_seg3_dl_start),
+};
+
+const Gfx coin_seg3_sub_dl_quad_yellow[] = {
     gsSPVertex(coin_seg3_vertex_yellow, 4, 0),
+    gsSP2Triangles( 0,  1,  2, 0x0,  0,  2,  3, 0x0),
+    gsSPEndDisplayList(),
+};
+
+const Gfx coin_seg3_sub_dl_quad_yellow_r[] = {
+    gsSPVertex(coin_seg3_vertex_yellow_r, 4, 0),
+    gsSP2Triangles( 0,  1,  2, 0x0,  0,  2,  3, 0x0),
+    gsSPEndDisplayList(),
+};
+
+const Gfx coin_seg3_sub_dl_quad_blue[] = {
+    gsSPVertex(coin_seg3_vertex_blue, 4, 0),
+    gsSP2Triangles( 0,  1,  2, 0x0,  0,  2,  3, 0x0),
+    gsSPEndDisplayList(),
+};
+
+const Gfx coin_seg3_sub_dl_quad_blue_r[] = {
+    gsSPVertex(coin_seg3_vertex_blue_r, 4, 0),
+    gsSP2Triangles( 0,  1,  2, 0x0,  0,  2,  3, 0x0),
+    gsSPEndDisplayList(),
+};
+
+const Gfx coin_seg3_sub_dl_quad_red[] = {
+    gsSPVertex(coin_seg3_vertex_red, 4, 0),
+    gsSP2Triangles( 0,  1,  2, 0x0,  0,  2,  3, 0x0),
+    gsSPEndDisplayList(),
+};
+
+const Gfx coin_seg3_sub_dl_quad_red_r[] = {
+    gsSPVertex(coin_seg3_vertex_red_r, 4, 0),
+    gsSP2Triangles( 0,  1,  2, 0x0,  0,  2,  3, 0x0),
+    gsSPEndDisplayList(),
+};
+
+const Gfx coin_seg3_sub_dl_quad_secret[] = {
+    gsSPVertex(coin_seg3_vertex_secret, 4, 0),
+    gsSP2Triangles( 0,  1,  2, 0x0,  0,  2,  3, 0x0),
+    gsSPEndDisplayList(),
+};
+
+const Gfx coin_seg3_sub_dl_quad_secret_r[] = {
+    gsSPVertex(coin_seg3_vertex_secret_r, 4, 0),
+    gsSP2Triangles( 0,  1,  2, 0x0,  0,  2,  3, 0x0),
+    gsSPEndDisplayList(),
+};
+
+// YELLOW
+const Gfx coin_seg3_dl_yellow_0[] = {
+    gsSPDisplayList(coin_seg3_sub_dl_texture_0),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_yellow),
+    gsSPBranchList(coin_seg3_dl_end),
+};
+
+const Gfx coin_seg3_dl_yellow_22_5[] = {
+    gsSPDisplayList(coin_seg3_sub_dl_texture_22_5),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_yellow),
+    gsSPBranchList(coin_seg3_dl_end),
+};
+
+const Gfx coin_seg3_dl_yellow_45[] = {
+    gsSPDisplayList(coin_seg3_sub_dl_texture_45),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_yellow),
+    gsSPBranchList(coin_seg3_dl_end),
+};
+
+const Gfx coin_seg3_dl_yellow_67_5[] = {
+    gsSPDisplayList(coin_seg3_sub_dl_texture_67_5),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_yellow),
+    gsSPBranchList(coin_seg3_dl_end),
+};
+
+const Gfx coin_seg3_dl_yellow_90[] = {
+    gsSPDisplayList(coin_seg3_sub_dl_texture_90),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_yellow),
     gsSPBranchList(coin_seg3_dl_end),
 };
 
 const Gfx coin_seg3_dl_yellow_67_5_r[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_8b, 64, coin_seg3_texture_67_5_ia8),
-    gsSPDisplayList(coin_seg3_dl_start),
-    gsSPVertex(coin_seg3_vertex_yellow_r, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_67_5),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_yellow_r),
     gsSPBranchList(coin_seg3_dl_end),
 };
 
 const Gfx coin_seg3_dl_yellow_45_r[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_8b, 64, coin_seg3_texture_45_ia8),
-    gsSPDisplayList(coin_seg3_dl_start),
-    gsSPVertex(coin_seg3_vertex_yellow_r, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_45),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_yellow_r),
     gsSPBranchList(coin_seg3_dl_end),
 };
 
 const Gfx coin_seg3_dl_yellow_22_5_r[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_8b, 64, coin_seg3_texture_22_5_ia8),
-    gsSPDisplayList(coin_seg3_dl_start),
-    gsSPVertex(coin_seg3_vertex_yellow_r, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_22_5),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_yellow_r),
     gsSPBranchList(coin_seg3_dl_end),
 };
 
 // BLUE
 const Gfx coin_seg3_dl_blue_0[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_8b, 64, coin_seg3_texture_0_ia8),
-    gsSPDisplayList(coin_seg3_dl_start),
-    gsSPVertex(coin_seg3_vertex_blue, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_0),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_blue),
     gsSPBranchList(coin_seg3_dl_end),
 };
 
 const Gfx coin_seg3_dl_blue_22_5[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_8b, 64, coin_seg3_texture_22_5_ia8),
-    gsSPDisplayList(coin_seg3_dl_start),
-    gsSPVertex(coin_seg3_vertex_blue, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_22_5),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_blue),
     gsSPBranchList(coin_seg3_dl_end),
 };
 
 const Gfx coin_seg3_dl_blue_45[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_8b, 64, coin_seg3_texture_45_ia8),
-    gsSPDisplayList(coin_seg3_dl_start),
-    gsSPVertex(coin_seg3_vertex_blue, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_45),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_blue),
     gsSPBranchList(coin_seg3_dl_end),
 };
 
 const Gfx coin_seg3_dl_blue_67_5[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_8b, 64, coin_seg3_texture_67_5_ia8),
-    gsSPDisplayList(coin_seg3_dl_start),
-    gsSPVertex(coin_seg3_vertex_blue, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_67_5),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_blue),
     gsSPBranchList(coin_seg3_dl_end),
 };
 
 const Gfx coin_seg3_dl_blue_90[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_8b, 64, coin_seg3_texture_90_ia8),
-    gsSPDisplayList(coin_seg3_dl_start),
-    gsSPVertex(coin_seg3_vertex_blue, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_90),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_blue),
     gsSPBranchList(coin_seg3_dl_end),
 };
 
 const Gfx coin_seg3_dl_blue_67_5_r[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_8b, 64, coin_seg3_texture_67_5_ia8),
-    gsSPDisplayList(coin_seg3_dl_start),
-    gsSPVertex(coin_seg3_vertex_blue_r, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_67_5),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_blue_r),
     gsSPBranchList(coin_seg3_dl_end),
 };
 
 const Gfx coin_seg3_dl_blue_22_5_r[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_8b, 64, coin_seg3_texture_22_5_ia8),
-    gsSPDisplayList(coin_seg3_dl_start),
-    gsSPVertex(coin_seg3_vertex_blue_r, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_22_5),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_blue_r),
     gsSPBranchList(coin_seg3_dl_end),
 };
 
 const Gfx coin_seg3_dl_blue_45_r[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_8b, 64, coin_seg3_texture_45_ia8),
-    gsSPDisplayList(coin_seg3_dl_start),
-    gsSPVertex(coin_seg3_vertex_blue_r, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_45),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_blue_r),
     gsSPBranchList(coin_seg3_dl_end),
 };
 
 // RED
 const Gfx coin_seg3_dl_red_0[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_8b, 64, coin_seg3_texture_0_ia8),
-    gsSPDisplayList(coin_seg3_dl_start),
-    gsSPVertex(coin_seg3_vertex_red, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_0),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_red),
     gsSPBranchList(coin_seg3_dl_end),
 };
 
 const Gfx coin_seg3_dl_red_22_5[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_8b, 64, coin_seg3_texture_22_5_ia8),
-    gsSPDisplayList(coin_seg3_dl_start),
-    gsSPVertex(coin_seg3_vertex_red, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_22_5),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_red),
     gsSPBranchList(coin_seg3_dl_end),
 };
 
 const Gfx coin_seg3_dl_red_45[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_8b, 64, coin_seg3_texture_45_ia8),
-    gsSPDisplayList(coin_seg3_dl_start),
-    gsSPVertex(coin_seg3_vertex_red, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_45),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_red),
     gsSPBranchList(coin_seg3_dl_end),
 };
 
 const Gfx coin_seg3_dl_red_67_5[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_8b, 64, coin_seg3_texture_67_5_ia8),
-    gsSPDisplayList(coin_seg3_dl_start),
-    gsSPVertex(coin_seg3_vertex_red, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_67_5),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_red),
     gsSPBranchList(coin_seg3_dl_end),
 };
 
 const Gfx coin_seg3_dl_red_90[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_8b, 64, coin_seg3_texture_90_ia8),
-    gsSPDisplayList(coin_seg3_dl_start),
-    gsSPVertex(coin_seg3_vertex_red, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_90),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_red),
     gsSPBranchList(coin_seg3_dl_end),
 };
 
 const Gfx coin_seg3_dl_red_67_5_r[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_8b, 64, coin_seg3_texture_67_5_ia8),
-    gsSPDisplayList(coin_seg3_dl_start),
-    gsSPVertex(coin_seg3_vertex_red_r, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_67_5),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_red_r),
     gsSPBranchList(coin_seg3_dl_end),
 };
 
 const Gfx coin_seg3_dl_red_45_r[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_8b, 64, coin_seg3_texture_45_ia8),
-    gsSPDisplayList(coin_seg3_dl_start),
-    gsSPVertex(coin_seg3_vertex_red_r, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_45),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_red_r),
     gsSPBranchList(coin_seg3_dl_end),
 };
 
 
 const Gfx coin_seg3_dl_red_22_5_r[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_8b, 64, coin_seg3_texture_22_5_ia8),
-    gsSPDisplayList(coin_seg3_dl_start),
-    gsSPVertex(coin_seg3_vertex_red_r, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_22_5),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_red_r),
     gsSPBranchList(coin_seg3_dl_end),
 };
 // SECRET
 const Gfx coin_seg3_dl_secret_0[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_8b, 64, coin_seg3_texture_0_ia8),
-    gsSPDisplayList(coin_seg3_dl_start),
-    gsSPVertex(coin_seg3_vertex_secret, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_0),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_secret),
     gsSPBranchList(coin_seg3_dl_end),
 };
 
 const Gfx coin_seg3_dl_secret_22_5[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_8b, 64, coin_seg3_texture_22_5_ia8),
-    gsSPDisplayList(coin_seg3_dl_start),
-    gsSPVertex(coin_seg3_vertex_secret, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_22_5),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_secret),
     gsSPBranchList(coin_seg3_dl_end),
 };
 
 const Gfx coin_seg3_dl_secret_45[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_8b, 64, coin_seg3_texture_45_ia8),
-    gsSPDisplayList(coin_seg3_dl_start),
-    gsSPVertex(coin_seg3_vertex_secret, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_45),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_secret),
     gsSPBranchList(coin_seg3_dl_end),
 };
 
 const Gfx coin_seg3_dl_secret_67_5[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_8b, 64, coin_seg3_texture_67_5_ia8),
-    gsSPDisplayList(coin_seg3_dl_start),
-    gsSPVertex(coin_seg3_vertex_secret, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_67_5),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_secret),
     gsSPBranchList(coin_seg3_dl_end),
 };
 
 const Gfx coin_seg3_dl_secret_90[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_8b, 64, coin_seg3_texture_90_ia8),
-    gsSPDisplayList(coin_seg3_dl_start),
-    gsSPVertex(coin_seg3_vertex_secret, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_90),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_secret),
     gsSPBranchList(coin_seg3_dl_end),
 };
 
 const Gfx coin_seg3_dl_secret_67_5_r[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_8b, 64, coin_seg3_texture_67_5_ia8),
-    gsSPDisplayList(coin_seg3_dl_start),
-    gsSPVertex(coin_seg3_vertex_secret_r, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_67_5),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_secret_r),
     gsSPBranchList(coin_seg3_dl_end),
 };
 
 const Gfx coin_seg3_dl_secret_45_r[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_8b, 64, coin_seg3_texture_45_ia8),
-    gsSPDisplayList(coin_seg3_dl_start),
-    gsSPVertex(coin_seg3_vertex_secret_r, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_45),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_secret_r),
     gsSPBranchList(coin_seg3_dl_end),
 };
 
 
 const Gfx coin_seg3_dl_secret_22_5_r[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_8b, 64, coin_seg3_texture_22_5_ia8),
-    gsSPDisplayList(coin_seg3_dl_start),
-    gsSPVertex(coin_seg3_vertex_secret_r, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_22_5),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_secret_r),
     gsSPBranchList(coin_seg3_dl_end),
 };
 
@@ -502,7 +517,6 @@ const Gfx coin_seg3_sub_dl_begin[] = {
 
 // 0x030077D0 - 0x03007800
 const Gfx coin_seg3_sub_dl_end[] = {
-    gsSP2Triangles( 0,  1,  2, 0x0,  0,  2,  3, 0x0),
     gsSPTexture(0x0001, 0x0001, 0, G_TX_RENDERTILE, G_OFF),
     gsDPPipeSync(),
     gsDPSetCombineMode(G_CC_SHADE, G_CC_SHADE),
@@ -510,111 +524,131 @@ const Gfx coin_seg3_sub_dl_end[] = {
     gsSPEndDisplayList(),
 };
 
-// 0x03007800 - 0x03007828
-const Gfx coin_seg3_dl_yellow_front[] = {
+// The texture of each frame and the quad of each color the coins below are drawn with, so coins showing
+// the same frame can share a single texture load.
+const Gfx coin_seg3_sub_dl_texture_front[] = {
     gsDPPipeSync(),
     gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_16b, 1, coin_seg3_texture_front),
-    gsSPDisplayList(coin_seg3_sub_dl_begin),
+    gsSPBranchList(coin_seg3_sub_dl_begin),
+};
+
+const Gfx coin_seg3_sub_dl_texture_tilt_right[] = {
+    gsDPPipeSync(),
+    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_16b, 1, coin_seg3_texture_tilt_right),
+    gsSPBranchList(coin_seg3_sub_dl_begin),
+};
+
+const Gfx coin_seg3_sub_dl_texture_side[] = {
+    gsDPPipeSync(),
+    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_16b, 1, coin_seg3_texture_side),
+    gsSPBranchList(coin_seg3_sub_dl_begin),
+};
+
+const Gfx coin_seg3_sub_dl_texture_tilt_left[] = {
+    gsDPPipeSync(),
+    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_16b, 1, coin_seg3_texture_tilt_left),
+    gsSPBranchList(coin_seg3_sub_dl_begin),
+};
+
+const Gfx coin_seg3_sub_dl_quad_yellow[] = {
     gsSPVertex(coin_seg3_vertex_yellow, 4, 0),
+    gsSP2Triangles( 0,  1,  2, 0x0,  0,  2,  3, 0x0),
+    gsSPEndDisplayList(),
+};
+
+const Gfx coin_seg3_sub_dl_quad_blue[] = {
+    gsSPVertex(coin_seg3_vertex_blue, 4, 0),
+    gsSP2Triangles( 0,  1,  2, 0x0,  0,  2,  3, 0x0),
+    gsSPEndDisplayList(),
+};
+
+const Gfx coin_seg3_sub_dl_quad_red[] = {
+    gsSPVertex(coin_seg3_vertex_red, 4, 0),
+    gsSP2Triangles( 0,  1,  2, 0x0,  0,  2,  3, 0x0),
+    gsSPEndDisplayList(),
+};
+
+// 0x03007800 - 0x03007828
+const Gfx coin_seg3_dl_yellow_front[] = {
+    gsSPDisplayList(coin_seg3_sub_dl_texture_front),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_yellow),
     gsSPBranchList(coin_seg3_sub_dl_end),
 };
 
 // 0x03007828 - 0x03007850
 const Gfx coin_seg3_dl_yellow_tilt_right[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_16b, 1, coin_seg3_texture_tilt_right),
-    gsSPDisplayList(coin_seg3_sub_dl_begin),
-    gsSPVertex(coin_seg3_vertex_yellow, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_tilt_right),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_yellow),
     gsSPBranchList(coin_seg3_sub_dl_end),
 };
 
 // 0x03007850 - 0x03007878
 const Gfx coin_seg3_dl_yellow_side[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_16b, 1, coin_seg3_texture_side),
-    gsSPDisplayList(coin_seg3_sub_dl_begin),
-    gsSPVertex(coin_seg3_vertex_yellow, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_side),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_yellow),
     gsSPBranchList(coin_seg3_sub_dl_end),
 };
 
 // 0x03007878 - 0x030078A0
 const Gfx coin_seg3_dl_yellow_tilt_left[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_16b, 1, coin_seg3_texture_tilt_left),
-    gsSPDisplayList(coin_seg3_sub_dl_begin),
-    gsSPVertex(coin_seg3_vertex_yellow, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_tilt_left),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_yellow),
     gsSPBranchList(coin_seg3_sub_dl_end),
 };
 
 // 0x030078A0 - 0x030078C8
 const Gfx coin_seg3_dl_blue_front[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_16b, 1, coin_seg3_texture_front),
-    gsSPDisplayList(coin_seg3_sub_dl_begin),
-    gsSPVertex(coin_seg3_vertex_blue, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_front),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_blue),
     gsSPBranchList(coin_seg3_sub_dl_end),
 };
 
 // 0x030078C8 - 0x030078F0
 const Gfx coin_seg3_dl_blue_tilt_right[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_16b, 1, coin_seg3_texture_tilt_right),
-    gsSPDisplayList(coin_seg3_sub_dl_begin),
-    gsSPVertex(coin_seg3_vertex_blue, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_tilt_right),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_blue),
     gsSPBranchList(coin_seg3_sub_dl_end),
 };
 
 // 0x030078F0 - 0x03007918
 const Gfx coin_seg3_dl_blue_side[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_16b, 1, coin_seg3_texture_side),
-    gsSPDisplayList(coin_seg3_sub_dl_begin),
-    gsSPVertex(coin_seg3_vertex_blue, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_side),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_blue),
     gsSPBranchList(coin_seg3_sub_dl_end),
 };
 
 // 0x03007918 - 0x03007940
 const Gfx coin_seg3_dl_blue_tilt_left[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_16b, 1, coin_seg3_texture_tilt_left),
-    gsSPDisplayList(coin_seg3_sub_dl_begin),
-    gsSPVertex(coin_seg3_vertex_blue, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_tilt_left),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_blue),
     gsSPBranchList(coin_seg3_sub_dl_end),
 };
 
 // 0x03007940 - 0x03007968
 const Gfx coin_seg3_dl_red_front[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_16b, 1, coin_seg3_texture_front),
-    gsSPDisplayList(coin_seg3_sub_dl_begin),
-    gsSPVertex(coin_seg3_vertex_red, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_front),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_red),
     gsSPBranchList(coin_seg3_sub_dl_end),
 };
 
 // 0x03007968 - 0x03007990
 const Gfx coin_seg3_dl_red_tilt_right[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_16b, 1, coin_seg3_texture_tilt_right),
-    gsSPDisplayList(coin_seg3_sub_dl_begin),
-    gsSPVertex(coin_seg3_vertex_red, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_tilt_right),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_red),
     gsSPBranchList(coin_seg3_sub_dl_end),
 };
 
 // 0x03007990 - 0x030079B8
 const Gfx coin_seg3_dl_red_side[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_16b, 1, coin_seg3_texture_side),
-    gsSPDisplayList(coin_seg3_sub_dl_begin),
-    gsSPVertex(coin_seg3_vertex_red, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_side),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_red),
     gsSPBranchList(coin_seg3_sub_dl_end),
 };
 
 // 0x030079B8 - 0x030079E0
 const Gfx coin_seg3_dl_red_tilt_left[] = {
-    gsDPPipeSync(),
-    gsDPSetTextureImage(G_IM_FMT_IA, G_IM_SIZ_16b, 1, coin_seg3_texture_tilt_left),
-    gsSPDisplayList(coin_seg3_sub_dl_begin),
-    gsSPVertex(coin_seg3_vertex_red, 4, 0),
+    gsSPDisplayList(coin_seg3_sub_dl_texture_tilt_left),
+    gsSPDisplayList(coin_seg3_sub_dl_quad_red),
     gsSPBranchList(coin_seg3_sub_dl_end),
 };
 
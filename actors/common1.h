@@ -71,9 +71,31 @@ extern const Gfx coin_seg3_dl_secret_67_5_r[];
 extern const Gfx coin_seg3_dl_secret_45_r[];
 extern const Gfx coin_seg3_dl_secret_22_5_r[];
 
+extern const Gfx coin_seg3_dl_end[];
+extern const Gfx coin_seg3_sub_dl_texture_0[];
+extern const Gfx coin_seg3_sub_dl_texture_22_5[];
+extern const Gfx coin_seg3_sub_dl_texture_45[];
+extern const Gfx coin_seg3_sub_dl_texture_67_5[];
+extern const Gfx coin_seg3_sub_dl_texture_90[];
+extern const Gfx coin_seg3_sub_dl_quad_yellow[];
+extern const Gfx coin_seg3_sub_dl_quad_yellow_r[];
+extern const Gfx coin_seg3_sub_dl_quad_blue[];
+extern const Gfx coin_seg3_sub_dl_quad_blue_r[];
+extern const Gfx coin_seg3_sub_dl_quad_red[];
+extern const Gfx coin_seg3_sub_dl_quad_red_r[];
+extern const Gfx coin_seg3_sub_dl_quad_secret[];
+extern const Gfx coin_seg3_sub_dl_quad_secret_r[];
+
 #else
 extern const Gfx coin_seg3_sub_dl_begin[];
 extern const Gfx coin_seg3_sub_dl_end[];
+extern const Gfx coin_seg3_sub_dl_texture_front[];
+extern const Gfx coin_seg3_sub_dl_texture_tilt_right[];
+extern const Gfx coin_seg3_sub_dl_texture_side[];
+extern const Gfx coin_seg3_sub_dl_texture_tilt_left[];
+extern const Gfx coin_seg3_sub_dl_quad_yellow[];
+extern const Gfx coin_seg3_sub_dl_quad_blue[];
+extern const Gfx coin_seg3_sub_dl_quad_red[];
 extern const Gfx coin_seg3_dl_yellow_front[];
 extern const Gfx coin_seg3_dl_yellow_tilt_right[];
 extern const Gfx coin_seg3_dl_yellow_side[];
@@ -217,6 +239,9 @@ extern const GeoLayout mist_geo[];
 extern const GeoLayout white_puff_geo[];
 extern const Gfx mist_seg3_dl_03000880[];
 extern const Gfx mist_seg3_dl_03000920[];
+extern const Gfx mist_seg3_dl_particle_begin[];
+extern const Gfx mist_seg3_dl_particle_quad[];
+extern const Gfx mist_seg3_dl_particle_end[];
 
 // mushroom_1up
 extern const GeoLayout mushroom_1up_geo[];
@@ -245,6 +270,9 @@ extern const Gfx dl_breath_meter_health_segments_end[];
 
 // sand
 extern const Gfx sand_seg3_dl_particle[];
+extern const Gfx sand_seg3_dl_particle_begin[];
+extern const Gfx sand_seg3_dl_particle_quad[];
+extern const Gfx sand_seg3_dl_particle_end[];
 
 // star
 extern const GeoLayout star_geo[];
@@ -271,6 +299,13 @@ extern const Gfx tree_seg3_dl_snowy_pine[];
 extern const Gfx tree_seg3_dl_snowy_pine_transparent[];
 extern const Gfx tree_seg3_dl_palm[];
 extern const Gfx tree_seg3_dl_palm_transparent[];
+extern const Gfx tree_seg3_dl_end[];
+extern const Gfx tree_seg3_dl_spiky_begin[];
+extern const Gfx tree_seg3_dl_spiky_quad[];
+extern const Gfx tree_seg3_dl_snowy_pine_begin[];
+extern const Gfx tree_seg3_dl_snowy_pine_quad[];
+extern const Gfx tree_seg3_dl_palm_begin[];
+extern const Gfx tree_seg3_dl_palm_quad[];
 
 // warp_pipe
 extern const GeoLayout warp_pipe_geo[];
@@ -284,6 +319,9 @@ extern const Collision warp_pipe_seg3_collision_03009AC8[];
 // white_particle
 extern const GeoLayout white_particle_geo[];
 extern const Gfx white_particle_dl[];
+extern const Gfx white_particle_dl_begin[];
+extern const Gfx white_particle_dl_quad[];
+extern const Gfx white_particle_dl_end[];
 
 // wooden_signpost
 extern const GeoLayout wooden_signpost_geo[];
@@ -80,6 +80,16 @@ ALIGNED8 static const Texture tree_seg3_texture_pine[] = {
 #include "actors/tree/pine_tree.rgba16.inc.c"
 };
 
+// The single textured trees below are split into their texture, their quad and this, so several of the
+// same tree can be drawn with one texture load.
+const Gfx tree_seg3_dl_end[] = {
+    gsSPTexture(0xFFFF, 0xFFFF, 0, G_TX_RENDERTILE, G_OFF),
+    gsDPPipeSync(),
+    gsDPSetCombineMode(G_CC_SHADE, G_CC_SHADE),
+    gsSPSetGeometryMode(G_SHADING_SMOOTH),
+    gsSPEndDisplayList(),
+};
+
 // 0x03030F60
 static const Vtx tree_seg3_vertex_spiky[] = {
     {{{   128,    512,      0}, 0, {   990,      0}, {0x00, 0x00, 0x7f, 0xff}}},
@@ -89,7 +99,7 @@ static const Vtx tree_seg3_vertex_spiky[] = {
 };
 
 // 0x03030FA0 - 0x03031048
-const Gfx tree_seg3_sub_dl_spiky[] = {
+const Gfx tree_seg3_sub_dl_spiky_texture[] = {
     gsSPClearGeometryMode(G_SHADING_SMOOTH),
     gsDPSetTile(G_IM_FMT_RGBA, G_IM_SIZ_16b, 0, 0, G_TX_LOADTILE, 0, G_TX_WRAP | G_TX_NOMIRROR, G_TX_NOMASK, G_TX_NOLOD, G_TX_WRAP | G_TX_NOMIRROR, G_TX_NOMASK, G_TX_NOLOD),
     gsSPTexture(0xFFFF, 0xFFFF, 0, G_TX_RENDERTILE, G_ON),
@@ -101,19 +111,31 @@ const Gfx tree_seg3_sub_dl_spiky[] = {
     gsDPLoadBlock(G_TX_LOADTILE, 0, 0, 32 * 64 - 1, CALC_DXT(32, G_IM_SIZ_16b_BYTES)),
     gsSPLightColor(LIGHT_1, 0xffffffff),
     gsSPLightColor(LIGHT_2, 0x3f3f3fff),
+    gsSPEndDisplayList(),
+};
+
+const Gfx tree_seg3_dl_spiky_quad[] = {
     gsSPVertex(tree_seg3_vertex_spiky, 4, 0),
     gsSP2Triangles( 0,  1,  2, 0x0,  0,  2,  3, 0x0),
-    gsSPTexture(0xFFFF, 0xFFFF, 0, G_TX_RENDERTILE, G_OFF),
-    gsDPPipeSync(),
-    gsDPSetCombineMode(G_CC_SHADE, G_CC_SHADE),
-    gsSPSetGeometryMode(G_SHADING_SMOOTH),
     gsSPEndDisplayList(),
 };
 
-const Gfx tree_seg3_dl_spiky[] = {
+const Gfx tree_seg3_sub_dl_spiky[] = {
+    gsSPDisplayList(tree_seg3_sub_dl_spiky_texture),
+    gsSPDisplayList(tree_seg3_dl_spiky_quad),
+    gsSPBranchList(tree_seg3_dl_end),
+};
+
+const Gfx tree_seg3_dl_spiky_begin[] = {
     gsDPPipeSync(),
     gsDPSetCombineMode(G_CC_DECALRGBA, G_CC_DECALRGBA),
-    gsSPBranchList(tree_seg3_sub_dl_spiky),
+    gsSPBranchList(tree_seg3_sub_dl_spiky_texture),
+};
+
+const Gfx tree_seg3_dl_spiky[] = {
+    gsSPDisplayList(tree_seg3_dl_spiky_begin),
+    gsSPDisplayList(tree_seg3_dl_spiky_quad),
+    gsSPBranchList(tree_seg3_dl_end),
 };
 //! These shouldn't need to be separate. However, silhouette moment.
 const Gfx tree_seg3_dl_spiky_transparent[] = {
@@ -128,7 +150,7 @@ ALIGNED8 static const Texture tree_seg3_texture_snowy_pine[] = {
 };
 
 // 0x03032088 - 0x03032130
-const Gfx tree_seg3_sub_dl_snowy_pine[] = {
+const Gfx tree_seg3_sub_dl_snowy_pine_texture[] = {
     gsSPClearGeometryMode(G_SHADING_SMOOTH),
     gsDPSetTile(G_IM_FMT_RGBA, G_IM_SIZ_16b, 0, 0, G_TX_LOADTILE, 0, G_TX_WRAP | G_TX_NOMIRROR, G_TX_NOMASK, G_TX_NOLOD, G_TX_WRAP | G_TX_NOMIRROR, G_TX_NOMASK, G_TX_NOLOD),
     gsSPTexture(0xFFFF, 0xFFFF, 0, G_TX_RENDERTILE, G_ON),
@@ -140,19 +162,31 @@ const Gfx tree_seg3_sub_dl_snowy_pine[] = {
     gsDPLoadBlock(G_TX_LOADTILE, 0, 0, 32 * 64 - 1, CALC_DXT(32, G_IM_SIZ_16b_BYTES)),
     gsSPLightColor(LIGHT_1, 0xffffffff),
     gsSPLightColor(LIGHT_2, 0x3f3f3fff),
+    gsSPEndDisplayList(),
+};
+
+const Gfx tree_seg3_dl_snowy_pine_quad[] = {
     gsSPVertex(tree_seg3_vertex_spiky, 4, 0),
     gsSP2Triangles( 0,  1,  2, 0x0,  0,  2,  3, 0x0),
-    gsSPTexture(0xFFFF, 0xFFFF, 0, G_TX_RENDERTILE, G_OFF),
-    gsDPPipeSync(),
-    gsDPSetCombineMode(G_CC_SHADE, G_CC_SHADE),
-    gsSPSetGeometryMode(G_SHADING_SMOOTH),
     gsSPEndDisplayList(),
 };
 
-const Gfx tree_seg3_dl_snowy_pine[] = {
+const Gfx tree_seg3_sub_dl_snowy_pine[] = {
+    gsSPDisplayList(tree_seg3_sub_dl_snowy_pine_texture),
+    gsSPDisplayList(tree_seg3_dl_snowy_pine_quad),
+    gsSPBranchList(tree_seg3_dl_end),
+};
+
+const Gfx tree_seg3_dl_snowy_pine_begin[] = {
     gsDPPipeSync(),
     gsDPSetCombineMode(G_CC_DECALRGBA, G_CC_DECALRGBA),
-    gsSPBranchList(tree_seg3_sub_dl_snowy_pine),
+    gsSPBranchList(tree_seg3_sub_dl_snowy_pine_texture),
+};
+
+const Gfx tree_seg3_dl_snowy_pine[] = {
+    gsSPDisplayList(tree_seg3_dl_snowy_pine_begin),
+    gsSPDisplayList(tree_seg3_dl_snowy_pine_quad),
+    gsSPBranchList(tree_seg3_dl_end),
 };
 //! These shouldn't need to be separate. However, silhouette moment.
 const Gfx tree_seg3_dl_snowy_pine_transparent[] = {
@@ -175,7 +209,7 @@ static const Vtx tree_seg3_vertex_palm[] = {
 };
 
 // 0x03033258 - 0x03033300
-const Gfx tree_seg3_sub_dl_palm[] = {
+const Gfx tree_seg3_sub_dl_palm_texture[] = {
     gsSPClearGeometryMode(G_SHADING_SMOOTH),
     gsDPSetTile(G_IM_FMT_RGBA, G_IM_SIZ_16b, 0, 0, G_TX_LOADTILE, 0, G_TX_WRAP | G_TX_NOMIRROR, G_TX_NOMASK, G_TX_NOLOD, G_TX_WRAP | G_TX_NOMIRROR, G_TX_NOMASK, G_TX_NOLOD),
     gsSPTexture(0xFFFF, 0xFFFF, 0, G_TX_RENDERTILE, G_ON),
@@ -187,19 +221,31 @@ const Gfx tree_seg3_sub_dl_palm[] = {
     gsDPLoadBlock(G_TX_LOADTILE, 0, 0, 32 * 64 - 1, CALC_DXT(32, G_IM_SIZ_16b_BYTES)),
     gsSPLightColor(LIGHT_1, 0xffffffff),
     gsSPLightColor(LIGHT_2, 0x3f3f3fff),
+    gsSPEndDisplayList(),
+};
+
+const Gfx tree_seg3_dl_palm_quad[] = {
     gsSPVertex(tree_seg3_vertex_palm, 4, 0),
     gsSP2Triangles( 0,  1,  2, 0x0,  0,  2,  3, 0x0),
-    gsSPTexture(0xFFFF, 0xFFFF, 0, G_TX_RENDERTILE, G_OFF),
-    gsDPPipeSync(),
-    gsDPSetCombineMode(G_CC_SHADE, G_CC_SHADE),
-    gsSPSetGeometryMode(G_SHADING_SMOOTH),
     gsSPEndDisplayList(),
 };
 
-const Gfx tree_seg3_dl_palm[] = {
+const Gfx tree_seg3_sub_dl_palm[] = {
+    gsSPDisplayList(tree_seg3_sub_dl_palm_texture),
+    gsSPDisplayList(tree_seg3_dl_palm_quad),
+    gsSPBranchList(tree_seg3_dl_end),
+};
+
+const Gfx tree_seg3_dl_palm_begin[] = {
     gsDPPipeSync(),
     gsDPSetCombineMode(G_CC_DECALRGBA, G_CC_DECALRGBA),
-    gsSPBranchList(tree_seg3_sub_dl_palm),
+    gsSPBranchList(tree_seg3_sub_dl_palm_texture),
+};
+
+const Gfx tree_seg3_dl_palm[] = {
+    gsSPDisplayList(tree_seg3_dl_palm_begin),
+    gsSPDisplayList(tree_seg3_dl_palm_quad),
+    gsSPBranchList(tree_seg3_dl_end),
 };
 //! These shouldn't need to be separate. However, silhouette moment.
 const Gfx tree_seg3_dl_palm_transparent[] = {
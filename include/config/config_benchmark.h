@@ -15,3 +15,27 @@
     #define ENABLE_VANILLA_LEVEL_SPECIFIC_CHECKS
     #define TEST_LEVEL LEVEL_CASTLE_GROUNDS
 #endif
+
+/**
+ * Replays the recorded demos of the levels in DEMO_BENCHMARK_LEVELS one after another from boot, instead of starting the game.
+ * The frame time and the CPU, RSP and RDP time of every frame are recorded, and once the last demo ends each level's
+ * min/avg/p99/max is shown on screen. They're also printed as CSV over USB when building with UNF=1, or to the IS-Viewer
+ * with ISVPRINT=1 on emulators, so that the results of two builds can be compared with tools/demo_benchmark_compare.py.
+ * Every demo starts from save file 1 with the same random seed, so they play out the same on every build.
+ * Don't enable this along with ENABLE_CREDITS_BENCHMARK.
+ */
+// #define ENABLE_DEMO_BENCHMARK
+
+#ifdef ENABLE_DEMO_BENCHMARK
+    // The levels to benchmark, in order. Each one needs a demo in assets/demo_data.json.
+    #define DEMO_BENCHMARK_LEVELS LEVEL_BITDW, LEVEL_WF, LEVEL_CCM, LEVEL_BBH, LEVEL_JRB, LEVEL_HMC, LEVEL_PSS
+
+    // How many times each level's demo is played. The results of every run of a level are combined.
+    #define DEMO_BENCHMARK_RUNS 1
+
+    // A level fails the benchmark if the 99th percentile of one of its times is above these, in microseconds (0 to not check).
+    #define DEMO_BENCHMARK_MAX_FRAME_P99 34000
+    #define DEMO_BENCHMARK_MAX_CPU_P99   33333
+    #define DEMO_BENCHMARK_MAX_RSP_P99   33333
+    #define DEMO_BENCHMARK_MAX_RDP_P99   33333
+#endif
@@ -21,6 +21,31 @@
  */
 #define ALL_SURFACES_HAVE_FORCE
 
+/**
+ * Splits static cells with many floors or ceilings into a finer grid of sub-cells, which find_floor and find_ceil use instead of the whole cell.
+ * Walls, water and raycasts still use the regular cells. Costs some extra memory in the static surface pool, shown on the puppyprint collision page.
+ * The defined number is how many sub-cells each side of a cell is split into, and must be a power of two. Comment out to disable.
+ */
+#define STATIC_SURFACE_SUBCELLS 4
+
+/**
+ * Objects that look up the floor at their own position have it looked up again in a batch, sorted by cell, once all objects have updated.
+ * The next frame's find_floor at the same position then only checks dynamic floors. Results are the same as without it.
+ */
+#define BATCHED_FLOOR_PROBES
+
+/**
+ * Platforms that haven't moved, rotated or scaled since the last frame keep their dynamic surfaces instead of transforming and rebuilding them.
+ * Their surfaces are still added to the cells again, so results are the same as without it. Uses a few extra bytes of the dynamic surface pool per platform.
+ */
+#define REUSE_UNMOVED_DYNAMIC_SURFACES
+
+/**
+ * Puts the hitboxes of tangible objects into a spatial hash each frame, so that object collision only checks the pairs of objects that share a cell.
+ * Pairs are still checked in the same order as the object lists, so results are the same as without it.
+ */
+#define OBJECT_COLLISION_BROADPHASE
+
 /**
  * Number of walls that can push Mario at once. Vanilla is 4.
  */
@@ -24,6 +24,28 @@
  */
 //#define USE_PROFILER
 
+/**
+ * Streams the profiler's timings and counts for every frame over USB, so frame time spikes can be found offline.
+ * Hold R + Z and press C-Down to start or stop a capture, then decode the files UNFLoader saves with tools/profiler_capture.py.
+ * Requires building with UNF=1, and enables USE_PROFILER.
+ */
+// #define PROFILER_CAPTURE
+
+/**
+ * Times nestable named scopes around the game loop's subsystems (objects, Mario's action groups, camera modes, rendering...),
+ * and shows them as a tree with their inclusive and self time in the "Scopes" page of PUPPYPRINT_DEBUG.
+ * Add more with PROFILER_SCOPE_BEGIN("Name") and PROFILER_SCOPE_END(). Requires PUPPYPRINT_DEBUG.
+ */
+// #define PROFILER_SCOPES
+
+/**
+ * Times every object's update, added up per behavior and per object list. The "Behaviors" page of PUPPYPRINT_DEBUG shows
+ * the behaviors that cost the most in total or per object, or the object lists, switched with D-Pad Left and Right.
+ * Press A on the page to print every behavior's costs over USB. Behaviors are shown by their address, which can be found in the map file.
+ * Requires PUPPYPRINT_DEBUG.
+ */
+// #define PROFILER_BEHAVIORS
+
 /**
  * -- TEST LEVEL --
  * Uncomment this define and set a test level in order to boot straight into said level.
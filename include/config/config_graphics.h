@@ -6,9 +6,18 @@
 
 /**
  * The size of the master display list (gDisplayListHead). 6400 is vanilla.
+ * With DYNAMIC_GFX_POOL, this is the size it starts at and never shrinks below.
  */
 #define GFX_POOL_SIZE 10000
 
+/**
+ * Allocate the gfx pools from the main pool instead of at a fixed size. They grow when a frame uses most of them,
+ * and shrink back towards GFX_POOL_SIZE once frames have only used a small part of them for a while.
+ * The game waits for the frame being drawn to finish whenever they're resized.
+ * The gfx pools' size and usage are shown at the bottom of puppyprint's Segments page either way.
+ */
+// #define DYNAMIC_GFX_POOL
+
 /**
  * Causes the global light direction to be in world space,
  * this allows you to have a singular light source that doesn't change with the camera's rotation.
@@ -140,6 +149,37 @@
  */
 #define DEFAULT_CULLING_RADIUS 300
 
+/**
+ * Sorts the opaque and alpha layers of the master list by display list, so copies of the same model are drawn one after
+ * another, and skips loading a matrix again for display lists that use the one already loaded.
+ * The other layers are still drawn in the order they were added, as they blend or decal onto what's already there.
+ * Objects that add a display list generated in the gfx pool to a sorted layer keep all of theirs on that layer in place, as it can
+ * set render state for the rest of their model (e.g. Bowser's coloring, Mario's transparency), and nothing is moved past them.
+ * NOTE: Display lists from models drawn on the sorted layers must not load a modelview matrix of their own without popping it,
+ * and must leave the render state as they found it, since they can end up drawn before or after any other model's.
+ */
+// #define MASTER_LIST_BATCHING
+
+/**
+ * Coins and single textured trees that are drawn several times on a sorted layer of the master list load their
+ * texture once, then only draw each one's quad. The models that can be drawn this way are listed in rendering_graph_node.c.
+ * Enables MASTER_LIST_BATCHING, and only batches copies that end up next to each other after its sort, so the same render
+ * state applies to all of a run.
+ */
+// #define INSTANCED_MODELS
+
+/**
+ * The level geometry's translation, rotation and scale nodes keep their matrices between frames, and only work them out again
+ * when their parent's matrix changes or geo_invalidate_matrix_cache is called on them. Code that changes the transformation of
+ * such a node at runtime has to call it. Nodes in object models aren't affected.
+ */
+#define GRAPH_NODE_MATRIX_CACHE
+
+/**
+ * How many nodes can keep their matrix with GRAPH_NODE_MATRIX_CACHE. Each one takes 200 bytes. Nodes past this work out their matrix every frame.
+ */
+#define GRAPH_NODE_MATRIX_CACHE_CAPACITY 64
+
 /**
  * Eases the textured screen transitions to make them look smoother. 
  * Extends the full radius for mario, bowser and the star transitions.
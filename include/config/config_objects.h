@@ -1,5 +1,79 @@
 #pragma once
 
+/***************************
+ * GENERAL OBJECT SETTINGS *
+ ***************************/
+
+/**
+ * Behavior loops are compiled into lists of handlers with their arguments already decoded the first time an object reaches their END_LOOP.
+ * Objects then run them directly each frame instead of interpreting every command. Loops with commands that change the flow of the script are left alone.
+ */
+#define COMPILED_BEHAVIOR_LOOPS
+
+/**
+ * Objects far from Mario only update every 2nd or 4th frame. When they do, their behavior runs once for each frame they skipped,
+ * so timers and movement still catch up exactly, while the distance and room checks and transform updates only run once.
+ * Objects that weren't on screen last frame count as twice as far away. The distances are set for each object list below.
+ * Objects don't react to Mario or other objects on the frames they skip, so only throttle lists whose objects can tolerate it.
+ */
+// #define OBJECT_LOD_TICKING
+
+/**
+ * The distances from Mario past which the objects of each list update every 2nd and every 4th frame, or 0 to always update them.
+ * All 0 updates every object every frame. For example, { 2000.0f, 4000.0f } for Unimportant throttles far away particles.
+ * In the same order as the object lists in object_list_processor.h.
+ */
+#define OBJECT_LOD_TICK_DISTANCES {         \
+    /* Player      */ {    0.0f,     0.0f }, \
+    /* Unused 1    */ {    0.0f,     0.0f }, \
+    /* Destructive */ {    0.0f,     0.0f }, \
+    /* Unused 3    */ {    0.0f,     0.0f }, \
+    /* GenActor    */ {    0.0f,     0.0f }, \
+    /* Pushable    */ {    0.0f,     0.0f }, \
+    /* Level       */ {    0.0f,     0.0f }, \
+    /* Unused 7    */ {    0.0f,     0.0f }, \
+    /* Default     */ {    0.0f,     0.0f }, \
+    /* Surface     */ {    0.0f,     0.0f }, \
+    /* Polelike    */ {    0.0f,     0.0f }, \
+    /* Spawner     */ {    0.0f,     0.0f }, \
+    /* Unimportant */ {    0.0f,     0.0f }, \
+}
+
+/**
+ * How many of the object pool's slots are kept for each object list. Objects can't take the free slots still reserved for
+ * other lists while there are unimportant objects to unload instead, so a burst of particles can't leave enemies without room.
+ * All 0 is vanilla behavior. For example, reserving 24 GenActor, 16 Level, 16 Default and 16 Surface slots keeps room for
+ * enemies and platforms. Watch the object pool stats when tuning these, as anything reserved is unavailable to the other lists.
+ * In the same order as the object lists in object_list_processor.h.
+ */
+#define OBJECT_LIST_RESERVED_SLOTS { \
+    /* Player      */ 0, \
+    /* Unused 1    */ 0, \
+    /* Destructive */ 0, \
+    /* Unused 3    */ 0, \
+    /* GenActor    */ 0, \
+    /* Pushable    */ 0, \
+    /* Level       */ 0, \
+    /* Unused 7    */ 0, \
+    /* Default     */ 0, \
+    /* Surface     */ 0, \
+    /* Polelike    */ 0, \
+    /* Spawner     */ 0, \
+    /* Unimportant */ 0, \
+}
+
+/**
+ * Mist, sand and snow particles from cur_obj_spawn_particles go into a pool of their own instead of each being an object,
+ * and are drawn with one display list per material. They move and fade the same as with bhvWhitePuffExplosion.
+ * Other particle models still spawn objects. See particle_system.c.
+ */
+#define PARTICLE_SYSTEM
+
+/**
+ * How many particles there can be at once with PARTICLE_SYSTEM. Particles past this aren't spawned.
+ */
+#define PARTICLE_POOL_CAPACITY 128
+
 /****************************
  * SPECIFIC OBJECT SETTINGS *
  ****************************/
@@ -56,6 +56,9 @@
 #ifdef DISABLE_ALL
     #undef DEBUG_ALL
     #undef USE_PROFILER
+    #undef PROFILER_CAPTURE
+    #undef PROFILER_SCOPES
+    #undef PROFILER_BEHAVIORS
     #undef TEST_LEVEL
     #undef DEBUG_LEVEL_SELECT
     #undef ENABLE_DEBUG_FREE_MOVE
@@ -111,6 +114,20 @@
     #define USE_PROFILER
 #endif // PUPPYPRINT_DEBUG
 
+#ifdef PROFILER_CAPTURE
+    #ifdef UNF
+        #undef USE_PROFILER
+        #define USE_PROFILER
+    #else
+        #undef PROFILER_CAPTURE
+    #endif
+#endif // PROFILER_CAPTURE
+
+#ifndef PUPPYPRINT_DEBUG
+    #undef PROFILER_SCOPES
+    #undef PROFILER_BEHAVIORS
+#endif // !PUPPYPRINT_DEBUG
+
 #ifdef COMPLETE_SAVE_FILE
     #undef UNLOCK_ALL
     #define UNLOCK_ALL
@@ -165,6 +182,30 @@
 #endif // !KEEP_MARIO_HEAD
 
 
+/*****************
+ * config_benchmark.h
+ */
+
+// After config_goddard.h, as the demo benchmark needs the demos even without the Mario head.
+#ifdef ENABLE_DEMO_BENCHMARK
+    #undef DISABLE_DEMO
+    #undef TEST_LEVEL
+    #undef USE_PROFILER
+    #define USE_PROFILER
+#endif // ENABLE_DEMO_BENCHMARK
+
+
+/*****************
+ * config_graphics.h
+ */
+
+// Instanced models are drawn from runs of the same display list, which only the sorted master list has.
+#ifdef INSTANCED_MODELS
+    #undef MASTER_LIST_BATCHING
+    #define MASTER_LIST_BATCHING
+#endif // INSTANCED_MODELS
+
+
 /*****************
  * config_menu.h
  */
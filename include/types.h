@@ -200,7 +200,7 @@ enum AnimFlags {
     ANIM_FLAG_VERT_TRANS = BIT(4), // 0x10
     ANIM_FLAG_DISABLED   = BIT(5), // 0x20
     ANIM_FLAG_NO_TRANS   = BIT(6), // 0x40
-    ANIM_FLAG_UNUSED     = BIT(7), // 0x80
+    ANIM_FLAG_COMPRESSED = BIT(7), // 0x80, the channels are compressed tracks, see get_animation_frame_tables
 };
 
 struct Animation {
@@ -317,6 +317,12 @@ struct Object {
     /*0x218*/ void *collisionData;
     /*0x21C*/ Mat4 transform;
     /*0x25C*/ void *respawnInfo;
+    /*0x260*/ struct Object *bhvBucketNext; // Objects whose behaviors share a bucket, see spawn_object.c
+    /*0x264*/ struct Object *bhvBucketPrev;
+    /*0x268*/ u32 allocOrder;
+    /*0x26C*/ u8 objListIndex;
+    /*0x26D*/ u8 lodSkippedFrames; // Frames not updated since the last update, with OBJECT_LOD_TICKING
+    /*0x270*/ u32 lastInViewFrame; // gGlobalTimer when the object was last on screen
 };
 
 struct ObjectHitbox {
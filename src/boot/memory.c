@@ -212,6 +212,42 @@ void *main_pool_realloc(void *addr, u32 size) {
     return newAddr;
 }
 
+/**
+ * Resize the first block that was allocated from the right side of the pool,
+ * which must also be the most recently allocated block from the right side.
+ * Its end stays where it is, so the block moves by however much it changes size.
+ * The pushed pool states are updated to match, so popping them keeps the block.
+ * Return the new address, or NULL if there isn't enough space.
+ */
+void *main_pool_resize_first_right(void *addr, u32 size) {
+    struct MainPoolBlock *block = (struct MainPoolBlock *) ((u8 *) addr - 16);
+    struct MainPoolBlock *poolEnd = (struct MainPoolBlock *) sPoolEnd;
+    struct MainPoolBlock *newBlock;
+    struct MainPoolState *state;
+    u32 oldSize = (uintptr_t) poolEnd - (uintptr_t) block;
+
+    size = ALIGN16(size) + 16;
+    if (block != sPoolListHeadR || block->next != poolEnd
+        || (size > oldSize && size - oldSize > sPoolFreeSpace)) {
+        return NULL;
+    }
+
+    newBlock = (struct MainPoolBlock *) ((u8 *) poolEnd - size);
+    newBlock->prev = NULL;
+    newBlock->next = poolEnd;
+    poolEnd->prev = newBlock;
+    sPoolListHeadR = newBlock;
+    sPoolFreeSpace = sPoolFreeSpace + oldSize - size;
+
+    for (state = gMainPoolState; state != NULL; state = state->prev) {
+        if (state->listHeadR == block) {
+            state->listHeadR = newBlock;
+            state->freeSpace = state->freeSpace + oldSize - size;
+        }
+    }
+    return (u8 *) newBlock + 16;
+}
+
 /**
  * Return the size of the largest block that can currently be allocated from the
  * pool.
@@ -593,6 +629,8 @@ void *alloc_display_list(u32 size) {
     if (gGfxPoolEnd - size >= (u8 *) gDisplayListHead) {
         gGfxPoolEnd -= size;
         ptr = gGfxPoolEnd;
+    } else {
+        gGfxPoolStats.numFailedAllocs++;
     }
     return ptr;
 }
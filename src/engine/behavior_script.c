@@ -298,12 +298,19 @@ static s32 bhv_cmd_begin_loop(void) {
     return BHV_PROC_CONTINUE;
 }
 
+#ifdef COMPILED_BEHAVIOR_LOOPS
+static void bhv_compile_loop(const BehaviorScript *start);
+#endif
+
 // Command 0x09: Marks the end of an infinite loop.
 // Usage: END_LOOP()
 static s32 bhv_cmd_end_loop(void) {
     gCurBhvCommand = (const BehaviorScript *) cur_obj_bhv_stack_pop(); // Jump back to the first command in the loop
     cur_obj_bhv_stack_push(BHV_CMD_GET_ADDR_OF_CMD(0)); // Save address to the stack again
 
+#ifdef COMPILED_BEHAVIOR_LOOPS
+    bhv_compile_loop(gCurBhvCommand);
+#endif
     return BHV_PROC_BREAK;
 }
 
@@ -812,12 +819,227 @@ static BhvCommandProc BehaviorCmdTable[] = {
     /*BHV_CMD_SPAWN_WATER_DROPLET   */ bhv_cmd_spawn_water_droplet,
 };
 
+#ifdef COMPILED_BEHAVIOR_LOOPS
+/**
+ * Compiled behavior loops. The first time an object reaches the END_LOOP of a loop, the commands from
+ * the start of the loop are compiled into a list of handlers with their arguments already decoded.
+ * Objects at the start of a compiled loop then run the list instead of interpreting the commands.
+ * Only loops made of commands that always continue to the next one are compiled, which in practice
+ * is nearly every loop, as most of them are just CALL_NATIVEs.
+ *
+ * The compiled loops are cleared along with the objects, as the behavior data can be loaded again.
+ */
+#define BHV_COMPILED_LOOP_COUNT 256 // Must be a power of two
+#define BHV_COMPILED_OP_COUNT   1024
+
+struct BhvCompiledOp {
+    void (*proc)(const struct BhvCompiledOp *op); // NULL for the END_LOOP
+    union {
+        s32 asS32;
+        f32 asF32;
+        void *asPtr;
+    } value;
+    u8 field;
+    u8 fieldSrc1;
+    u8 fieldSrc2;
+};
+
+struct BhvCompiledLoop {
+    const BehaviorScript *start;
+    struct BhvCompiledOp *ops; // NULL if the loop can't be compiled
+};
+
+static struct BhvCompiledLoop sBhvCompiledLoops[BHV_COMPILED_LOOP_COUNT];
+static struct BhvCompiledOp sBhvCompiledOps[BHV_COMPILED_OP_COUNT];
+static u32 sNumBhvCompiledOps = 0;
+
+static void bhv_op_call_native(const struct BhvCompiledOp *op) {
+    ((NativeBhvFunc) op->value.asPtr)();
+}
+
+static void bhv_op_set_int(const struct BhvCompiledOp *op) {
+    cur_obj_set_int(op->field, op->value.asS32);
+}
+
+static void bhv_op_add_int(const struct BhvCompiledOp *op) {
+    cur_obj_add_int(op->field, op->value.asS32);
+}
+
+static void bhv_op_set_float(const struct BhvCompiledOp *op) {
+    cur_obj_set_float(op->field, op->value.asF32);
+}
+
+static void bhv_op_add_float(const struct BhvCompiledOp *op) {
+    cur_obj_add_float(op->field, op->value.asF32);
+}
+
+static void bhv_op_or_int(const struct BhvCompiledOp *op) {
+    cur_obj_or_int(op->field, op->value.asS32);
+}
+
+static void bhv_op_and_int(const struct BhvCompiledOp *op) {
+    cur_obj_and_int(op->field, op->value.asS32);
+}
+
+static void bhv_op_sum_float(const struct BhvCompiledOp *op) {
+    cur_obj_set_float(op->field, cur_obj_get_float(op->fieldSrc1) + cur_obj_get_float(op->fieldSrc2));
+}
+
+static void bhv_op_sum_int(const struct BhvCompiledOp *op) {
+    cur_obj_set_int(op->field, cur_obj_get_int(op->fieldSrc1) + cur_obj_get_int(op->fieldSrc2));
+}
+
+static void bhv_op_animate_texture(const struct BhvCompiledOp *op) {
+    if ((gGlobalTimer % op->value.asS32) == 0) {
+        cur_obj_add_int(op->field, 1);
+    }
+}
+
+/**
+ * Returns the slot of the loop starting at start, or the empty slot it would go in if it isn't
+ * compiled yet. Returns NULL if it isn't compiled and there's no room left.
+ */
+static struct BhvCompiledLoop *bhv_find_compiled_loop(const BehaviorScript *start) {
+    u32 index = ((uintptr_t) start >> 2);
+
+    for (u32 i = 0; i < BHV_COMPILED_LOOP_COUNT; i++) {
+        struct BhvCompiledLoop *loop = &sBhvCompiledLoops[(index + i) & (BHV_COMPILED_LOOP_COUNT - 1)];
+        if (loop->start == start || loop->start == NULL) {
+            return loop;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Decodes the command at gCurBhvCommand into op and moves past it. Returns FALSE if it isn't one
+ * that can be compiled.
+ */
+static s32 bhv_compile_op(struct BhvCompiledOp *op) {
+    BhvCommandProc bhvCmdProc = BehaviorCmdTable[*gCurBhvCommand >> 24];
+
+    op->field = BHV_CMD_GET_2ND_U8(0);
+
+    if (bhvCmdProc == bhv_cmd_call_native) {
+        op->proc = bhv_op_call_native;
+        op->value.asPtr = BHV_CMD_GET_VPTR_SMALL(0);
+    } else if (bhvCmdProc == bhv_cmd_set_int) {
+        op->proc = bhv_op_set_int;
+        op->value.asS32 = BHV_CMD_GET_2ND_S16(0);
+    } else if (bhvCmdProc == bhv_cmd_add_int) {
+        op->proc = bhv_op_add_int;
+        op->value.asS32 = BHV_CMD_GET_2ND_S16(0);
+    } else if (bhvCmdProc == bhv_cmd_set_float) {
+        op->proc = bhv_op_set_float;
+        op->value.asF32 = BHV_CMD_GET_2ND_S16(0);
+    } else if (bhvCmdProc == bhv_cmd_add_float) {
+        op->proc = bhv_op_add_float;
+        op->value.asF32 = BHV_CMD_GET_2ND_S16(0);
+    } else if (bhvCmdProc == bhv_cmd_or_int) {
+        op->proc = bhv_op_or_int;
+        op->value.asS32 = BHV_CMD_GET_2ND_S16(0) & 0xFFFF;
+    } else if (bhvCmdProc == bhv_cmd_bit_clear) {
+        op->proc = bhv_op_and_int;
+        op->value.asS32 = (BHV_CMD_GET_2ND_S16(0) & 0xFFFF) ^ 0xFFFF;
+    } else if (bhvCmdProc == bhv_cmd_sum_float || bhvCmdProc == bhv_cmd_sum_int) {
+        op->proc = (bhvCmdProc == bhv_cmd_sum_float) ? bhv_op_sum_float : bhv_op_sum_int;
+        op->fieldSrc1 = BHV_CMD_GET_3RD_U8(0);
+        op->fieldSrc2 = BHV_CMD_GET_4TH_U8(0);
+    } else if (bhvCmdProc == bhv_cmd_animate_texture) {
+        op->proc = bhv_op_animate_texture;
+        op->value.asS32 = BHV_CMD_GET_2ND_S16(0);
+    } else if (bhvCmdProc == bhv_cmd_or_long) {
+        op->proc = bhv_op_or_int;
+        op->value.asS32 = BHV_CMD_GET_U32(1);
+        gCurBhvCommand++;
+    } else {
+        return FALSE;
+    }
+
+    gCurBhvCommand++;
+    return TRUE;
+}
+
+/**
+ * Compiles the loop starting at start, if it isn't already. Called from END_LOOP, which is partway
+ * through interpreting the current object's script, so gCurBhvCommand is restored afterwards.
+ */
+static void bhv_compile_loop(const BehaviorScript *start) {
+    struct BhvCompiledLoop *loop = bhv_find_compiled_loop(start);
+    const BehaviorScript *savedBhvCommand = gCurBhvCommand;
+    struct BhvCompiledOp *ops = &sBhvCompiledOps[sNumBhvCompiledOps];
+    u32 numOps = 0;
+
+    if (loop == NULL || loop->start == start) {
+        return;
+    }
+
+    gCurBhvCommand = start;
+    while (TRUE) {
+        if (sNumBhvCompiledOps + numOps >= BHV_COMPILED_OP_COUNT) {
+            ops = NULL;
+            break;
+        }
+        if (BehaviorCmdTable[*gCurBhvCommand >> 24] == bhv_cmd_end_loop) {
+            ops[numOps++].proc = NULL;
+            break;
+        }
+        if (!bhv_compile_op(&ops[numOps++])) {
+            ops = NULL;
+            break;
+        }
+    }
+    gCurBhvCommand = savedBhvCommand;
+
+    loop->start = start;
+    loop->ops = ops;
+    if (ops != NULL) {
+        sNumBhvCompiledOps += numOps;
+    }
+}
+
+/**
+ * Runs the current object's compiled loop if it's at the start of one, the same as interpreting it
+ * up to and including the END_LOOP. Returns FALSE if it isn't.
+ */
+static s32 cur_obj_run_compiled_loop(void) {
+    struct BhvCompiledLoop *loop = bhv_find_compiled_loop(gCurBhvCommand);
+    const struct BhvCompiledOp *op;
+
+    if (loop == NULL || loop->start != gCurBhvCommand || loop->ops == NULL) {
+        return FALSE;
+    }
+
+    for (op = loop->ops; op->proc != NULL; op++) {
+        op->proc(op);
+    }
+
+    gCurBhvCommand = (const BehaviorScript *) cur_obj_bhv_stack_pop();
+    cur_obj_bhv_stack_push((uintptr_t) gCurBhvCommand);
+    return TRUE;
+}
+
+void bhv_clear_compiled_loops(void) {
+    bzero(sBhvCompiledLoops, sizeof(sBhvCompiledLoops));
+    sNumBhvCompiledOps = 0;
+}
+#endif
+
 // Execute the behavior script of the current object, process the object flags, and other miscellaneous code for updating objects.
 void cur_obj_update(void) {
     u32 objFlags = o->oFlags;
     f32 distanceFromMario;
     BhvCommandProc bhvCmdProc;
     s32 bhvProcResult;
+#ifdef OBJECT_LOD_TICKING
+    // Objects that skipped frames catch up on them here.
+    s32 ticks = 1 + o->lodSkippedFrames;
+    o->lodSkippedFrames = 0;
+#else
+    const s32 ticks = 1;
+#endif
+    s32 tick;
 
     s32 inRoom = cur_obj_is_mario_in_room();
 
@@ -846,45 +1068,60 @@ void cur_obj_update(void) {
         o->oPrevAction = o->oAction;
     }
 
-    // Execute the behavior script.
-    gCurBhvCommand = o->curBhvCommand;
+    // Run the behavior once for every frame the object has to catch up on, so its timer still hits every value.
+    for (tick = 0; tick < ticks; tick++) {
+        // Execute the behavior script.
+        gCurBhvCommand = o->curBhvCommand;
 
-    do {
-        bhvCmdProc = BehaviorCmdTable[*gCurBhvCommand >> 24];
-        bhvProcResult = bhvCmdProc();
-    } while (bhvProcResult == BHV_PROC_CONTINUE);
+#ifdef COMPILED_BEHAVIOR_LOOPS
+        if (!cur_obj_run_compiled_loop())
+#endif
+        {
+            do {
+                bhvCmdProc = BehaviorCmdTable[*gCurBhvCommand >> 24];
+                bhvProcResult = bhvCmdProc();
+            } while (bhvProcResult == BHV_PROC_CONTINUE);
+        }
 
-    o->curBhvCommand = gCurBhvCommand;
+        o->curBhvCommand = gCurBhvCommand;
 
-    // Increment the object's timer.
-    if (o->oTimer < 0x3FFFFFFF) {
-        o->oTimer++;
-    }
+        // Increment the object's timer.
+        if (o->oTimer < 0x3FFFFFFF) {
+            o->oTimer++;
+        }
 
-    // If the object's action has changed, reset the action timer.
-    if (o->oAction != o->oPrevAction) {
-        o->oTimer = 0;
-        o->oSubAction = 0;
-        o->oPrevAction = o->oAction;
-    }
+        // If the object's action has changed, reset the action timer.
+        if (o->oAction != o->oPrevAction) {
+            o->oTimer = 0;
+            o->oSubAction = 0;
+            o->oPrevAction = o->oAction;
+        }
 
-    // Execute various code based on object flags.
-    objFlags = o->oFlags;
+        // Execute various code based on object flags.
+        objFlags = o->oFlags;
 
-    if (objFlags & OBJ_FLAG_SET_FACE_ANGLE_TO_MOVE_ANGLE) {
-        vec3i_copy(&o->oFaceAngleVec, &o->oMoveAngleVec);
-    }
+        if (objFlags & OBJ_FLAG_SET_FACE_ANGLE_TO_MOVE_ANGLE) {
+            vec3i_copy(&o->oFaceAngleVec, &o->oMoveAngleVec);
+        }
 
-    if (objFlags & OBJ_FLAG_SET_FACE_YAW_TO_MOVE_YAW) {
-        o->oFaceAngleYaw = o->oMoveAngleYaw;
-    }
+        if (objFlags & OBJ_FLAG_SET_FACE_YAW_TO_MOVE_YAW) {
+            o->oFaceAngleYaw = o->oMoveAngleYaw;
+        }
 
-    if (objFlags & OBJ_FLAG_MOVE_XZ_USING_FVEL) {
-        cur_obj_move_xz_using_fvel_and_yaw();
-    }
+        if (objFlags & OBJ_FLAG_MOVE_XZ_USING_FVEL) {
+            cur_obj_move_xz_using_fvel_and_yaw();
+        }
+
+        if (objFlags & OBJ_FLAG_MOVE_Y_WITH_TERMINAL_VEL) {
+            cur_obj_move_y_with_terminal_vel();
+        }
 
-    if (objFlags & OBJ_FLAG_MOVE_Y_WITH_TERMINAL_VEL) {
-        cur_obj_move_y_with_terminal_vel();
+#ifdef OBJECT_LOD_TICKING
+        // The behavior unloaded the object, so there's nothing left to catch up on.
+        if (!(o->activeFlags & ACTIVE_FLAG_ACTIVE)) {
+            break;
+        }
+#endif
     }
 
     if (objFlags & OBJ_FLAG_TRANSFORM_RELATIVE_TO_PARENT) {
@@ -3,6 +3,8 @@
 
 #include <PR/ultratypes.h>
 
+#include "config.h"
+
 enum BhvProc {
     BHV_PROC_CONTINUE,
     BHV_PROC_BREAK
@@ -22,5 +24,8 @@ enum BhvProc {
 #define obj_and_int(object, offset, value) object->OBJECT_FIELD_S32(offset) &= (s32)(value)
 
 void cur_obj_update(void);
+#ifdef COMPILED_BEHAVIOR_LOOPS
+void bhv_clear_compiled_loops(void);
+#endif
 
 #endif // BEHAVIOR_SCRIPT_H
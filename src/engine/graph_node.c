@@ -1,13 +1,16 @@
 #include <ultra64.h>
 #include "sm64.h"
 
+#include "game/game_init.h"
 #include "game/level_update.h"
 #include "math_util.h"
 #include "game/memory.h"
 #include "graph_node.h"
 #include "game/rendering_graph_node.h"
 #include "game/area.h"
+#include "game/debug.h"
 #include "geo_layout.h"
+#include "game/profiling.h"
 
 /**
  * Initialize a geo node with a given type. Sets all links such that there
@@ -218,6 +221,7 @@ init_graph_node_translation_rotation(struct AllocOnlyPool *pool,
         vec3s_copy(graphNode->rotation, rotation);
         SET_GRAPH_NODE_LAYER(graphNode->node.flags, drawingLayer);
         graphNode->displayList = displayList;
+        graphNode->matrixCache = NULL;
     }
 
     return graphNode;
@@ -240,6 +244,7 @@ struct GraphNodeTranslation *init_graph_node_translation(struct AllocOnlyPool *p
         vec3s_copy(graphNode->translation, translation);
         SET_GRAPH_NODE_LAYER(graphNode->node.flags, drawingLayer);
         graphNode->displayList = displayList;
+        graphNode->matrixCache = NULL;
     }
 
     return graphNode;
@@ -261,6 +266,7 @@ struct GraphNodeRotation *init_graph_node_rotation(struct AllocOnlyPool *pool,
         vec3s_copy(graphNode->rotation, rotation);
         SET_GRAPH_NODE_LAYER(graphNode->node.flags, drawingLayer);
         graphNode->displayList = displayList;
+        graphNode->matrixCache = NULL;
     }
 
     return graphNode;
@@ -281,6 +287,7 @@ struct GraphNodeScale *init_graph_node_scale(struct AllocOnlyPool *pool,
         SET_GRAPH_NODE_LAYER(graphNode->node.flags, drawingLayer);
         graphNode->scale = scale;
         graphNode->displayList = displayList;
+        graphNode->matrixCache = NULL;
     }
 
     return graphNode;
@@ -784,6 +791,182 @@ s32 retrieve_animation_index(s32 frame, u16 **attributes) {
     return result;
 }
 
+/**
+ * Animations with ANIM_FLAG_COMPRESSED keep each channel in a track of its own, written by
+ * tools/mario_anims_converter.py. Their index is the number of channels followed by each channel's byte
+ * offset into their values. A track starts with its type, how many low bits were dropped from its values
+ * and its frame count, all read a byte at a time as big endian.
+ */
+enum AnimTrackTypes {
+    ANIM_TRACK_CONSTANT, // One value for every frame
+    ANIM_TRACK_RAW,      // A value for each frame
+    ANIM_TRACK_DELTA,    // The bits per delta, a value every ANIM_TRACK_KEYFRAME_INTERVAL frames, then the packed deltas to the frames in between
+};
+
+#define ANIM_TRACK_KEYFRAME_INTERVAL 16
+
+// The most channels a compressed animation can have: the root translation and each part's rotation
+#define ANIM_MAX_CHANNELS ((1 + 64) * 3)
+// How many decoded frames, and how many of their values, are kept until the next frame
+#define ANIM_DECODE_CACHE_FRAMES 32
+#define ANIM_DECODE_CACHE_VALUES 4096
+
+#define READ_ANIM_S16(p) ((s16)(((p)[0] << 8) | (p)[1]))
+
+struct DecodedAnimFrame {
+    struct Animation *anim;
+    s16 frame;
+    s16 *values;
+};
+
+static struct DecodedAnimFrame sDecodedAnimFrames[ANIM_DECODE_CACHE_FRAMES];
+static s16 sDecodedAnimValues[ANIM_DECODE_CACHE_VALUES];
+static u32 sNumDecodedAnimFrames = 0;
+static u32 sNumDecodedAnimValues = 0;
+static u32 sDecodedAnimTimer = 0;
+// Reads the decoded values in order with retrieve_animation_index at frame 0
+static u16 sDecodedAnimAttributes[ANIM_MAX_CHANNELS * 2];
+
+/**
+ * Decode a compressed track's value at the given frame, holding the last frame past its end.
+ */
+static s16 decode_animation_track(const u8 *track, s32 frame) {
+    s32 numFrames = (track[2] << 8) | track[3];
+    s32 value;
+
+    if (frame >= numFrames) {
+        frame = numFrames - 1;
+    }
+    if (frame < 0) {
+        frame = 0;
+    }
+
+    switch (track[0]) {
+        case ANIM_TRACK_CONSTANT:
+            value = READ_ANIM_S16(&track[4]);
+            break;
+        case ANIM_TRACK_RAW:
+            value = READ_ANIM_S16(&track[4 + frame * 2]);
+            break;
+        default: {
+            s32 bits = track[4];
+            s32 key = frame / ANIM_TRACK_KEYFRAME_INTERVAL;
+            s32 numKeys = (numFrames + ANIM_TRACK_KEYFRAME_INTERVAL - 1) / ANIM_TRACK_KEYFRAME_INTERVAL;
+            const u8 *deltas = &track[5 + numKeys * 2];
+            u32 bitPos = key * (ANIM_TRACK_KEYFRAME_INTERVAL - 1) * bits;
+            s32 i;
+
+            value = READ_ANIM_S16(&track[5 + key * 2]);
+            for (i = frame % ANIM_TRACK_KEYFRAME_INTERVAL; i > 0; i--) {
+                // A delta is at most 16 bits, so it's always within the 3 bytes from the one it starts in.
+                const u8 *p = &deltas[bitPos >> 3];
+                u32 word = ((p[0] << 16) | (p[1] << 8) | p[2]) << (8 + (bitPos & 7));
+
+                value += (s32) word >> (32 - bits);
+                bitPos += bits;
+            }
+            break;
+        }
+    }
+
+    return (s16)(value << track[1]);
+}
+
+/**
+ * Decode every channel of a compressed animation at the given frame. Objects playing the same animation
+ * at the same frame share the values, which stay until the next frame unless the cache fills up first.
+ * Only compressed animations go through this: an uncompressed one is already read with a single lookup
+ * per channel, so there's nothing to share. Only Mario's animations can be compressed for now, so
+ * there's only sharing between his update and rendering, not between objects.
+ */
+static s16 *decode_animation_frame(struct Animation *anim, s32 frame) {
+    struct DecodedAnimFrame *decoded;
+    u16 *index = segmented_to_virtual((void *) anim->index);
+    const u8 *data = segmented_to_virtual((void *) anim->values);
+    s32 numChannels = index[0];
+    s16 *values;
+    u32 i;
+
+    if (sDecodedAnimTimer != gGlobalTimer) {
+        sDecodedAnimTimer = gGlobalTimer;
+        sNumDecodedAnimFrames = 0;
+        sNumDecodedAnimValues = 0;
+    }
+
+    for (i = 0; i < sNumDecodedAnimFrames; i++) {
+        decoded = &sDecodedAnimFrames[i];
+        if (decoded->anim == anim && decoded->frame == frame) {
+            PROFILER_ADD_COUNT(PROFILER_COUNT_SHARED_ANIM_FRAMES, 1);
+            return decoded->values;
+        }
+    }
+
+    // The converter rejects animations with more channels, so this only guards against corrupt data.
+    assert(numChannels <= ANIM_MAX_CHANNELS, "Compressed animation has too many channels");
+    if (numChannels > ANIM_MAX_CHANNELS) {
+        numChannels = ANIM_MAX_CHANNELS;
+    }
+    if (sNumDecodedAnimFrames >= ANIM_DECODE_CACHE_FRAMES
+        || sNumDecodedAnimValues + numChannels > ANIM_DECODE_CACHE_VALUES) {
+        sNumDecodedAnimFrames = 0;
+        sNumDecodedAnimValues = 0;
+    }
+
+    decoded = &sDecodedAnimFrames[sNumDecodedAnimFrames++];
+    values = &sDecodedAnimValues[sNumDecodedAnimValues];
+    sNumDecodedAnimValues += numChannels;
+
+    for (i = 0; i < numChannels; i++) {
+        values[i] = decode_animation_track(&data[index[1 + i]], frame);
+    }
+
+    decoded->anim = anim;
+    decoded->frame = frame;
+    decoded->values = values;
+    PROFILER_ADD_COUNT(PROFILER_COUNT_DECODED_ANIM_FRAMES, 1);
+
+    return values;
+}
+
+/**
+ * Forget the decoded frames of an animation whose data was replaced, like Mario's when another of
+ * his animations is loaded into the same buffer.
+ */
+void invalidate_decoded_animation(struct Animation *anim) {
+    u32 i;
+
+    for (i = 0; i < sNumDecodedAnimFrames; i++) {
+        if (sDecodedAnimFrames[i].anim == anim) {
+            sDecodedAnimFrames[i].anim = NULL;
+        }
+    }
+}
+
+/**
+ * Set attributes and values to the tables to read an animation's given frame from with
+ * retrieve_animation_index, and return the frame to read them at. Compressed animations are decoded
+ * first, and are then read at frame 0.
+ */
+s32 get_animation_frame_tables(struct Animation *anim, s32 frame, u16 **attributes, s16 **values) {
+    if (!(anim->flags & ANIM_FLAG_COMPRESSED)) {
+        *attributes = segmented_to_virtual((void *) anim->index);
+        *values = segmented_to_virtual((void *) anim->values);
+        return frame;
+    }
+
+    if (sDecodedAnimAttributes[0] == 0) {
+        s32 i;
+        for (i = 0; i < ANIM_MAX_CHANNELS; i++) {
+            sDecodedAnimAttributes[i * 2 + 0] = 1;
+            sDecodedAnimAttributes[i * 2 + 1] = i;
+        }
+    }
+
+    *attributes = sDecodedAnimAttributes;
+    *values = decode_animation_frame(anim, frame);
+    return 0;
+}
+
 /**
  * Update the animation frame of an object. The animation flags determine
  * whether it plays forwards or backwards, and whether it stops or loops at
@@ -850,14 +1033,15 @@ UNUSED void geo_retreive_animation_translation(struct GraphNodeObject *obj, Vec3
     struct Animation *animation = obj->animInfo.curAnim;
 
     if (animation != NULL) {
-        u16 *attribute = segmented_to_virtual((void *) animation->index);
-        s16 *values = segmented_to_virtual((void *) animation->values);
+        u16 *attribute;
+        s16 *values;
 
         s16 frame = obj->animInfo.animFrame;
 
         if (frame < 0) {
             frame = 0;
         }
+        frame = get_animation_frame_tables(animation, frame, &attribute, &values);
 
         position[0] = (f32) values[retrieve_animation_index(frame, &attribute)];
         position[1] = (f32) values[retrieve_animation_index(frame, &attribute)];
@@ -138,6 +138,9 @@ struct DisplayListNode {
     Mtx *transform;
     void *displayList;
     struct DisplayListNode *next;
+#ifdef MASTER_LIST_BATCHING
+    u32 group; // The object that added it, or 0 outside of objects
+#endif
 };
 
 /** GraphNode that manages the 8 top-level display lists that will be drawn
@@ -214,6 +217,7 @@ struct GraphNodeTranslationRotation {
     /*0x14*/ void *displayList;
     /*0x18*/ Vec3s translation;
     /*0x1E*/ Vec3s rotation;
+    /*0x24*/ struct GraphNodeMatrixCache *matrixCache; // The matrix kept between frames, if it has one. See rendering_graph_node.c
 };
 
 /** GraphNode that translates itself and its children.
@@ -225,6 +229,7 @@ struct GraphNodeTranslation {
     /*0x14*/ void *displayList;
     /*0x18*/ Vec3s translation;
     // u8 filler[2];
+    /*0x20*/ struct GraphNodeMatrixCache *matrixCache;
 };
 
 /** GraphNode that rotates itself and its children.
@@ -237,6 +242,7 @@ struct GraphNodeRotation {
     /*0x14*/ void *displayList;
     /*0x18*/ Vec3s rotation;
     // u8 filler[2];
+    /*0x20*/ struct GraphNodeMatrixCache *matrixCache;
 };
 
 /** GraphNode part that transforms itself and its children based on animation
@@ -283,6 +289,7 @@ struct GraphNodeScale {
     /*0x00*/ struct GraphNode node;
     /*0x14*/ void *displayList;
     /*0x18*/ f32 scale;
+    /*0x1C*/ struct GraphNodeMatrixCache *matrixCache;
 };
 
 /** GraphNode that draws a shadow under an object.
@@ -396,6 +403,8 @@ void geo_obj_init_animation(struct GraphNodeObject *graphNode, struct Animation
 void geo_obj_init_animation_accel(struct GraphNodeObject *graphNode, struct Animation **animPtrAddr, u32 animAccel);
 
 s32  retrieve_animation_index(s32 frame, u16 **attributes);
+s32  get_animation_frame_tables(struct Animation *anim, s32 frame, u16 **attributes, s16 **values);
+void invalidate_decoded_animation(struct Animation *anim);
 
 s32  geo_update_animation_frame(struct AnimInfo *obj, s32 *accelAssist);
 void geo_retreive_animation_translation(struct GraphNodeObject *obj, Vec3f position);
@@ -53,6 +53,11 @@ u16 random_u16(void) {
     return gRandomSeed16;
 }
 
+// Set the random seed, so that everything random that follows happens the same way every time.
+void random_set_seed(u16 seed) {
+    gRandomSeed16 = seed;
+}
+
 // Generate a pseudorandom float in the range [0, 1).
 f32 random_float(void) {
     return ((f32) random_u16() / (f32) 0x10000);
@@ -909,27 +914,20 @@ s32 ray_surface_intersect(Vec3f orig, Vec3f dir, f32 dir_length, struct Surface
     return TRUE;
 }
 
-void find_surface_on_ray_list(struct SurfaceNode *list, Vec3f orig, Vec3f dir, f32 dir_length, struct Surface **hit_surface, Vec3f hit_pos, f32 *max_length) {
+/**
+ * Checks the surfaces of a cell list that reach the height range [bottom, top] the ray covers within the cell.
+ */
+static void find_surface_on_ray_list(struct SurfaceNode *list, Vec3f orig, Vec3f dir, f32 dir_length, f32 bottom, f32 top, struct Surface **hit_surface, Vec3f hit_pos, f32 *max_length) {
     s32 hit;
     f32 length;
     Vec3f chk_hit_pos;
-    f32 top, bottom;
     PUPPYPRINT_GET_SNAPSHOT();
-    // Get upper and lower bounds of ray
-    if (dir[1] >= 0.0f) {
-        // Ray is upwards.
-        top    = orig[1] + (dir[1] * dir_length);
-        bottom = orig[1];
-    } else {
-        // Ray is downwards.
-        top    = orig[1];
-        bottom = orig[1] + (dir[1] * dir_length);
-    }
 
     // Iterate through every surface of the list
     for (; list != NULL; list = list->next) {
         // Reject surface if out of vertical bounds
         if ((list->surface->lowerY > top) || (list->surface->upperY < bottom)) continue;
+        PROFILER_ADD_COUNT(PROFILER_COUNT_RAY_TRIANGLES, 1);
         // Check intersection between the ray and this surface
         hit = ray_surface_intersect(orig, dir, dir_length, list->surface, chk_hit_pos, &length);
         if (hit && (length <= *max_length)) {
@@ -941,26 +939,44 @@ void find_surface_on_ray_list(struct SurfaceNode *list, Vec3f orig, Vec3f dir, f
     profiler_collision_update(first);
 }
 
-void find_surface_on_ray_cell(s32 cellX, s32 cellZ, Vec3f orig, Vec3f normalized_dir, f32 dir_length, struct Surface **hit_surface, Vec3f hit_pos, f32 *max_length, s32 flags) {
+/**
+ * Checks the surfaces of one cell, for the part of the ray between t_enter and t_exit (as fractions of its length).
+ */
+static void find_surface_on_ray_cell(s32 cellX, s32 cellZ, Vec3f orig, Vec3f normalized_dir, f32 dir_length, f32 t_enter, f32 t_exit, struct Surface **hit_surface, Vec3f hit_pos, f32 *max_length, s32 flags) {
     // Skip if OOB
-    if ((cellX >= 0) && (cellX <= (NUM_CELLS - 1)) && (cellZ >= 0) && (cellZ <= (NUM_CELLS - 1))) {
-        // Iterate through each surface in this partition
-        if ((normalized_dir[1] > -NEAR_ONE) && (flags & RAYCAST_FIND_CEIL)) {
-            find_surface_on_ray_list( gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_CEILS ], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
-            find_surface_on_ray_list(gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_CEILS ], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
-        }
-        if ((normalized_dir[1] <  NEAR_ONE) && (flags & RAYCAST_FIND_FLOOR)) {
-            find_surface_on_ray_list( gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
-            find_surface_on_ray_list(gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
-        }
-        if (flags & RAYCAST_FIND_WALL) {
-            find_surface_on_ray_list( gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WALLS ], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
-            find_surface_on_ray_list(gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WALLS ], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
-        }
-        if (flags & RAYCAST_FIND_WATER) {
-            find_surface_on_ray_list( gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WATER ], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
-            find_surface_on_ray_list(gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WATER ], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
-        }
+    if ((cellX < 0) || (cellX > (NUM_CELLS - 1)) || (cellZ < 0) || (cellZ > (NUM_CELLS - 1))) {
+        return;
+    }
+
+    // Get upper and lower bounds of the ray within this cell
+    f32 bottom = orig[1] + (normalized_dir[1] * dir_length * t_enter);
+    f32 top    = orig[1] + (normalized_dir[1] * dir_length * t_exit);
+    if (bottom > top) {
+        f32 temp = bottom;
+        bottom = top;
+        top = temp;
+    }
+
+    // Only check the static lists if the ray is within the height range of the cell's static surfaces
+    struct SurfaceCellHeights *heights = &gStaticSurfaceCellHeights[cellZ][cellX];
+    s32 checkStatic = ((heights->lowerY <= top) && (heights->upperY >= bottom));
+
+    // Iterate through each surface in this partition
+    if ((normalized_dir[1] > -NEAR_ONE) && (flags & RAYCAST_FIND_CEIL)) {
+        if (checkStatic) find_surface_on_ray_list( gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_CEILS ], orig, normalized_dir, dir_length, bottom, top, hit_surface, hit_pos, max_length);
+        find_surface_on_ray_list(gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_CEILS ], orig, normalized_dir, dir_length, bottom, top, hit_surface, hit_pos, max_length);
+    }
+    if ((normalized_dir[1] <  NEAR_ONE) && (flags & RAYCAST_FIND_FLOOR)) {
+        if (checkStatic) find_surface_on_ray_list( gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS], orig, normalized_dir, dir_length, bottom, top, hit_surface, hit_pos, max_length);
+        find_surface_on_ray_list(gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS], orig, normalized_dir, dir_length, bottom, top, hit_surface, hit_pos, max_length);
+    }
+    if (flags & RAYCAST_FIND_WALL) {
+        if (checkStatic) find_surface_on_ray_list( gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WALLS ], orig, normalized_dir, dir_length, bottom, top, hit_surface, hit_pos, max_length);
+        find_surface_on_ray_list(gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WALLS ], orig, normalized_dir, dir_length, bottom, top, hit_surface, hit_pos, max_length);
+    }
+    if (flags & RAYCAST_FIND_WATER) {
+        if (checkStatic) find_surface_on_ray_list( gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WATER ], orig, normalized_dir, dir_length, bottom, top, hit_surface, hit_pos, max_length);
+        find_surface_on_ray_list(gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WATER ], orig, normalized_dir, dir_length, bottom, top, hit_surface, hit_pos, max_length);
     }
 }
 
@@ -968,6 +984,7 @@ f32 find_surface_on_ray(Vec3f orig, Vec3f dir, struct Surface **hit_surface, Vec
     Vec3f normalized_dir;
     const f32 invcell = 1.0f / CELL_SIZE;
     PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.collision_raycast);
+    PROFILER_ADD_COUNT(PROFILER_COUNT_RAYCASTS, 1);
 
     // Set that no surface has been hit
     *hit_surface = NULL;
@@ -987,12 +1004,13 @@ f32 find_surface_on_ray(Vec3f orig, Vec3f dir, struct Surface **hit_surface, Vec
 
     // Don't do grid traversal if straight down
     if ((normalized_dir[1] >= NEAR_ONE) || (normalized_dir[1] <= -NEAR_ONE)) {
-        find_surface_on_ray_cell((s32)start_cell_coord_x, (s32)start_cell_coord_z, orig, normalized_dir, dir_length, hit_surface, hit_pos, &max_length, flags);
+        find_surface_on_ray_cell((s32)start_cell_coord_x, (s32)start_cell_coord_z, orig, normalized_dir, dir_length, 0.0f, 1.0f, hit_surface, hit_pos, &max_length, flags);
         return max_length;
     }
 
     // "A Fast Voxel Traversal Algorithm for Ray Tracing" - John Amanatides & Andrew Woo
     // Adapted from implementation at https://www.shadertoy.com/view/XddcWn
+    // t is the fraction of the ray's length at which it crosses into the next cell on each axis.
     f32 rd_x = end_cell_coord_x - start_cell_coord_x;
     f32 rd_z = end_cell_coord_z - start_cell_coord_z;
     f32 p_x = (s32)start_cell_coord_x;
@@ -1005,11 +1023,13 @@ f32 find_surface_on_ray(Vec3f orig, Vec3f dir, struct Surface **hit_surface, Vec
     f32 delta_z = MIN(rdinv_z * stp_z, 1.0f);
     f32 t_max_x = ABS((p_x + MAX(stp_x, 0.0f) - start_cell_coord_x) * rdinv_x);
     f32 t_max_z = ABS((p_z + MAX(stp_z, 0.0f) - start_cell_coord_z) * rdinv_z);
+    f32 t_enter = 0.0f;
 
     while (TRUE) {
-        find_surface_on_ray_cell((s32)p_x, (s32)p_z, orig, normalized_dir, dir_length, hit_surface, hit_pos, &max_length, flags);
         f32 t_next = MIN(t_max_x, t_max_z);
-        if (t_next > 1.0f) {
+        find_surface_on_ray_cell((s32)p_x, (s32)p_z, orig, normalized_dir, dir_length, t_enter, MIN(t_next, 1.0f), hit_surface, hit_pos, &max_length, flags);
+        // Stop at the end of the ray, or once a hit is closer than anything in the cells after this one.
+        if ((t_next > 1.0f) || (max_length < (t_next * dir_length))) {
             break;
         }
 
@@ -1021,6 +1041,7 @@ f32 find_surface_on_ray(Vec3f orig, Vec3f dir, struct Surface **hit_surface, Vec
             t_max_z += delta_z;
             p_z += stp_z;
         }
+        t_enter = t_next;
     }
     return max_length;
 }
@@ -1029,6 +1050,9 @@ f32 find_surface_on_ray(Vec3f orig, Vec3f dir, struct Surface **hit_surface, Vec
 // Especially fast for halfword floats, which get loaded with a `lui` + `mtc1`.
 static ALWAYS_INLINE float construct_float(const float f)
 {
+#ifndef TARGET_N64
+    return f;
+#else
     u32 r;
     float f_out;
     u32 i = *(u32*)(&f);
@@ -1062,6 +1086,7 @@ static ALWAYS_INLINE float construct_float(const float f)
                          : "=f"(f_out)
                          : "r"(r));
     return f_out;
+#endif
 }
 
 // Converts a floating point matrix to a fixed point matrix
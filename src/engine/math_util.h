@@ -76,9 +76,13 @@ extern f32 gSineTable[];
 
 // Absolute value of a float (faster than using the above macro)
 ALWAYS_INLINE f32 absf(f32 in) {
+#ifdef TARGET_N64
     f32 out;
     __asm__("abs.s %0,%1" : "=f" (out) : "f" (in));
     return out;
+#else
+    return __builtin_fabsf(in);
+#endif
 }
 
 // Get the minimum / maximum of a set of numbers
@@ -113,11 +117,15 @@ void min_max_3s(s16 a, s16 b, s16 c, s16 *min, s16 *max);
 // From Wiseguy
 // Round a float to the nearest integer
 ALWAYS_INLINE s32 roundf(f32 in) {
+#ifdef TARGET_N64
     f32 tmp;
     s32 out;
     __asm__("round.w.s %0,%1" : "=f" (tmp) : "f" (in ));
     __asm__("mfc1      %0,%1" : "=r" (out) : "f" (tmp));
     return out;
+#else
+    return __builtin_lrintf(in);
+#endif
 }
 
 #define round_float roundf
@@ -624,6 +632,7 @@ ALWAYS_INLINE s32 roundf(f32 in) {
 }
 
 u16 random_u16(void);
+void random_set_seed(u16 seed);
 f32 random_float(void);
 s32 random_sign(void);
 
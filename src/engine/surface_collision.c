@@ -384,7 +384,7 @@ f32 find_ceil(f32 posX, f32 posY, f32 posZ, struct Surface **pceil) {
     }
 
     // Check for surfaces that are a part of level geometry.
-    surfaceList = gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_CEILS];
+    surfaceList = get_static_ceil_list(x, z, y);
     ceil = find_ceil_from_list(surfaceList, x, y, z, &height);
 
     // Use the lower ceiling.
@@ -443,6 +443,9 @@ static struct Surface *find_floor_from_list(struct SurfaceNode *surfaceNode, s32
         surfaceNode = surfaceNode->next;
         type        = surf->type;
 
+        // Floors are sorted by upperY, so no floor from here on can be higher than the current one.
+        if (surf->upperY <= *pheight) break;
+
         // To prevent the Merry-Go-Round room from loading when Mario passes above the hole that leads
         // there, SURFACE_INTANGIBLE is used. This prevent the wrong room from loading, but can also allow
         // Mario to pass through.
@@ -580,6 +583,172 @@ f32 unused_find_dynamic_floor(f32 xPos, f32 yPos, f32 zPos, struct Surface **pfl
     return floorHeight;
 }
 
+#ifdef BATCHED_FLOOR_PROBES
+/**************************************************
+ *              BATCHED FLOOR PROBES              *
+ **************************************************/
+
+/**
+ * Objects that look up the floor at their own position get that position probed again once every
+ * object has updated. The probes are sorted by cell and their static floors found in one pass, so
+ * objects sharing cells walk the same lists back to back, and the next frame's find_floor at the
+ * same position only has to check the dynamic floors. Static floors only change when the static
+ * partition does, which clears the probes.
+ */
+enum FloorProbeStates {
+    FLOOR_PROBE_NONE,
+    FLOOR_PROBE_QUEUED,
+    FLOOR_PROBE_RESOLVED,
+};
+
+struct FloorProbe {
+    s16 x, y, z;
+    u8 state;
+    u8 requeue; // The object looked up the floor at its own position this frame
+    f32 height;
+    struct Surface *floor;
+};
+
+// One probe for each object slot.
+static struct FloorProbe sFloorProbes[OBJECT_POOL_CAPACITY];
+static u16 sFloorProbeQueue[OBJECT_POOL_CAPACITY];
+static u16 sFloorProbeSortBuffer[OBJECT_POOL_CAPACITY];
+static s32 sNumQueuedFloorProbes = 0;
+
+/**
+ * Clear every probe, for when the static partition changes.
+ */
+void clear_floor_probes(void) {
+    bzero(sFloorProbes, sizeof(sFloorProbes));
+    sNumQueuedFloorProbes = 0;
+}
+
+/**
+ * Whether the object is in the object pool, and so has a probe. Objects outside of it, like
+ * the macro object parent, always find their floor directly.
+ */
+static s32 obj_has_floor_probe(struct Object *obj) {
+    return (obj >= gObjectPool && obj < gObjectPool + OBJECT_POOL_CAPACITY);
+}
+
+/**
+ * Queue a probe at the object's position, if it looked up the floor there this frame.
+ */
+void queue_object_floor_probe(struct Object *obj) {
+    if (!obj_has_floor_probe(obj)) {
+        return;
+    }
+
+    struct FloorProbe *probe = &sFloorProbes[obj - gObjectPool];
+
+    if (!probe->requeue) {
+        return;
+    }
+    probe->requeue = FALSE;
+
+    s32 x = obj->oPosX;
+    s32 y = obj->oPosY;
+    s32 z = obj->oPosZ;
+
+    if (is_outside_level_bounds(x, z)) {
+        probe->state = FLOOR_PROBE_NONE;
+        return;
+    }
+
+    probe->x = x;
+    probe->y = y;
+    probe->z = z;
+
+    if (probe->state != FLOOR_PROBE_QUEUED) {
+        probe->state = FLOOR_PROBE_QUEUED;
+        sFloorProbeQueue[sNumQueuedFloorProbes++] = obj - gObjectPool;
+    }
+}
+
+/**
+ * Sort the queue by one coordinate of each probe's cell, keeping the order of probes in the same cell.
+ */
+static void sort_floor_probes_by_cell(u16 *src, u16 *dst, s32 useZ) {
+    u16 start[NUM_CELLS];
+    s32 i;
+
+    bzero(start, sizeof(start));
+
+    for (i = 0; i < sNumQueuedFloorProbes; i++) {
+        struct FloorProbe *probe = &sFloorProbes[src[i]];
+        s32 cell = GET_CELL_COORD(useZ ? probe->z : probe->x);
+        if (cell < NUM_CELLS - 1) start[cell + 1]++;
+    }
+    for (i = 1; i < NUM_CELLS; i++) {
+        start[i] += start[i - 1];
+    }
+    for (i = 0; i < sNumQueuedFloorProbes; i++) {
+        struct FloorProbe *probe = &sFloorProbes[src[i]];
+        dst[start[GET_CELL_COORD(useZ ? probe->z : probe->x)]++] = src[i];
+    }
+}
+
+/**
+ * Find the static floor of every queued probe, grouped by cell.
+ */
+void resolve_floor_probes(void) {
+    s16 collisionFlags = gCollisionFlags;
+    s32 i;
+
+    if (sNumQueuedFloorProbes == 0) {
+        return;
+    }
+
+    PUPPYPRINT_GET_SNAPSHOT();
+
+    // Sort by cell X, then by cell Z, so each cell's probes end up together.
+    sort_floor_probes_by_cell(sFloorProbeQueue, sFloorProbeSortBuffer, FALSE);
+    sort_floor_probes_by_cell(sFloorProbeSortBuffer, sFloorProbeQueue, TRUE);
+
+    // Probes are only used by queries without flags, so resolve them the same way.
+    gCollisionFlags = COLLISION_FLAGS_NONE;
+
+    for (i = 0; i < sNumQueuedFloorProbes; i++) {
+        struct FloorProbe *probe = &sFloorProbes[sFloorProbeQueue[i]];
+        struct SurfaceNode *surfaceList = get_static_floor_list(probe->x, probe->z, probe->y + FIND_FLOOR_BUFFER);
+
+        probe->height = FLOOR_LOWER_LIMIT;
+        probe->floor = find_floor_from_list(surfaceList, probe->x, probe->y, probe->z, &probe->height);
+        probe->state = FLOOR_PROBE_RESOLVED;
+    }
+
+    gCollisionFlags = collisionFlags;
+    sNumQueuedFloorProbes = 0;
+
+    profiler_collision_update(first);
+}
+
+/**
+ * Get the current object's resolved probe, if the query is at its position. Otherwise, if the
+ * object is querying its own position, have it probed again once it has updated.
+ */
+static struct FloorProbe *get_object_floor_probe(s32 x, s32 y, s32 z) {
+    struct Object *obj = gCurrentObject;
+
+    if (!obj_has_floor_probe(obj) || (gCollisionFlags & (COLLISION_FLAG_RETURN_FIRST | COLLISION_FLAG_CAMERA | COLLISION_FLAG_INCLUDE_INTANGIBLE))) {
+        return NULL;
+    }
+
+    struct FloorProbe *probe = &sFloorProbes[obj - gObjectPool];
+
+    if (probe->state == FLOOR_PROBE_RESOLVED && probe->x == x && probe->y == y && probe->z == z) {
+        probe->requeue = TRUE;
+        return probe;
+    }
+
+    if ((s32) obj->oPosX == x && (s32) obj->oPosY == y && (s32) obj->oPosZ == z) {
+        probe->requeue = TRUE;
+    }
+
+    return NULL;
+}
+#endif
+
 /**
  * Find the highest floor under a given position and return the height.
  */
@@ -622,9 +791,23 @@ f32 find_floor(f32 xPos, f32 yPos, f32 zPos, struct Surface **pfloor) {
         height = dynamicHeight;
     }
 
-    // Check for surfaces that are a part of level geometry.
-    surfaceList = gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS];
-    floor = find_floor_from_list(surfaceList, x, y, z, &height);
+#ifdef BATCHED_FLOOR_PROBES
+    struct FloorProbe *probe = get_object_floor_probe(x, y, z);
+
+    if (probe != NULL) {
+        // The static floor was already found from this object's probe.
+        PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.collision_probe);
+        if (probe->height > height) {
+            floor  = probe->floor;
+            height = probe->height;
+        }
+    } else
+#endif
+    {
+        // Check for surfaces that are a part of level geometry.
+        surfaceList = get_static_floor_list(x, z, y + FIND_FLOOR_BUFFER);
+        floor = find_floor_from_list(surfaceList, x, y, z, &height);
+    }
 
     // Use the higher floor.
     if (includeDynamic && height <= dynamicHeight) {
@@ -54,6 +54,11 @@ ALWAYS_INLINE f32 find_mario_ceil(Vec3f pos, f32 height, struct Surface **ceil)
 
 f32 find_floor_height(f32 x, f32 y, f32 z);
 f32 find_floor(f32 xPos, f32 yPos, f32 zPos, struct Surface **pfloor);
+#ifdef BATCHED_FLOOR_PROBES
+void clear_floor_probes(void);
+void queue_object_floor_probe(struct Object *obj);
+void resolve_floor_probes(void);
+#endif
 f32 obj_find_floor(struct Object *obj);
 f32 find_room_floor(f32 x, f32 y, f32 z, struct Surface **pfloor);
 s32 get_room_at_pos(f32 x, f32 y, f32 z);
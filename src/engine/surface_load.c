@@ -1,4 +1,5 @@
 #include <PR/ultratypes.h>
+#include <string.h>
 
 #include "sm64.h"
 #include "game/ingame_menu.h"
@@ -25,6 +26,13 @@
  */
 SpatialPartitionCell gStaticSurfacePartition[NUM_CELLS][NUM_CELLS];
 SpatialPartitionCell gDynamicSurfacePartition[NUM_CELLS][NUM_CELLS];
+SpatialPartitionSkipTables gStaticSurfaceSkipTables[NUM_CELLS][NUM_CELLS];
+struct SurfaceCellHeights gStaticSurfaceCellHeights[NUM_CELLS][NUM_CELLS];
+#ifdef STATIC_SURFACE_SUBCELLS
+struct SurfaceSubCell *gStaticSurfaceSubCells[NUM_CELLS][NUM_CELLS];
+s32 gNumStaticSubdividedCells;
+u32 gStaticSubCellData;
+#endif
 struct CellCoords {
     u8 z;
     u8 x;
@@ -53,6 +61,34 @@ void *gDynamicSurfacePoolEnd;
  */
 u32 gTotalStaticSurfaceData;
 
+#ifdef REUSE_UNMOVED_DYNAMIC_SURFACES
+/**
+ * Written to the dynamic surface pool ahead of each object's surfaces. Objects load in the same order
+ * every frame, so if an object's header is still at the end of the pool and the object hasn't moved,
+ * its surfaces from the last frame are still right after it, untouched.
+ */
+struct DynamicSurfaceHeader {
+    struct Object *object;
+    const BehaviorScript *behavior;
+    TerrainData *collisionData;
+    u32 frame;
+    s32 numSurfaces;
+    Vec3f pos;
+    Vec3i faceAngle;
+    Vec3f scale;
+};
+
+/**
+ * Counts the frames the dynamic surfaces were rebuilt on.
+ */
+static u32 sDynamicSurfaceFrame = 0;
+
+/**
+ * The number of dynamic surfaces that were reused this frame.
+ */
+s32 gNumReusedDynamicSurfaces = 0;
+#endif
+
 /**
  * Allocate the part of the surface node pool to contain a surface node.
  */
@@ -88,6 +124,31 @@ static struct Surface *alloc_surface(u32 dynamic) {
     return surface;
 }
 
+/**
+ * The order of each cell list, applied to a surface's upperY.
+ */
+static const s8 sPartitionSortDir[NUM_SPATIAL_PARTITIONS] = {
+    [SPATIAL_PARTITION_FLOORS] =  1, // highest to lowest, then insertion order
+    [SPATIAL_PARTITION_CEILS ] = -1, // lowest to highest, then insertion order
+    [SPATIAL_PARTITION_WALLS ] =  0, // insertion order
+    [SPATIAL_PARTITION_WATER ] =  1, // highest to lowest, then insertion order
+};
+
+/**
+ * Returns which cell list a surface belongs in.
+ */
+static s32 get_surface_partition(struct Surface *surface) {
+    if (SURFACE_IS_NEW_WATER(surface->type)) {
+        return SPATIAL_PARTITION_WATER;
+    } else if (surface->normal.y > NORMAL_FLOOR_THRESHOLD) {
+        return SPATIAL_PARTITION_FLOORS;
+    } else if (surface->normal.y < NORMAL_CEIL_THRESHOLD) {
+        return SPATIAL_PARTITION_CEILS;
+    } else {
+        return SPATIAL_PARTITION_WALLS;
+    }
+}
+
 /**
  * Add a surface to the correct cell list of surfaces.
  * @param dynamic Determines whether the surface is static or dynamic
@@ -98,20 +159,8 @@ static struct Surface *alloc_surface(u32 dynamic) {
 static void add_surface_to_cell(s32 dynamic, s32 cellX, s32 cellZ, struct Surface *surface) {
     struct SurfaceNode **list;
     s32 priority;
-    s32 sortDir = 1; // highest to lowest, then insertion order (water and floors)
-    s32 listIndex;
-
-    if (SURFACE_IS_NEW_WATER(surface->type)) {
-        listIndex = SPATIAL_PARTITION_WATER;
-    } else if (surface->normal.y > NORMAL_FLOOR_THRESHOLD) {
-        listIndex = SPATIAL_PARTITION_FLOORS;
-    } else if (surface->normal.y < NORMAL_CEIL_THRESHOLD) {
-        listIndex = SPATIAL_PARTITION_CEILS;
-        sortDir = -1; // lowest to highest, then insertion order
-    } else {
-        listIndex = SPATIAL_PARTITION_WALLS;
-        sortDir = 0; // insertion order
-    }
+    s32 listIndex = get_surface_partition(surface);
+    s32 sortDir = sPartitionSortDir[listIndex];
 
     s32 surfacePriority = surface->upperY * sortDir;
 
@@ -132,6 +181,23 @@ static void add_surface_to_cell(s32 dynamic, s32 cellX, s32 cellZ, struct Surfac
         }
     } else {
         list = &gStaticSurfacePartition[cellZ][cellX][listIndex];
+        struct SurfaceCellHeights *heights = &gStaticSurfaceCellHeights[cellZ][cellX];
+        heights->lowerY = MIN(heights->lowerY, surface->lowerY);
+        heights->upperY = MAX(heights->upperY, surface->upperY);
+        // The list is no longer one contiguous array, so its skip table can't be used.
+        if (listIndex <= SPATIAL_PARTITION_CEILS) {
+            gStaticSurfaceSkipTables[cellZ][cellX][listIndex] = NULL;
+#ifdef STATIC_SURFACE_SUBCELLS
+            // The sub-cells don't have the new surface, so go back to using the whole cell.
+            gStaticSurfaceSubCells[cellZ][cellX] = NULL;
+#endif
+        }
+#ifdef BATCHED_FLOOR_PROBES
+        // Probed floors may now be under the new surface.
+        if (listIndex == SPATIAL_PARTITION_FLOORS) {
+            clear_floor_probes();
+        }
+#endif
     }
 
     if (*list == NULL) {
@@ -202,6 +268,21 @@ static s32 upper_cell_index(s32 coord) {
     return MIN((NUM_CELLS - 1), index);
 }
 
+/**
+ * Finds the range of cells that a surface overlaps.
+ */
+static void get_surface_cell_range(struct Surface *surface, s32 *minCellX, s32 *maxCellX, s32 *minCellZ, s32 *maxCellZ) {
+    s32 minX, maxX, minZ, maxZ;
+
+    min_max_3i(surface->vertex1[0], surface->vertex2[0], surface->vertex3[0], &minX, &maxX);
+    min_max_3i(surface->vertex1[2], surface->vertex2[2], surface->vertex3[2], &minZ, &maxZ);
+
+    *minCellX = lower_cell_index(minX);
+    *maxCellX = upper_cell_index(maxX);
+    *minCellZ = lower_cell_index(minZ);
+    *maxCellZ = upper_cell_index(maxZ);
+}
+
 /**
  * Every level is split into 16x16 cells, this takes a surface, finds
  * the appropriate cells (with a buffer), and adds the surface to those
@@ -211,15 +292,9 @@ static s32 upper_cell_index(s32 coord) {
  */
 static void add_surface(struct Surface *surface, s32 dynamic) {
     s32 cellZ, cellX;
-    s32 minX, maxX, minZ, maxZ;
+    s32 minCellX, maxCellX, minCellZ, maxCellZ;
 
-    min_max_3i(surface->vertex1[0], surface->vertex2[0], surface->vertex3[0], &minX, &maxX);
-    min_max_3i(surface->vertex1[2], surface->vertex2[2], surface->vertex3[2], &minZ, &maxZ);
-
-    s32 minCellX = lower_cell_index(minX);
-    s32 maxCellX = upper_cell_index(maxX);
-    s32 minCellZ = lower_cell_index(minZ);
-    s32 maxCellZ = upper_cell_index(maxZ);
+    get_surface_cell_range(surface, &minCellX, &maxCellX, &minCellZ, &maxCellZ);
 
     for (cellZ = minCellZ; cellZ <= maxCellZ; cellZ++) {
         for (cellX = minCellX; cellX <= maxCellX; cellX++) {
@@ -328,7 +403,7 @@ static s32 surf_has_no_cam_collision(s32 surfaceType) {
 
 /**
  * Load in the surfaces for a given surface type. This includes setting the flags,
- * exertion, and room.
+ * exertion, and room. The surfaces are added to the partition afterwards, by build_static_surface_partition.
  */
 static void load_static_surfaces(TerrainData **data, TerrainData *vertexData, s32 surfaceType, RoomData **surfaceRooms) {
     s32 i;
@@ -361,8 +436,6 @@ static void load_static_surfaces(TerrainData **data, TerrainData *vertexData, s3
                 surface->force = 0;
             }
 #endif
-
-            add_surface(surface, FALSE);
         }
 
 #ifdef ALL_SURFACES_HAVE_FORCE
@@ -376,6 +449,21 @@ static void load_static_surfaces(TerrainData **data, TerrainData *vertexData, s3
     }
 }
 
+#ifdef BAKED_STATIC_COLLISION
+/**
+ * Skip over the surfaces for a given surface type, for areas with a baked partition.
+ */
+static void skip_static_surfaces(TerrainData **data, s32 surfaceType) {
+    s32 numSurfaces = *(*data)++;
+
+#ifdef ALL_SURFACES_HAVE_FORCE
+    *data += 4 * numSurfaces;
+#else
+    *data += (3 + surface_has_force(surfaceType)) * numSurfaces;
+#endif
+}
+#endif
+
 /**
  * Read the data for vertices for reference by triangles.
  */
@@ -403,6 +491,387 @@ static void load_environmental_regions(TerrainData **data) {
     }
 }
 
+#define SURFACE_SORT_RADIX_BITS 9
+#define SURFACE_SORT_RADIX_SIZE (1 << SURFACE_SORT_RADIX_BITS)
+
+/**
+ * The key that orders surfaces the way add_surface_to_cell would within their list, lowest first.
+ * Floors and water go from highest to lowest upperY, ceilings from lowest to highest, and walls
+ * all share a key. Always fits in 2 * SURFACE_SORT_RADIX_BITS bits.
+ */
+static u32 static_surface_sort_key(struct Surface *surface) {
+    return 0x8000 - (surface->upperY * sPartitionSortDir[get_surface_partition(surface)]);
+}
+
+/**
+ * Fills order with the indices of the surfaces, stably sorted by static_surface_sort_key with two
+ * passes of a radix sort. Filling the cell lists in this order leaves each one sorted, with ties
+ * still in load order. scratch must have room for as many indices as there are surfaces, plus
+ * the radix buckets.
+ */
+static void sort_static_surfaces(struct Surface *surfaces, s32 numSurfaces, u32 *order, u32 *scratch) {
+    u32 *counts = scratch + numSurfaces;
+    u32 *src = order;
+    u32 *dst = scratch;
+    s32 i;
+
+    for (i = 0; i < numSurfaces; i++) {
+        src[i] = i;
+    }
+
+    for (s32 shift = 0; shift < (2 * SURFACE_SORT_RADIX_BITS); shift += SURFACE_SORT_RADIX_BITS) {
+        u32 start = 0;
+
+        bzero(counts, SURFACE_SORT_RADIX_SIZE * sizeof(u32));
+        for (i = 0; i < numSurfaces; i++) {
+            counts[(static_surface_sort_key(&surfaces[i]) >> shift) & (SURFACE_SORT_RADIX_SIZE - 1)]++;
+        }
+        for (i = 0; i < SURFACE_SORT_RADIX_SIZE; i++) {
+            u32 count = counts[i];
+            counts[i] = start;
+            start += count;
+        }
+        for (i = 0; i < numSurfaces; i++) {
+            u32 index = src[i];
+            dst[counts[(static_surface_sort_key(&surfaces[index]) >> shift) & (SURFACE_SORT_RADIX_SIZE - 1)]++] = index;
+        }
+
+        u32 *swap = src;
+        src = dst;
+        dst = swap;
+    }
+}
+
+/**
+ * Builds the skip table for a sorted, contiguous floor or ceiling list.
+ */
+static struct SurfaceSkipTable *build_surface_skip_table(struct SurfaceNode *list, s32 numNodes, s32 listIndex) {
+    s32 isFloor = (listIndex == SPATIAL_PARTITION_FLOORS);
+    s32 minY = 0x7FFF;
+    s32 maxY = -0x8000;
+    s32 shift = 0;
+    s32 band, skip, y;
+
+    // Floors are rejected by lowerY, ceilings by upperY.
+    for (s32 i = 0; i < numNodes; i++) {
+        y = isFloor ? list[i].surface->lowerY : list[i].surface->upperY;
+        if (y < minY) minY = y;
+        if (y > maxY) maxY = y;
+    }
+
+    while (((maxY - minY) >> shift) >= NUM_SURFACE_SKIP_BANDS) {
+        shift++;
+    }
+
+    struct SurfaceSkipTable *table = gCurrStaticSurfacePoolEnd;
+    gCurrStaticSurfacePoolEnd = table + 1;
+
+    table->base = minY;
+    table->shift = shift;
+    table->numSurfaces = numNodes;
+
+    for (band = 0; band < NUM_SURFACE_SKIP_BANDS; band++) {
+        if (isFloor) {
+            // Skip floors whose bottom is above the top of this band.
+            y = minY + ((band + 1) << shift) - 1;
+            for (skip = 0; skip < numNodes && list[skip].surface->lowerY > y; skip++);
+        } else {
+            // Skip ceilings whose top is below the bottom of this band.
+            y = minY + (band << shift);
+            for (skip = 0; skip < numNodes && list[skip].surface->upperY < y; skip++);
+        }
+        table->skip[band] = skip;
+    }
+
+    return table;
+}
+
+#ifdef STATIC_SURFACE_SUBCELLS
+/**
+ * Splits a cell's long floor and ceiling lists into sub-cells. Each sub-cell list keeps every surface
+ * whose bounds overlap the sub-cell, in the same order as the cell list, so queries get the same result.
+ * Lists too short to be worth splitting are shared by all of the sub-cells.
+ */
+static void build_static_surface_subcells(s32 cellX, s32 cellZ, s32 splitLists[SPATIAL_PARTITION_CEILS + 1], void *poolLimit) {
+    uintptr_t dataStart = (uintptr_t) gCurrStaticSurfacePoolEnd;
+    s32 cellMinX = (cellX * CELL_SIZE) - LEVEL_BOUNDARY_MAX;
+    s32 cellMinZ = (cellZ * CELL_SIZE) - LEVEL_BOUNDARY_MAX;
+    s32 minX, maxX, minZ, maxZ;
+
+    struct SurfaceSubCell *subCells = gCurrStaticSurfacePoolEnd;
+    gCurrStaticSurfacePoolEnd = subCells + NUM_SUBCELLS;
+    bzero(subCells, NUM_SUBCELLS * sizeof(struct SurfaceSubCell));
+
+    for (s32 listIndex = SPATIAL_PARTITION_FLOORS; listIndex <= SPATIAL_PARTITION_CEILS; listIndex++) {
+        if (!splitLists[listIndex]) {
+            for (s32 i = 0; i < NUM_SUBCELLS; i++) {
+                subCells[i].lists[listIndex] = gStaticSurfacePartition[cellZ][cellX][listIndex];
+                subCells[i].skipTables[listIndex] = gStaticSurfaceSkipTables[cellZ][cellX][listIndex];
+            }
+            continue;
+        }
+
+        for (s32 subZ = 0; subZ < STATIC_SURFACE_SUBCELLS; subZ++) {
+            s32 subMinZ = cellMinZ + (subZ * SUBCELL_SIZE);
+
+            for (s32 subX = 0; subX < STATIC_SURFACE_SUBCELLS; subX++) {
+                s32 subMinX = cellMinX + (subX * SUBCELL_SIZE);
+                struct SurfaceNode *list = gCurrStaticSurfacePoolEnd;
+                s32 count = 0;
+
+                for (struct SurfaceNode *node = gStaticSurfacePartition[cellZ][cellX][listIndex]; node != NULL; node = node->next) {
+                    struct Surface *surface = node->surface;
+
+                    min_max_3i(surface->vertex1[0], surface->vertex2[0], surface->vertex3[0], &minX, &maxX);
+                    min_max_3i(surface->vertex1[2], surface->vertex2[2], surface->vertex3[2], &minZ, &maxZ);
+
+                    if (maxX < subMinX || minX >= (subMinX + SUBCELL_SIZE)
+                     || maxZ < subMinZ || minZ >= (subMinZ + SUBCELL_SIZE)) {
+                        continue;
+                    }
+
+                    list[count].surface = surface;
+                    list[count].next = &list[count + 1];
+                    count++;
+                }
+
+                if (count == 0) {
+                    continue;
+                }
+
+                list[count - 1].next = NULL;
+                gCurrStaticSurfacePoolEnd = list + count;
+                gSurfaceNodesAllocated += count;
+
+                struct SurfaceSubCell *subCell = &subCells[(subZ * STATIC_SURFACE_SUBCELLS) + subX];
+                subCell->lists[listIndex] = list;
+                if (count >= SURFACE_SKIP_TABLE_MIN_SURFACES) {
+                    subCell->skipTables[listIndex] = build_surface_skip_table(list, count, listIndex);
+                }
+                assert((void *) gCurrStaticSurfacePoolEnd <= poolLimit, "Static surface pool overflow.");
+            }
+        }
+    }
+
+    gStaticSurfaceSubCells[cellZ][cellX] = subCells;
+    gNumStaticSubdividedCells++;
+    gStaticSubCellData += (uintptr_t) gCurrStaticSurfacePoolEnd - dataStart;
+}
+#endif
+
+#define CELL_LIST_INDEX(cellZ, cellX, listIndex) ((((cellZ) * NUM_CELLS) + (cellX)) * NUM_SPATIAL_PARTITIONS + (listIndex))
+
+/**
+ * Adds all of an area's static surfaces to the partition at once. Each cell list is allocated
+ * as one contiguous array of nodes, which keeps list walks within a few cache lines and allows
+ * floors and ceilings to use skip tables. The space at the end of the (not yet shrunk) static
+ * surface pool, up to scratchEnd, is used to count the length of each list.
+ */
+static void build_static_surface_partition(struct Surface *surfaces, s32 numSurfaces, void *scratchEnd) {
+    u32 *cellLists = (u32 *) ((uintptr_t) scratchEnd & ~0x3) - (NUM_CELLS * NUM_CELLS * NUM_SPATIAL_PARTITIONS);
+    s32 minCellX, maxCellX, minCellZ, maxCellZ;
+    s32 cellZ, cellX, listIndex;
+    s32 i;
+
+    bzero(cellLists, (NUM_CELLS * NUM_CELLS * NUM_SPATIAL_PARTITIONS) * sizeof(u32));
+
+    // Count the nodes in each cell list.
+    for (i = 0; i < numSurfaces; i++) {
+        listIndex = get_surface_partition(&surfaces[i]);
+        get_surface_cell_range(&surfaces[i], &minCellX, &maxCellX, &minCellZ, &maxCellZ);
+
+        for (cellZ = minCellZ; cellZ <= maxCellZ; cellZ++) {
+            for (cellX = minCellX; cellX <= maxCellX; cellX++) {
+                cellLists[CELL_LIST_INDEX(cellZ, cellX, listIndex)]++;
+            }
+        }
+    }
+
+    // Turn the counts into the index of the start of each list.
+    u32 numNodes = 0;
+    for (i = 0; i < (NUM_CELLS * NUM_CELLS * NUM_SPATIAL_PARTITIONS); i++) {
+        u32 count = cellLists[i];
+        cellLists[i] = numNodes;
+        numNodes += count;
+    }
+
+    struct SurfaceNode *nodes = gCurrStaticSurfacePoolEnd;
+    gCurrStaticSurfacePoolEnd = nodes + numNodes;
+    gSurfaceNodesAllocated += numNodes;
+    assert((void *) gCurrStaticSurfacePoolEnd <= (void *) cellLists, "Static surface pool overflow.");
+
+    // The space after the nodes isn't in use until the lists are filled, so it holds the sort.
+    u32 *order = (u32 *) gCurrStaticSurfacePoolEnd;
+    assert((void *) (order + (2 * numSurfaces) + SURFACE_SORT_RADIX_SIZE) <= (void *) cellLists, "Static surface pool overflow.");
+    sort_static_surfaces(surfaces, numSurfaces, order, order + numSurfaces);
+
+    // Fill in the lists in sorted order. Afterwards, each index points to the end of its list.
+    for (i = 0; i < numSurfaces; i++) {
+        struct Surface *surface = &surfaces[order[i]];
+        listIndex = get_surface_partition(surface);
+        get_surface_cell_range(surface, &minCellX, &maxCellX, &minCellZ, &maxCellZ);
+
+        for (cellZ = minCellZ; cellZ <= maxCellZ; cellZ++) {
+            for (cellX = minCellX; cellX <= maxCellX; cellX++) {
+                nodes[cellLists[CELL_LIST_INDEX(cellZ, cellX, listIndex)]++].surface = surface;
+            }
+        }
+    }
+
+    u32 start = 0;
+    for (cellZ = 0; cellZ < NUM_CELLS; cellZ++) {
+        for (cellX = 0; cellX < NUM_CELLS; cellX++) {
+            struct SurfaceCellHeights *heights = &gStaticSurfaceCellHeights[cellZ][cellX];
+            heights->lowerY = 0x7FFF;
+            heights->upperY = -0x8000;
+
+            for (listIndex = 0; listIndex < NUM_SPATIAL_PARTITIONS; listIndex++) {
+                u32 end = cellLists[CELL_LIST_INDEX(cellZ, cellX, listIndex)];
+                s32 count = end - start;
+                struct SurfaceNode *list = &nodes[start];
+                start = end;
+
+                if (count == 0) {
+                    continue;
+                }
+
+                for (i = 0; i < count; i++) {
+                    heights->lowerY = MIN(heights->lowerY, list[i].surface->lowerY);
+                    heights->upperY = MAX(heights->upperY, list[i].surface->upperY);
+                }
+
+                for (i = 0; i < count - 1; i++) {
+                    list[i].next = &list[i + 1];
+                }
+                list[count - 1].next = NULL;
+
+                gStaticSurfacePartition[cellZ][cellX][listIndex] = list;
+
+                if (listIndex <= SPATIAL_PARTITION_CEILS && count >= SURFACE_SKIP_TABLE_MIN_SURFACES) {
+                    gStaticSurfaceSkipTables[cellZ][cellX][listIndex] = build_surface_skip_table(list, count, listIndex);
+                    assert((void *) gCurrStaticSurfacePoolEnd <= (void *) cellLists, "Static surface pool overflow.");
+                }
+            }
+        }
+    }
+
+#ifdef STATIC_SURFACE_SUBCELLS
+    // The list lengths aren't needed anymore, so the rest of the pool is available to the sub-cells.
+    for (cellZ = 0; cellZ < NUM_CELLS; cellZ++) {
+        for (cellX = 0; cellX < NUM_CELLS; cellX++) {
+            s32 splitLists[SPATIAL_PARTITION_CEILS + 1];
+
+            for (listIndex = SPATIAL_PARTITION_FLOORS; listIndex <= SPATIAL_PARTITION_CEILS; listIndex++) {
+                struct SurfaceNode *list = gStaticSurfacePartition[cellZ][cellX][listIndex];
+
+                // Lists are contiguous, so the last node gives the length.
+                for (i = 0; list != NULL && list[i].next != NULL; i++);
+
+                splitLists[listIndex] = (list != NULL && (i + 1) >= SUBCELL_MIN_SURFACES);
+            }
+
+            if (splitLists[SPATIAL_PARTITION_FLOORS] || splitLists[SPATIAL_PARTITION_CEILS]) {
+                build_static_surface_subcells(cellX, cellZ, splitLists, scratchEnd);
+            }
+        }
+    }
+#endif
+
+    gCurrStaticSurfacePoolEnd = (u8 *) gCurrStaticSurfacePool + ALIGN8((u8 *) gCurrStaticSurfacePoolEnd - (u8 *) gCurrStaticSurfacePool);
+}
+
+#ifdef BAKED_STATIC_COLLISION
+extern u8 gBakedCollision[];
+
+/**
+ * The table of baked partitions in ROM, loaded once at boot.
+ */
+static struct BakedCollisionTable *sBakedCollisionTable = NULL;
+
+/**
+ * Read the table of baked partitions from ROM.
+ */
+void load_baked_collision_table(void) {
+    struct BakedCollisionTable *table = dynamic_dma_read(gBakedCollision, gBakedCollision + sizeof(u32), MEMORY_POOL_LEFT, 0, 0);
+    u32 size = table->count * sizeof(struct BakedCollisionEntry) +
+        sizeof(struct BakedCollisionTable) - sizeof(struct BakedCollisionEntry);
+    main_pool_free(table);
+
+    sBakedCollisionTable = dynamic_dma_read(gBakedCollision, gBakedCollision + size, MEMORY_POOL_LEFT, 0, 0);
+    sBakedCollisionTable->srcAddr = gBakedCollision;
+}
+
+/**
+ * Load the area's static partition from ROM, if it was baked. The blob is read straight into the
+ * static surface pool with a single DMA, and its pointers are relocated to where it landed.
+ * Returns whether the partition was loaded.
+ */
+static s32 load_baked_static_surfaces(s32 index, TerrainData *data, RoomData *surfaceRooms, u32 poolSize) {
+    struct BakedCollisionEntry *entry = NULL;
+    u32 i, j;
+
+    if (sBakedCollisionTable == NULL) {
+        return FALSE;
+    }
+
+    const TerrainData *segmentedData = virtual_to_segmented(SEGMENT_LEVEL_DATA, data);
+    const RoomData *segmentedRooms = (surfaceRooms != NULL) ? virtual_to_segmented(SEGMENT_LEVEL_DATA, surfaceRooms) : NULL;
+
+    for (i = 0; i < sBakedCollisionTable->count; i++) {
+        if (sBakedCollisionTable->entries[i].levelNum == gCurrLevelNum
+         && sBakedCollisionTable->entries[i].areaIndex == index
+         && sBakedCollisionTable->entries[i].terrainData == segmentedData
+         && sBakedCollisionTable->entries[i].surfaceRooms == segmentedRooms) {
+            entry = &sBakedCollisionTable->entries[i];
+            break;
+        }
+    }
+
+    if (entry == NULL || ALIGN16(entry->size) > poolSize) {
+        return FALSE;
+    }
+
+    u8 *blob = gCurrStaticSurfacePool;
+    u8 *srcAddr = sBakedCollisionTable->srcAddr + entry->offset;
+    dma_read(blob, srcAddr, srcAddr + entry->size);
+
+    struct BakedCollisionHeader *header = (struct BakedCollisionHeader *) (blob + entry->size - sizeof(struct BakedCollisionHeader));
+    if (header->magic != BAKED_COLLISION_MAGIC || header->layout != BAKED_COLLISION_LAYOUT) {
+        return FALSE;
+    }
+
+    // Turn every offset back into a pointer.
+    u32 *words = (u32 *) blob;
+    u32 *relocs = (u32 *) (blob + header->relocOffset);
+    u32 numWords = header->relocOffset / sizeof(u32);
+
+    for (i = 0; i < numWords; i += 32) {
+        u32 bits = relocs[i / 32];
+
+        for (j = i; bits != 0; j++, bits >>= 1) {
+            if (bits & 1) {
+                words[j] += (uintptr_t) blob;
+            }
+        }
+    }
+
+    memcpy(gStaticSurfacePartition, blob + header->partitionOffset, sizeof(gStaticSurfacePartition));
+    memcpy(gStaticSurfaceSkipTables, blob + header->skipTablesOffset, sizeof(gStaticSurfaceSkipTables));
+    memcpy(gStaticSurfaceCellHeights, blob + header->cellHeightsOffset, sizeof(gStaticSurfaceCellHeights));
+#ifdef STATIC_SURFACE_SUBCELLS
+    memcpy(gStaticSurfaceSubCells, blob + header->subCellsOffset, sizeof(gStaticSurfaceSubCells));
+    gNumStaticSubdividedCells = header->numSubdividedCells;
+    gStaticSubCellData = header->subCellData;
+#endif
+
+    gSurfacesAllocated = header->numSurfaces;
+    gSurfaceNodesAllocated = header->numNodes;
+    gCurrStaticSurfacePoolEnd = blob + header->poolSize;
+
+    return TRUE;
+}
+#endif
+
 /**
  * Allocate the dynamic surface pool for object collision.
  */
@@ -480,6 +949,7 @@ void load_area_terrain(s32 index, TerrainData *data, RoomData *surfaceRooms, s16
     s32 terrainLoadType;
     TerrainData *vertexData = NULL;
     u32 surfacePoolData;
+    u32 surfacePoolSize;
 
     // Initialize the data for this.
     gEnvironmentRegions = NULL;
@@ -491,12 +961,28 @@ void load_area_terrain(s32 index, TerrainData *data, RoomData *surfaceRooms, s16
 
     // Clear the static (level) surface partitions for new use.
     bzero(gStaticSurfacePartition, sizeof(gStaticSurfacePartition));
+    bzero(gStaticSurfaceSkipTables, sizeof(gStaticSurfaceSkipTables));
+#ifdef STATIC_SURFACE_SUBCELLS
+    bzero(gStaticSurfaceSubCells, sizeof(gStaticSurfaceSubCells));
+    gNumStaticSubdividedCells = 0;
+    gStaticSubCellData = 0;
+#endif
     gTotalStaticSurfaceData = 0;
+#ifdef BATCHED_FLOOR_PROBES
+    clear_floor_probes();
+#endif
 
     // Initialise a new surface pool for this block of static surface data
-    gCurrStaticSurfacePool = main_pool_alloc(main_pool_available() - 0x10, MEMORY_POOL_LEFT);
+    surfacePoolSize = main_pool_available() - 0x10;
+    gCurrStaticSurfacePool = main_pool_alloc(surfacePoolSize, MEMORY_POOL_LEFT);
     gCurrStaticSurfacePoolEnd = gCurrStaticSurfacePool;
 
+#ifdef BAKED_STATIC_COLLISION
+    s32 baked = load_baked_static_surfaces(index, data, surfaceRooms, surfacePoolSize);
+#else
+    s32 baked = FALSE;
+#endif
+
     // A while loop iterating through each section of the level data. Sections of data
     // are prefixed by a terrain "type." This type is reused for surfaces as the surface
     // type.
@@ -504,6 +990,12 @@ void load_area_terrain(s32 index, TerrainData *data, RoomData *surfaceRooms, s16
         terrainLoadType = *data++;
 
         if (TERRAIN_LOAD_IS_SURFACE_TYPE_LOW(terrainLoadType)) {
+#ifdef BAKED_STATIC_COLLISION
+            if (baked) {
+                skip_static_surfaces(&data, terrainLoadType);
+                continue;
+            }
+#endif
             load_static_surfaces(&data, vertexData, terrainLoadType, &surfaceRooms);
         } else if (terrainLoadType == TERRAIN_LOAD_VERTICES) {
             vertexData = read_vertex_data(&data);
@@ -516,11 +1008,22 @@ void load_area_terrain(s32 index, TerrainData *data, RoomData *surfaceRooms, s16
         } else if (terrainLoadType == TERRAIN_LOAD_END) {
             break;
         } else if (TERRAIN_LOAD_IS_SURFACE_TYPE_HIGH(terrainLoadType)) {
+#ifdef BAKED_STATIC_COLLISION
+            if (baked) {
+                skip_static_surfaces(&data, terrainLoadType);
+                continue;
+            }
+#endif
             load_static_surfaces(&data, vertexData, terrainLoadType, &surfaceRooms);
             continue;
         }
     }
 
+    if (!baked) {
+        // The surfaces were read in one block at the start of the pool.
+        build_static_surface_partition(gCurrStaticSurfacePool, gSurfacesAllocated, (u8 *) gCurrStaticSurfacePool + surfacePoolSize);
+    }
+
     if (macroObjects != NULL && *macroObjects != -1) {
         // If the first macro object presetID is within the range [0, 29].
         // Generally an early spawning method, every object is in BBH (the first level).
@@ -553,6 +1056,10 @@ void clear_dynamic_surfaces(void) {
         gSurfacesAllocated = gNumStaticSurfaces;
         gSurfaceNodesAllocated = gNumStaticSurfaceNodes;
         gDynamicSurfacePoolEnd = gDynamicSurfacePool;
+#ifdef REUSE_UNMOVED_DYNAMIC_SURFACES
+        sDynamicSurfaceFrame++;
+        gNumReusedDynamicSurfaces = 0;
+#endif
         if (sClearAllCells) {
             bzero(gDynamicSurfacePartition, sizeof(gDynamicSurfacePartition));
         } else {
@@ -637,7 +1144,15 @@ void load_object_surfaces(TerrainData **data, TerrainData *vertexData, u32 dynam
 
             surface->flags |= flags;
             surface->room = room;
+#ifdef REUSE_UNMOVED_DYNAMIC_SURFACES
+            // Dynamic surfaces are added to the cells once all of the object's surfaces are loaded,
+            // so that they stay next to each other in the pool and can be reused next frame.
+            if (!dynamic) {
+                add_surface(surface, FALSE);
+            }
+#else
             add_surface(surface, dynamic);
+#endif
         }
 
 #ifdef ALL_SURFACES_HAVE_FORCE
@@ -673,6 +1188,82 @@ static void get_optimal_coll_dist(struct Object *obj) {
 
 static TerrainData sVertexData[600];
 
+#ifdef REUSE_UNMOVED_DYNAMIC_SURFACES
+/**
+ * Copy the position, angle and scale that the object's surfaces were built from to a header.
+ */
+static void set_dynamic_surface_header_transform(struct DynamicSurfaceHeader *header) {
+    vec3f_copy(header->pos, &o->oPosVec);
+    vec3i_copy(header->faceAngle, &o->oFaceAngleVec);
+    vec3f_copy(header->scale, o->header.gfx.scale);
+}
+
+#define vec3_unchanged(a, b) ((a)[0] == (b)[0] && (a)[1] == (b)[1] && (a)[2] == (b)[2])
+
+/**
+ * Whether the header holds the object's surfaces from the last frame, at its current position, angle and scale.
+ * Objects that set up their own transform (throwMatrix is already set) aren't built from these, so they're never reused.
+ */
+static s32 dynamic_surface_header_matches(struct DynamicSurfaceHeader *header) {
+    return (header->object == o
+         && header->behavior == o->behavior
+         && header->collisionData == o->collisionData
+         && header->frame == sDynamicSurfaceFrame - 1
+         && o->header.gfx.throwMatrix == NULL
+         && vec3_unchanged(header->pos, &o->oPosVec)
+         && vec3_unchanged(header->faceAngle, &o->oFaceAngleVec)
+         && vec3_unchanged(header->scale, o->header.gfx.scale));
+}
+
+/**
+ * Add the surfaces right after the header to the cells. Their surface nodes are allocated after them.
+ */
+static void add_dynamic_surfaces_to_cells(struct DynamicSurfaceHeader *header) {
+    struct Surface *surface = (struct Surface *) (header + 1);
+    gDynamicSurfacePoolEnd = surface + header->numSurfaces;
+
+    for (s32 i = 0; i < header->numSurfaces; i++) {
+        add_surface(surface++, TRUE);
+    }
+}
+
+/**
+ * Load the object's surfaces, reusing the last frame's if the object hasn't moved.
+ */
+static void load_object_dynamic_surfaces(TerrainData *collisionData) {
+    struct DynamicSurfaceHeader *header = gDynamicSurfacePoolEnd;
+    gDynamicSurfacePoolEnd = header + 1;
+
+    if (dynamic_surface_header_matches(header)) {
+        // Platform displacement and rendering still expect the transform transform_object_vertices would build.
+        o->header.gfx.throwMatrix = &o->transform;
+        obj_build_transform_from_pos_and_angle(o, O_POS_INDEX, O_FACE_ANGLE_INDEX);
+
+        // The surfaces are unchanged, so only add them to the cells again.
+        gSurfacesAllocated += header->numSurfaces;
+        gNumReusedDynamicSurfaces += header->numSurfaces;
+    } else {
+        s32 numSurfaces = gSurfacesAllocated;
+
+        transform_object_vertices(&collisionData, sVertexData);
+
+        // TERRAIN_LOAD_CONTINUE acts as an "end" to the terrain data.
+        while (*collisionData != TERRAIN_LOAD_CONTINUE) {
+            load_object_surfaces(&collisionData, sVertexData, TRUE);
+        }
+
+        header->object = o;
+        header->behavior = o->behavior;
+        header->collisionData = o->collisionData;
+        header->numSurfaces = gSurfacesAllocated - numSurfaces;
+        set_dynamic_surface_header_transform(header);
+    }
+
+    header->frame = sDynamicSurfaceFrame;
+    add_dynamic_surfaces_to_cells(header);
+}
+#endif
+
 /**
  * Transform an object's vertices, reload them, and render the object.
  */
@@ -717,12 +1308,16 @@ void load_object_collision_model(void) {
         && !(o->activeFlags & ACTIVE_FLAG_IN_DIFFERENT_ROOM)
     ) {
         collisionData++;
+#ifdef REUSE_UNMOVED_DYNAMIC_SURFACES
+        load_object_dynamic_surfaces(collisionData);
+#else
         transform_object_vertices(&collisionData, sVertexData);
 
         // TERRAIN_LOAD_CONTINUE acts as an "end" to the terrain data.
         while (*collisionData != TERRAIN_LOAD_CONTINUE) {
             load_object_surfaces(&collisionData, sVertexData, TRUE);
         }
+#endif
     }
 
     f32 marioDist = o->oDistanceToMario;
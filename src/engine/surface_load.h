@@ -5,6 +5,7 @@
 
 #include "surface_collision.h"
 #include "types.h"
+#include "game/puppyprint.h"
 
 #define SURFACE_VERTICAL_BUFFER 5
 
@@ -31,15 +32,218 @@ enum SpatialPartitions {
 
 typedef struct SurfaceNode *SpatialPartitionCell[NUM_SPATIAL_PARTITIONS];
 
+/**
+ * Static floor and ceiling lists with at least this many surfaces get a skip table,
+ * which splits the heights in that list into NUM_SURFACE_SKIP_BANDS bands.
+ */
+#define SURFACE_SKIP_TABLE_MIN_SURFACES 8
+#define NUM_SURFACE_SKIP_BANDS 8
+
+/**
+ * For each height band, how many surfaces at the start of a static cell list can be skipped
+ * by any query in that band. Floors skip surfaces whose lowerY is above the band, ceilings
+ * skip surfaces whose upperY is below it. Only valid while the list is one contiguous array.
+ */
+struct SurfaceSkipTable {
+    s32 base;        // Height at the bottom of the first band
+    u16 shift;       // log2 of the height of each band
+    u16 numSurfaces;
+    u16 skip[NUM_SURFACE_SKIP_BANDS];
+};
+
+typedef struct SurfaceSkipTable *SpatialPartitionSkipTables[SPATIAL_PARTITION_CEILS + 1];
+
+/**
+ * The lowest lowerY and highest upperY of the static surfaces in a cell, so raycasts can skip
+ * cells they pass above or below. Cells without static surfaces have lowerY above upperY.
+ */
+struct SurfaceCellHeights {
+    s16 lowerY;
+    s16 upperY;
+};
+
 extern SpatialPartitionCell gStaticSurfacePartition[NUM_CELLS][NUM_CELLS];
 extern SpatialPartitionCell gDynamicSurfacePartition[NUM_CELLS][NUM_CELLS];
+extern SpatialPartitionSkipTables gStaticSurfaceSkipTables[NUM_CELLS][NUM_CELLS];
+extern struct SurfaceCellHeights gStaticSurfaceCellHeights[NUM_CELLS][NUM_CELLS];
+
+#ifdef STATIC_SURFACE_SUBCELLS
+/**
+ * Static cells with at least this many floors or ceilings are split into sub-cells.
+ */
+#define SUBCELL_MIN_SURFACES 32
+
+#define SUBCELL_SIZE            (CELL_SIZE / STATIC_SURFACE_SUBCELLS)
+#define NUM_SUBCELLS            (STATIC_SURFACE_SUBCELLS * STATIC_SURFACE_SUBCELLS)
+#define GET_SUBCELL_COORD(p)    (((((s32)(p) + LEVEL_BOUNDARY_MAX) & (CELL_SIZE - 1)) / SUBCELL_SIZE))
+
+/**
+ * The floors and ceilings of one sub-cell, in the same order as the cell's own lists.
+ */
+struct SurfaceSubCell {
+    struct SurfaceNode *lists[SPATIAL_PARTITION_CEILS + 1];
+    struct SurfaceSkipTable *skipTables[SPATIAL_PARTITION_CEILS + 1];
+};
+
+extern struct SurfaceSubCell *gStaticSurfaceSubCells[NUM_CELLS][NUM_CELLS];
+extern s32 gNumStaticSubdividedCells;
+extern u32 gStaticSubCellData;
+#endif
+
+/**
+ * Static partitions baked by tools/collision_bake, for BAKED_STATIC_COLLISION.
+ */
+#define BAKED_COLLISION_MAGIC 0x53424332 // "SBC2"
+
+#ifdef STATIC_SURFACE_SUBCELLS
+#define BAKED_COLLISION_SUBCELLS (STATIC_SURFACE_SUBCELLS | (SUBCELL_MIN_SURFACES << 8))
+#else
+#define BAKED_COLLISION_SUBCELLS 0
+#endif
+
+#ifdef ALL_SURFACES_HAVE_FORCE
+#define BAKED_COLLISION_FORCE 1
+#else
+#define BAKED_COLLISION_FORCE 0
+#endif
+
+#ifdef ENABLE_VANILLA_LEVEL_SPECIFIC_CHECKS
+#define BAKED_COLLISION_LEVEL_CHECKS 1
+#else
+#define BAKED_COLLISION_LEVEL_CHECKS 0
+#endif
+
+// One FNV-1a step, so that the layout can be hashed at compile time.
+#define BAKED_COLLISION_HASH(hash, value) (((u32) (hash) ^ (u32) (value)) * 0x01000193U)
+
+/**
+ * A hash of every setting that changes the contents of a baked partition. Blobs baked with different
+ * settings are ignored, and the partition is built at load instead.
+ */
+#define BAKED_COLLISION_LAYOUT                                                                                            \
+    BAKED_COLLISION_HASH(BAKED_COLLISION_HASH(BAKED_COLLISION_HASH(BAKED_COLLISION_HASH(BAKED_COLLISION_HASH(             \
+    BAKED_COLLISION_HASH(BAKED_COLLISION_HASH(BAKED_COLLISION_HASH(BAKED_COLLISION_HASH(BAKED_COLLISION_HASH(0x811C9DC5U, \
+        LEVEL_BOUNDARY_MAX),                                                                                              \
+        CELL_SIZE),                                                                                                       \
+        BAKED_COLLISION_SUBCELLS),                                                                                        \
+        NUM_SURFACE_SKIP_BANDS),                                                                                          \
+        SURFACE_SKIP_TABLE_MIN_SURFACES),                                                                                 \
+        SURFACE_VERTICAL_BUFFER),                                                                                         \
+        sizeof(TerrainData)),                                                                                             \
+        sizeof(RoomData)),                                                                                                \
+        BAKED_COLLISION_FORCE),                                                                                           \
+        BAKED_COLLISION_LEVEL_CHECKS)
+
+/**
+ * A baked static partition, as written by tools/collision_bake. The blob is the static surface pool
+ * followed by the partition tables, the relocation bitmap and this header. Every pointer in the pool
+ * and tables is stored as an offset from the start of the blob, and has its bit set in the bitmap.
+ */
+struct BakedCollisionHeader {
+    u32 magic;
+    u32 layout;
+    u32 poolSize;           // Size of the surface pool data at the start of the blob
+    u32 partitionOffset;    // Heads of the static cell lists
+    u32 skipTablesOffset;   // Skip table of each static cell list
+    u32 subCellsOffset;     // Sub-cells of each static cell, if enabled
+    u32 cellHeightsOffset;  // Height range of each static cell
+    u32 relocOffset;        // One bit for each word before this offset
+    u32 numSurfaces;
+    u32 numNodes;
+    u32 numSubdividedCells;
+    u32 subCellData;
+};
+
+/**
+ * Baked partitions are found by the level and area they were baked for, along with the segmented
+ * addresses of the area's terrain and room data, since every level's data shares the same segment.
+ */
+struct BakedCollisionEntry {
+    s16 levelNum;
+    s16 areaIndex;
+    const TerrainData *terrainData;
+    const RoomData *surfaceRooms;
+    u32 offset;
+    u32 size;
+};
+
+struct BakedCollisionTable {
+    u32 count;
+    u8 *srcAddr;
+    struct BakedCollisionEntry entries[1]; // dynamic size
+};
+
 extern void *gCurrStaticSurfacePool;
 extern void *gDynamicSurfacePool;
 extern void *gCurrStaticSurfacePoolEnd;
 extern void *gDynamicSurfacePoolEnd;
 extern u32 gTotalStaticSurfaceData;
+#ifdef REUSE_UNMOVED_DYNAMIC_SURFACES
+extern s32 gNumReusedDynamicSurfaces;
+#endif
+
+/**
+ * Gets the static floor or ceiling list to check for a point, using its sub-cell if the cell is split.
+ */
+ALWAYS_INLINE struct SurfaceNode *get_static_cell_list(s32 x, s32 z, s32 listIndex, struct SurfaceSkipTable **table) {
+    s32 cellX = GET_CELL_COORD(x);
+    s32 cellZ = GET_CELL_COORD(z);
+#ifdef STATIC_SURFACE_SUBCELLS
+    struct SurfaceSubCell *subCells = gStaticSurfaceSubCells[cellZ][cellX];
+
+    if (subCells != NULL) {
+        struct SurfaceSubCell *subCell = &subCells[(GET_SUBCELL_COORD(z) * STATIC_SURFACE_SUBCELLS) + GET_SUBCELL_COORD(x)];
+        PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.collision_subcell);
+        *table = subCell->skipTables[listIndex];
+        return subCell->lists[listIndex];
+    }
+#endif
+    *table = gStaticSurfaceSkipTables[cellZ][cellX][listIndex];
+    return gStaticSurfacePartition[cellZ][cellX][listIndex];
+}
+
+/**
+ * Returns the first static floor for a point that could be at or below bufferY.
+ */
+ALWAYS_INLINE struct SurfaceNode *get_static_floor_list(s32 x, s32 z, s32 bufferY) {
+    struct SurfaceSkipTable *table;
+    struct SurfaceNode *list = get_static_cell_list(x, z, SPATIAL_PARTITION_FLOORS, &table);
+
+    if (table == NULL) return list;
+
+    s32 band = (bufferY - table->base) >> table->shift;
+
+    // Every floor in the cell is above the point.
+    if (band < 0) return NULL;
+    if (band >= NUM_SURFACE_SKIP_BANDS) return list;
+
+    s32 skip = table->skip[band];
+    return (skip < table->numSurfaces) ? (list + skip) : NULL;
+}
+
+/**
+ * Returns the first static ceiling for a point that could be at or above y.
+ */
+ALWAYS_INLINE struct SurfaceNode *get_static_ceil_list(s32 x, s32 z, s32 y) {
+    struct SurfaceSkipTable *table;
+    struct SurfaceNode *list = get_static_cell_list(x, z, SPATIAL_PARTITION_CEILS, &table);
+
+    if (table == NULL) return list;
+
+    s32 band = (y - table->base) >> table->shift;
+
+    if (band < 0) return list;
+    // Every ceiling in the cell is below the point.
+    if (band >= NUM_SURFACE_SKIP_BANDS) return NULL;
+
+    s32 skip = table->skip[band];
+    return (skip < table->numSurfaces) ? (list + skip) : NULL;
+}
 
 void alloc_surface_pools(void);
+#ifdef BAKED_STATIC_COLLISION
+void load_baked_collision_table(void);
+#endif
 #ifdef NO_SEGMENTED_MEMORY
 u32 get_area_terrain_size(TerrainData *data);
 #endif
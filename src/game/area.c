@@ -26,6 +26,7 @@
 #include "debug_box.h"
 #include "engine/colors.h"
 #include "profiling.h"
+#include "demo_benchmark.h"
 #ifdef S2DEX_TEXT_ENGINE
 #include "s2d_engine/init.h"
 #endif
@@ -209,6 +210,10 @@ void clear_areas(void) {
         gAreaData[i].betterReverbPreset = 0;
 #endif
     }
+
+#ifdef GRAPH_NODE_MATRIX_CACHE
+    clear_matrix_caches();
+#endif
 }
 
 void clear_area_graph_nodes(void) {
@@ -390,6 +395,7 @@ void play_transition_after_delay(s16 transType, s16 time, u8 red, u8 green, u8 b
 
 void render_game(void) {
     PROFILER_GET_SNAPSHOT_TYPE(PROFILER_DELTA_COLLISION);
+    PROFILER_SCOPE_BEGIN("Render");
     if (gCurrentArea != NULL && !gWarpTransition.pauseRendering) {
         if (gCurrentArea->graphNode) {
             geo_process_root(gCurrentArea->graphNode, gViewportOverride, gViewportClip, gFBSetColor);
@@ -464,8 +470,12 @@ void render_game(void) {
     gViewportOverride = NULL;
     gViewportClip     = NULL;
 
+    PROFILER_SCOPE_END();
     profiler_update(PROFILER_TIME_GFX, profiler_get_delta(PROFILER_DELTA_COLLISION) - first);
     profiler_print_times();
+#ifdef ENABLE_DEMO_BENCHMARK
+    demo_benchmark_print_results();
+#endif
 #ifdef PUPPYPRINT_DEBUG
     puppyprint_render_profiler();
 #endif
@@ -183,7 +183,7 @@ void bhv_moneybag_loop(void) {
             o->oOpacity += 12;
             if (o->oOpacity > 255) {
                 o->oOpacity = 255;
-                o->parentObj->activeFlags = ACTIVE_FLAG_DEACTIVATED;
+                obj_mark_for_deletion(o->parentObj);
                 o->oAction = MONEYBAG_ACT_MOVE_AROUND;
             }
             break;
@@ -31,16 +31,16 @@ static struct Object *link_objects_with_behavior(const BehaviorScript *behavior)
     const BehaviorScript *behaviorAddr = segmented_to_virtual(behavior);
     struct Object *obj;
     struct Object *lastObject = NULL;
-    struct ObjectNode *listHead = &gObjectLists[get_object_list_from_behavior(behaviorAddr)];
+    u32 objList = get_object_list_from_behavior(behaviorAddr);
 
-    obj = (struct Object *) listHead->next;
-    while (obj != (struct Object *) listHead) {
-        if (obj->behavior == behaviorAddr && obj->activeFlags != ACTIVE_FLAG_DEACTIVATED) {
+    obj = behavior_bucket_first(behaviorAddr);
+    while (obj != NULL) {
+        if (obj->behavior == behaviorAddr && obj->objListIndex == objList && obj->activeFlags != ACTIVE_FLAG_DEACTIVATED) {
             obj->parentObj = lastObject;
             lastObject = obj;
         }
 
-        obj = (struct Object *) obj->header.next;
+        obj = obj->bhvBucketNext;
     }
 
     return lastObject;
@@ -2866,12 +2866,37 @@ void update_lakitu(struct Camera *c) {
     gLakituState.defMode = c->defMode;
 }
 
+#ifdef PROFILER_SCOPES
+// Scope names for each camera mode, so that the time taken by each mode is shown separately.
+static const char *sCameraModeScopeNames[] = {
+    [CAMERA_MODE_NONE]              = "No mode",
+    [CAMERA_MODE_RADIAL]            = "Radial mode",
+    [CAMERA_MODE_OUTWARD_RADIAL]    = "Outward radial mode",
+    [CAMERA_MODE_BEHIND_MARIO]      = "Behind Mario mode",
+    [CAMERA_MODE_CLOSE]             = "Close mode",
+    [CAMERA_MODE_5]                 = "Mode 5",
+    [CAMERA_MODE_C_UP]              = "C-Up mode",
+    [CAMERA_MODE_7]                 = "Mode 7",
+    [CAMERA_MODE_WATER_SURFACE]     = "Water surface mode",
+    [CAMERA_MODE_SLIDE_HOOT]        = "Slide mode",
+    [CAMERA_MODE_INSIDE_CANNON]     = "Cannon mode",
+    [CAMERA_MODE_BOSS_FIGHT]        = "Boss fight mode",
+    [CAMERA_MODE_PARALLEL_TRACKING] = "Parallel tracking mode",
+    [CAMERA_MODE_FIXED]             = "Fixed mode",
+    [CAMERA_MODE_8_DIRECTIONS]      = "8 directions mode",
+    [CAMERA_MODE_0F]                = "Mode 15",
+    [CAMERA_MODE_FREE_ROAM]         = "Free roam mode",
+    [CAMERA_MODE_SPIRAL_STAIRS]     = "Spiral stairs mode",
+};
+#endif
+
 /**
  * The main camera update function.
  * Gets controller input, checks for cutscenes, handles mode changes, and moves the camera
  */
 void update_camera(struct Camera *c) {
     PROFILER_GET_SNAPSHOT_TYPE(PROFILER_DELTA_COLLISION);
+    PROFILER_SCOPE_BEGIN("Camera");
     gCamera = c;
     update_camera_hud_status(c);
     if (c->cutscene == CUTSCENE_NONE
@@ -2929,7 +2954,9 @@ void update_camera(struct Camera *c) {
 
     if (c->cutscene != CUTSCENE_NONE) {
         sYawSpeed = 0;
+        PROFILER_SCOPE_BEGIN("Cutscene");
         play_cutscene(c);
+        PROFILER_SCOPE_END();
         sFramesSinceCutsceneEnded = 0;
     } else {
         // Clear the recent cutscene after 8 frames
@@ -2945,6 +2972,7 @@ void update_camera(struct Camera *c) {
     if (c->cutscene == CUTSCENE_NONE) {
         sYawSpeed = 0x400;
 
+        PROFILER_SCOPE_BEGIN((c->mode < ARRAY_COUNT(sCameraModeScopeNames)) ? sCameraModeScopeNames[c->mode] : "Other mode");
         if (sSelectionFlags & CAM_MODE_MARIO_ACTIVE) {
             switch (c->mode) {
                 case CAMERA_MODE_BEHIND_MARIO:
@@ -3025,6 +3053,7 @@ void update_camera(struct Camera *c) {
                     break;
             }
         }
+        PROFILER_SCOPE_END();
     }
 #ifdef PUPPYCAM
     }
@@ -3075,7 +3104,9 @@ void update_camera(struct Camera *c) {
     }
 #endif
 
+    PROFILER_SCOPE_BEGIN("Lakitu");
     update_lakitu(c);
+    PROFILER_SCOPE_END();
 #ifdef PUPPYCAM
     }
     // Just a cute little bit that syncs puppycamera up to vanilla when playing a vanilla cutscene :3
@@ -3098,7 +3129,9 @@ void update_camera(struct Camera *c) {
                 sFramesSinceCutsceneEnded = 0;
             }
         }
+        PROFILER_SCOPE_BEGIN("Puppycam");
         puppycam_loop();
+        PROFILER_SCOPE_END();
         // Apply camera shakes
         shake_camera_pitch(gLakituState.pos, gLakituState.focus);
         shake_camera_yaw(gLakituState.pos, gLakituState.focus);
@@ -3114,6 +3147,7 @@ void update_camera(struct Camera *c) {
     }
 #endif
     gLakituState.lastFrameAction = sMarioCamState->action;
+    PROFILER_SCOPE_END();
     profiler_update(PROFILER_TIME_CAMERA, profiler_get_delta(PROFILER_DELTA_COLLISION) - first);
 }
 
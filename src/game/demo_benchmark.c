@@ -0,0 +1,286 @@
+#include <ultra64.h>
+
+#include "sm64.h"
+#include "config.h"
+
+#ifdef ENABLE_DEMO_BENCHMARK
+
+#include "area.h"
+#include "demo_benchmark.h"
+#include "emutest.h"
+#include "engine/math_util.h"
+#include "fasttext.h"
+#include "game_init.h"
+#include "level_table.h"
+#include "level_update.h"
+#include "memory.h"
+#include "profiling.h"
+#include "save_file.h"
+#include "usb/debug.h"
+
+/**
+ * @file demo_benchmark.c
+ * Plays the demos of DEMO_BENCHMARK_LEVELS one after another in place of the intro, records the times
+ * of every frame they're played for, and reports the min/avg/p99/max of each level once they're done.
+ */
+
+// Frames that can be recorded for one level, over all of its runs
+#define DEMO_BENCHMARK_MAX_FRAMES 8192
+
+enum DemoBenchmarkTime {
+    BENCHMARK_TIME_FRAME,
+    BENCHMARK_TIME_CPU,
+    BENCHMARK_TIME_RSP,
+    BENCHMARK_TIME_RDP,
+    BENCHMARK_TIME_COUNT,
+};
+
+struct DemoBenchmarkStats {
+    u16 min;
+    u16 avg;
+    u16 p99;
+    u16 max;
+};
+
+struct DemoBenchmarkResult {
+    u16 numFrames;
+    u8 foundDemo;
+    u8 failedTimes; // A bit for each time whose p99 is above its threshold
+    struct DemoBenchmarkStats stats[BENCHMARK_TIME_COUNT];
+};
+
+static const s16 sBenchmarkLevels[] = { DEMO_BENCHMARK_LEVELS };
+#define NUM_BENCHMARK_LEVELS ARRAY_COUNT(sBenchmarkLevels)
+#define NUM_BENCHMARK_DEMOS  (NUM_BENCHMARK_LEVELS * DEMO_BENCHMARK_RUNS)
+
+static const u16 sBenchmarkThresholds[BENCHMARK_TIME_COUNT] = {
+    DEMO_BENCHMARK_MAX_FRAME_P99,
+    DEMO_BENCHMARK_MAX_CPU_P99,
+    DEMO_BENCHMARK_MAX_RSP_P99,
+    DEMO_BENCHMARK_MAX_RDP_P99,
+};
+
+#if defined(UNF) || defined(DEBUG)
+static const char *sBenchmarkTimeNames[BENCHMARK_TIME_COUNT] = { "frame", "cpu", "rsp", "rdp" };
+
+#define STUB_LEVEL(_0, _1, _2, _3, _4, _5, _6, _7, _8) "",
+#define DEFINE_LEVEL(_0, _1, _2, folder, _4, _5, _6, _7, _8, _9, _10) #folder,
+
+static const char *sLevelFolderNames[] = {
+    #include "levels/level_defines.h"
+};
+
+#undef STUB_LEVEL
+#undef DEFINE_LEVEL
+#endif
+
+static u16 sFrameTimes[BENCHMARK_TIME_COUNT][DEMO_BENCHMARK_MAX_FRAMES];
+static u32 sNumFrames = 0;
+static struct DemoBenchmarkResult sResults[NUM_BENCHMARK_LEVELS];
+// The run being played out of every run of every level, -1 before the first one
+static s32 sCurrentDemo = -1;
+static u8 sDemoPlaying = FALSE;
+static u8 sFinished = FALSE;
+
+static void sort_frame_times(u16 *times, u32 count) {
+    // Shell sort, as the buffers are too big to sort by insertion at the end of each level.
+    for (u32 gap = count / 2; gap > 0; gap /= 2) {
+        for (u32 i = gap; i < count; i++) {
+            u16 time = times[i];
+            u32 j = i;
+            for (; j >= gap && times[j - gap] > time; j -= gap) {
+                times[j] = times[j - gap];
+            }
+            times[j] = time;
+        }
+    }
+}
+
+/**
+ * Works out the stats of the frames recorded for a level and clears them for the next one.
+ */
+static void finish_level(struct DemoBenchmarkResult *result) {
+    result->numFrames = sNumFrames;
+
+    if (sNumFrames > 0) {
+        for (s32 i = 0; i < BENCHMARK_TIME_COUNT; i++) {
+            struct DemoBenchmarkStats *stats = &result->stats[i];
+            u16 *times = sFrameTimes[i];
+            u32 sum = 0;
+
+            sort_frame_times(times, sNumFrames);
+            for (u32 j = 0; j < sNumFrames; j++) {
+                sum += times[j];
+            }
+
+            stats->min = times[0];
+            stats->avg = sum / sNumFrames;
+            stats->p99 = times[MIN(sNumFrames - 1, sNumFrames * 99 / 100)];
+            stats->max = times[sNumFrames - 1];
+
+            if (sBenchmarkThresholds[i] != 0 && stats->p99 > sBenchmarkThresholds[i]) {
+                result->failedTimes |= (1 << i);
+            }
+        }
+    }
+
+    sNumFrames = 0;
+}
+
+static s32 level_passed(struct DemoBenchmarkResult *result) {
+    return (result->foundDemo && result->numFrames > 0 && result->failedTimes == 0);
+}
+
+static void report_results(void) {
+#if defined(UNF) || defined(DEBUG)
+    u32 numPassed = 0;
+
+    osSyncPrintf("demo_benchmark: emulator 0x%X, %d runs per level\n", gEmulator, DEMO_BENCHMARK_RUNS);
+    osSyncPrintf("level,frames");
+    for (s32 i = 0; i < BENCHMARK_TIME_COUNT; i++) {
+        const char *name = sBenchmarkTimeNames[i];
+        osSyncPrintf(",%s_min,%s_avg,%s_p99,%s_max", name, name, name, name);
+    }
+    osSyncPrintf(",result\n");
+
+    for (u32 i = 0; i < NUM_BENCHMARK_LEVELS; i++) {
+        struct DemoBenchmarkResult *result = &sResults[i];
+
+        osSyncPrintf("%s,%d", sLevelFolderNames[sBenchmarkLevels[i] - 1], result->numFrames);
+        for (s32 j = 0; j < BENCHMARK_TIME_COUNT; j++) {
+            struct DemoBenchmarkStats *stats = &result->stats[j];
+            osSyncPrintf(",%d,%d,%d,%d", stats->min, stats->avg, stats->p99, stats->max);
+        }
+
+        if (!result->foundDemo) {
+            osSyncPrintf(",NO_DEMO\n");
+        } else if (level_passed(result)) {
+            osSyncPrintf(",PASS\n");
+            numPassed++;
+        } else {
+            osSyncPrintf(",FAIL\n");
+        }
+    }
+
+    osSyncPrintf("demo_benchmark: %s (%d/%d levels)\n", (numPassed == NUM_BENCHMARK_LEVELS) ? "PASS" : "FAIL",
+                 numPassed, NUM_BENCHMARK_LEVELS);
+#endif
+}
+
+/**
+ * Loads the demo recorded in the given level. The demos are always loaded again, even if it's the
+ * one that was loaded last, as playing a demo counts its timers down in place.
+ */
+static s32 load_level_demo(s32 levelNum) {
+    for (u32 i = 0; i < gDemoInputsBuf.dmaTable->count; i++) {
+        gDemoInputsBuf.currentAddr = NULL;
+        load_patchable_table(&gDemoInputsBuf, i);
+
+        // The first input's timer is the level the demo was recorded in.
+        struct DemoInput *demo = gDemoInputsBuf.bufTarget;
+        if ((s8) demo->timer == levelNum) {
+            gCurrDemoInput = demo + 1;
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+/**
+ * Called by the intro in place of the title screen. Finishes the demo that was just played and
+ * starts the next one, returning its level, or LEVEL_NONE after the last one to stay on a black screen.
+ */
+s32 demo_benchmark_next_level(void) {
+    gCurrDemoInput = NULL;
+
+    if (sFinished) {
+        return LEVEL_NONE;
+    }
+
+    if (sDemoPlaying) {
+        sDemoPlaying = FALSE;
+        if ((sCurrentDemo + 1) % DEMO_BENCHMARK_RUNS == 0) {
+            finish_level(&sResults[sCurrentDemo / DEMO_BENCHMARK_RUNS]);
+        }
+    }
+
+    while (++sCurrentDemo < (s32) NUM_BENCHMARK_DEMOS) {
+        s32 levelNum = sBenchmarkLevels[sCurrentDemo / DEMO_BENCHMARK_RUNS];
+
+        if (load_level_demo(levelNum)) {
+            sResults[sCurrentDemo / DEMO_BENCHMARK_RUNS].foundDemo = TRUE;
+            sDemoPlaying = TRUE;
+            gCurrSaveFileNum = 1;
+            gCurrActNum = 1;
+            random_set_seed(0);
+            return levelNum;
+        }
+    }
+
+    sFinished = TRUE;
+    report_results();
+    return LEVEL_NONE;
+}
+
+/**
+ * Records the times of the frame that was just completed. Called before profiler_frame_setup starts
+ * the next one. Loading and the transitions in and out of the level are left out.
+ */
+void demo_benchmark_record_frame(void) {
+    ProfilerFrameTimes times;
+
+    if (!sDemoPlaying || gCurrDemoInput == NULL || gCurrentArea == NULL || gWarpTransition.isActive
+        || sNumFrames >= DEMO_BENCHMARK_MAX_FRAMES) {
+        return;
+    }
+
+    profiler_get_frame_microseconds(&times);
+    sFrameTimes[BENCHMARK_TIME_FRAME][sNumFrames] = MIN(times.frame, 0xFFFF);
+    sFrameTimes[BENCHMARK_TIME_CPU][sNumFrames] = MIN(times.cpu, 0xFFFF);
+    sFrameTimes[BENCHMARK_TIME_RSP][sNumFrames] = MIN(times.rsp, 0xFFFF);
+    sFrameTimes[BENCHMARK_TIME_RDP][sNumFrames] = MIN(times.rdp, 0xFFFF);
+    sNumFrames++;
+}
+
+/**
+ * Shows the averages and p99s of every level once the benchmark is finished.
+ */
+void demo_benchmark_print_results(void) {
+    char text_buffer[64];
+    u32 numPassed = 0;
+
+    if (!sFinished) {
+        return;
+    }
+
+    Gfx* dlHead = gDisplayListHead;
+    gDPPipeSync(dlHead++);
+    gDPSetCycleType(dlHead++, G_CYC_1CYCLE);
+    gDPSetRenderMode(dlHead++, G_RM_TEX_EDGE, G_RM_TEX_EDGE2);
+    gDPSetTexturePersp(dlHead++, G_TP_NONE);
+    gDPSetTextureFilter(dlHead++, G_TF_POINT);
+    gDPSetTextureLUT(dlHead++, G_TT_NONE);
+
+    drawSmallStringCol(&dlHead, 10, 8, "Level\tFrame avg/p99\tCPU\t\tRSP\t\tRDP", 255, 255, 255);
+    for (u32 i = 0; i < NUM_BENCHMARK_LEVELS; i++) {
+        struct DemoBenchmarkResult *result = &sResults[i];
+        struct DemoBenchmarkStats *stats = result->stats;
+        s32 passed = level_passed(result);
+
+        sprintf(text_buffer, "%d\t\t%d/%d\t%d/%d\t%d/%d\t%d/%d", sBenchmarkLevels[i],
+            stats[BENCHMARK_TIME_FRAME].avg, stats[BENCHMARK_TIME_FRAME].p99,
+            stats[BENCHMARK_TIME_CPU].avg, stats[BENCHMARK_TIME_CPU].p99,
+            stats[BENCHMARK_TIME_RSP].avg, stats[BENCHMARK_TIME_RSP].p99,
+            stats[BENCHMARK_TIME_RDP].avg, stats[BENCHMARK_TIME_RDP].p99);
+        drawSmallStringCol(&dlHead, 10, 20 + i * 10, text_buffer, passed ? 128 : 255, passed ? 255 : 96, passed ? 128 : 96);
+        numPassed += passed;
+    }
+
+    sprintf(text_buffer, "%s (%d/%d levels)", (numPassed == NUM_BENCHMARK_LEVELS) ? "PASS" : "FAIL",
+            numPassed, NUM_BENCHMARK_LEVELS);
+    drawSmallStringCol(&dlHead, 10, 30 + NUM_BENCHMARK_LEVELS * 10, text_buffer, 255, 255, 255);
+    gDisplayListHead = dlHead;
+}
+
+#endif // ENABLE_DEMO_BENCHMARK
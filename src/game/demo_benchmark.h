@@ -0,0 +1,14 @@
+#ifndef DEMO_BENCHMARK_H
+#define DEMO_BENCHMARK_H
+
+#include <PR/ultratypes.h>
+
+#include "config.h"
+
+#ifdef ENABLE_DEMO_BENCHMARK
+s32 demo_benchmark_next_level(void);
+void demo_benchmark_record_frame(void);
+void demo_benchmark_print_results(void);
+#endif
+
+#endif // DEMO_BENCHMARK_H
@@ -9,6 +9,7 @@
 #include "buffers/zbuffer.h"
 #include "engine/level_script.h"
 #include "engine/math_util.h"
+#include "engine/surface_load.h"
 #include "game_init.h"
 #include "main.h"
 #include "memory.h"
@@ -31,6 +32,7 @@
 #include "vc_ultra.h"
 #include "profiling.h"
 #include "emutest.h"
+#include "demo_benchmark.h"
 
 // Emulators that the Instant Input patch should not be applied to
 #define INSTANT_INPUT_BLACKLIST (EMU_CONSOLE | EMU_WIIVC | EMU_ARES | EMU_SIMPLE64 | EMU_CEN64)
@@ -40,6 +42,7 @@ struct SPTask *gGfxSPTask;
 Gfx *gDisplayListHead;
 u8 *gGfxPoolEnd;
 struct GfxPool *gGfxPool;
+struct GfxPoolStats gGfxPoolStats = { .size = GFX_POOL_SIZE * sizeof(Gfx) };
 
 // OS Controllers
 struct Controller gControllers[MAXCONTROLLERS];
@@ -344,7 +347,7 @@ void create_gfx_task_structure(void) {
     gGfxSPTask->task.t.output_buff = gGfxSPTaskOutputBuffer;
     gGfxSPTask->task.t.output_buff_size =
         (u64 *)((u8 *) gGfxSPTaskOutputBuffer + sizeof(gGfxSPTaskOutputBuffer));
-    gGfxSPTask->task.t.data_ptr = (u64 *) &gGfxPool->buffer;
+    gGfxSPTask->task.t.data_ptr = (u64 *) gGfxPool->buffer;
     gGfxSPTask->task.t.data_size = entries * sizeof(Gfx);
     gGfxSPTask->task.t.yield_data_ptr = (u64 *) gGfxSPTaskYieldBuffer;
     gGfxSPTask->task.t.yield_data_size = OS_YIELD_DATA_SIZE;
@@ -361,6 +364,92 @@ void init_rcp(s32 resetZB) {
     select_framebuffer();
 }
 
+// How full a frame can get the gfx pool, in percent, before it's logged as getting close to overflowing
+#define GFX_POOL_WARNING_PERCENT 90
+
+#ifdef DYNAMIC_GFX_POOL
+// The gfx pools grow when a frame uses more than GFX_POOL_GROW_PERCENT of them, and shrink when no frame
+// has used more than GFX_POOL_SHRINK_PERCENT for GFX_POOL_SHRINK_FRAMES frames. Either way, the new
+// size is twice what was used, so that it takes a big change in usage to resize them again.
+#define GFX_POOL_GROW_PERCENT   75
+#define GFX_POOL_SHRINK_PERCENT 40
+#define GFX_POOL_SHRINK_FRAMES  300
+
+static u8 *sGfxPoolsBlock = NULL;
+static u32 sGfxPoolTargetSize = GFX_POOL_SIZE * sizeof(Gfx);
+static u32 sGfxPoolShrinkPeak = 0;
+static u32 sGfxPoolShrinkTimer = 0;
+// Set when select_gfx_pool has already waited for the last frame's task, so display_and_vsync doesn't again
+static u8 sGfxTaskFinished = FALSE;
+// Set when there wasn't enough memory to grow the gfx pools, so they don't try again until the next level
+static u8 sGfxPoolGrowFailed = FALSE;
+#endif
+static u8 sGfxPoolWarned = FALSE;
+static u16 sFrameStartFailedAllocs = 0;
+
+/**
+ * Clear the gfx pool usage stats. Called when a level is loaded.
+ */
+void clear_gfx_pool_stats(void) {
+    gGfxPoolStats.peakUsed = 0;
+    gGfxPoolStats.numOverflows = 0;
+    gGfxPoolStats.numFailedAllocs = 0;
+    sGfxPoolWarned = FALSE;
+#ifdef DYNAMIC_GFX_POOL
+    sGfxPoolGrowFailed = FALSE;
+#endif
+}
+
+/**
+ * Record how much of the gfx pool the finished frame used, and log it the first time a frame gets close
+ * to or past running out of room. With DYNAMIC_GFX_POOL, also decide what size the pools should be next frame.
+ */
+static void update_gfx_pool_stats(void) {
+    s32 allocsFailed = (gGfxPoolStats.numFailedAllocs != sFrameStartFailedAllocs);
+    u32 listSize = (u8 *) gDisplayListHead - (u8 *) gGfxPool->buffer;
+    u32 allocSize = ((u8 *) gGfxPool->buffer + gGfxPoolStats.size) - gGfxPoolEnd;
+    u32 used = listSize + allocSize;
+
+    gGfxPoolStats.used = used;
+    if (used > gGfxPoolStats.peakUsed) {
+        gGfxPoolStats.peakUsed = used;
+    }
+
+    if (used > gGfxPoolStats.size || allocsFailed) {
+        gGfxPoolStats.numOverflows++;
+        append_puppyprint_log("Gfx pool overflowed! %d / %d bytes", used, gGfxPoolStats.size);
+    } else if (!sGfxPoolWarned && used > gGfxPoolStats.size / 100 * GFX_POOL_WARNING_PERCENT) {
+        sGfxPoolWarned = TRUE;
+        append_puppyprint_log("Gfx pool nearly full: %d / %d bytes", used, gGfxPoolStats.size);
+    }
+
+#ifdef DYNAMIC_GFX_POOL
+    if (used > gGfxPoolStats.size / 100 * GFX_POOL_GROW_PERCENT || allocsFailed) {
+        if (sGfxPoolGrowFailed) {
+            return;
+        }
+        // The failed allocations aren't part of what was used, so make sure it grows by at least half.
+        sGfxPoolTargetSize = MAX(used * 2, gGfxPoolStats.size + gGfxPoolStats.size / 2);
+        sGfxPoolShrinkPeak = 0;
+        sGfxPoolShrinkTimer = 0;
+    } else if (gGfxPoolStats.size > GFX_POOL_SIZE * sizeof(Gfx)) {
+        if (used > sGfxPoolShrinkPeak) {
+            sGfxPoolShrinkPeak = used;
+        }
+
+        if (sGfxPoolShrinkPeak > gGfxPoolStats.size / 100 * GFX_POOL_SHRINK_PERCENT) {
+            sGfxPoolShrinkPeak = 0;
+            sGfxPoolShrinkTimer = 0;
+        } else if (++sGfxPoolShrinkTimer >= GFX_POOL_SHRINK_FRAMES) {
+            sGfxPoolTargetSize = MAX(sGfxPoolShrinkPeak * 2, GFX_POOL_SIZE * sizeof(Gfx));
+            sGfxPoolShrinkPeak = 0;
+            sGfxPoolShrinkTimer = 0;
+        }
+    }
+    sGfxPoolTargetSize = ALIGN(sGfxPoolTargetSize, 0x400);
+#endif
+}
+
 /**
  * End the master display list and initialize the graphics task structure for the next frame to be rendered.
  */
@@ -371,6 +460,7 @@ void end_master_display_list(void) {
     gSPEndDisplayList(gDisplayListHead++);
 
     create_gfx_task_structure();
+    update_gfx_pool_stats();
 }
 
 /**
@@ -415,7 +505,7 @@ void render_init(void) {
     set_segment_base_addr(SEGMENT_RENDER, gGfxPool->buffer);
     gGfxSPTask = &gGfxPool->spTask;
     gDisplayListHead = gGfxPool->buffer;
-    gGfxPoolEnd = (u8 *)(gGfxPool->buffer + GFX_POOL_SIZE);
+    gGfxPoolEnd = (u8 *) gGfxPool->buffer + gGfxPoolStats.size;
     init_rcp(CLEAR_ZBUFFER);
     clear_framebuffer(0);
     end_master_display_list();
@@ -430,15 +520,55 @@ void render_init(void) {
     gGlobalTimer++;
 }
 
+#ifdef DYNAMIC_GFX_POOL
+/**
+ * Point the gfx pools at the two halves of the block allocated for them.
+ */
+static void set_gfx_pool_buffers(u32 size) {
+    gGfxPools[0].buffer = (Gfx *) sGfxPoolsBlock;
+    gGfxPools[1].buffer = (Gfx *) (sGfxPoolsBlock + size);
+    gGfxPoolStats.size = size;
+}
+
+/**
+ * Resize the gfx pools to the size update_gfx_pool_stats decided on. Both of them are moved, so this first
+ * waits for the last frame's task to finish with the other one. Keeps the old size if the main pool is too full.
+ */
+static void resize_gfx_pools(void) {
+    u8 *block;
+
+    osRecvMesg(&gGfxVblankQueue, &gMainReceivedMesg, OS_MESG_BLOCK);
+    sGfxTaskFinished = TRUE;
+
+    block = main_pool_resize_first_right(sGfxPoolsBlock, sGfxPoolTargetSize * 2);
+    if (block == NULL) {
+        append_puppyprint_log("Not enough memory to grow the gfx pools to %d bytes", sGfxPoolTargetSize);
+        sGfxPoolTargetSize = gGfxPoolStats.size;
+        sGfxPoolGrowFailed = TRUE;
+        return;
+    }
+
+    sGfxPoolsBlock = block;
+    set_gfx_pool_buffers(sGfxPoolTargetSize);
+    gGfxPoolStats.numResizes++;
+}
+#endif
+
 /**
  * Selects the location of the F3D output buffer (gDisplayListHead).
  */
 void select_gfx_pool(void) {
+#ifdef DYNAMIC_GFX_POOL
+    if (sGfxPoolTargetSize != gGfxPoolStats.size) {
+        resize_gfx_pools();
+    }
+#endif
     gGfxPool = &gGfxPools[gGlobalTimer % ARRAY_COUNT(gGfxPools)];
     set_segment_base_addr(SEGMENT_RENDER, gGfxPool->buffer);
     gGfxSPTask = &gGfxPool->spTask;
     gDisplayListHead = gGfxPool->buffer;
-    gGfxPoolEnd = (u8 *) (gGfxPool->buffer + GFX_POOL_SIZE);
+    gGfxPoolEnd = (u8 *) gGfxPool->buffer + gGfxPoolStats.size;
+    sFrameStartFailedAllocs = gGfxPoolStats.numFailedAllocs;
 }
 
 /**
@@ -449,7 +579,14 @@ void select_gfx_pool(void) {
  * - Selects which framebuffer will be rendered and displayed to next time.
  */
 void display_and_vsync(void) {
+#ifdef DYNAMIC_GFX_POOL
+    if (!sGfxTaskFinished) {
+        osRecvMesg(&gGfxVblankQueue, &gMainReceivedMesg, OS_MESG_BLOCK);
+    }
+    sGfxTaskFinished = FALSE;
+#else
     osRecvMesg(&gGfxVblankQueue, &gMainReceivedMesg, OS_MESG_BLOCK);
+#endif
     if (gGoddardVblankCallback != NULL) {
         gGoddardVblankCallback();
         gGoddardVblankCallback = NULL;
@@ -474,7 +611,7 @@ void display_and_vsync(void) {
     gGlobalTimer++;
 }
 
-#if !defined(DISABLE_DEMO) && defined(KEEP_MARIO_HEAD)
+#ifndef DISABLE_DEMO
 // this function records distinct inputs over a 255-frame interval to RAM locations and was likely
 // used to record the demo sequences seen in the final game. This function is unused.
 UNUSED static void record_demo(void) {
@@ -607,7 +744,7 @@ void read_controller_inputs(s32 threadID) {
         release_rumble_pak_control();
 #endif
     }
-#if !defined(DISABLE_DEMO) && defined(KEEP_MARIO_HEAD)
+#ifndef DISABLE_DEMO
     run_demo_inputs();
 #endif
 
@@ -735,6 +872,11 @@ void setup_game_memory(void) {
     // Create Mesg Queues
     osCreateMesgQueue(&gGfxVblankQueue, gGfxMesgBuf, ARRAY_COUNT(gGfxMesgBuf));
     osCreateMesgQueue(&gGameVblankQueue, gGameMesgBuf, ARRAY_COUNT(gGameMesgBuf));
+#ifdef DYNAMIC_GFX_POOL
+    // Setup the gfx pools. They're allocated first from the right side of the main pool so they can be resized.
+    sGfxPoolsBlock = main_pool_alloc(GFX_POOL_SIZE * sizeof(Gfx) * 2, MEMORY_POOL_RIGHT);
+    set_gfx_pool_buffers(GFX_POOL_SIZE * sizeof(Gfx));
+#endif
     // Setup z buffer and framebuffer
     gPhysicalZBuffer = VIRTUAL_TO_PHYSICAL(gZBuffer);
     gPhysicalFramebuffers[0] = VIRTUAL_TO_PHYSICAL(gFramebuffer0);
@@ -752,6 +894,10 @@ void setup_game_memory(void) {
     gDemoInputsMemAlloc = main_pool_alloc(DEMO_INPUTS_POOL_SIZE, MEMORY_POOL_LEFT);
     set_segment_base_addr(SEGMENT_DEMO_INPUTS, (void *) gDemoInputsMemAlloc);
     setup_dma_table_list(&gDemoInputsBuf, gDemoInputs, gDemoInputsMemAlloc);
+#ifdef BAKED_STATIC_COLLISION
+    // Load the table of baked collision partitions
+    load_baked_collision_table();
+#endif
     // Setup Level Script Entry
     load_segment(SEGMENT_LEVEL_ENTRY, _entrySegmentRomStart, _entrySegmentRomEnd, MEMORY_POOL_LEFT, NULL, NULL);
     // Setup Segment 2 (Fonts, Text, etc)
@@ -806,6 +952,9 @@ void thread5_game_loop(UNUSED void *arg) {
     render_init();
 
     while (TRUE) {
+#ifdef ENABLE_DEMO_BENCHMARK
+        demo_benchmark_record_frame();
+#endif
         profiler_frame_setup();
         // If the reset timer is active, run the process to reset the game.
         if (gResetTimer != 0) {
@@ -829,7 +978,9 @@ void thread5_game_loop(UNUSED void *arg) {
         read_controller_inputs(THREAD_5_GAME_LOOP);
         profiler_update(PROFILER_TIME_CONTROLLERS, 0);
         profiler_collision_reset();
+        PROFILER_SCOPE_BEGIN("Level script");
         addr = level_script_execute(addr);
+        PROFILER_SCOPE_END();
         profiler_collision_completed();
 #if !defined(PUPPYPRINT_DEBUG) && defined(VISUAL_DEBUG)
         debug_box_input();
@@ -838,7 +989,9 @@ void thread5_game_loop(UNUSED void *arg) {
         puppyprint_profiler_process();
 #endif
 
+        PROFILER_SCOPE_BEGIN("Display and vsync");
         display_and_vsync();
+        PROFILER_SCOPE_END();
 #ifdef VANILLA_DEBUG
         // when debug info is enabled, print the "BUF %d" information.
         if (gShowDebugText) {
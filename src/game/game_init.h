@@ -14,10 +14,29 @@
 #define DEMO_INPUTS_POOL_SIZE 0x800
 
 struct GfxPool {
+#ifdef DYNAMIC_GFX_POOL
+    Gfx *buffer; // Half of a block allocated from the main pool, see resize_gfx_pools
+#else
     Gfx buffer[GFX_POOL_SIZE];
+#endif
     struct SPTask spTask;
 };
 
+/**
+ * How full the gfx pools get, for tuning GFX_POOL_SIZE. The display list and the allocations from
+ * alloc_display_list both count towards it. Cleared when a level is loaded, so the peaks are for the current level.
+ */
+struct GfxPoolStats {
+    u32 size;            // The size of each of the two gfx pools in bytes
+    u32 used;            // The bytes used by the last frame
+    u32 peakUsed;
+    u16 numOverflows;    // Frames that ran out of room, which can crash or draw garbage
+    u16 numFailedAllocs; // Allocations from alloc_display_list that didn't fit, which return NULL
+#ifdef DYNAMIC_GFX_POOL
+    u16 numResizes;
+#endif
+};
+
 struct DemoInput {
     u8 timer; // time until next input. if this value is 0, it means the demo is over
     s8 rawStickX;
@@ -46,6 +65,7 @@ extern struct SPTask *gGfxSPTask;
 extern Gfx *gDisplayListHead;
 extern u8 *gGfxPoolEnd;
 extern struct GfxPool *gGfxPool;
+extern struct GfxPoolStats gGfxPoolStats;
 extern u8 gControllerBits;
 extern u8 gBorderHeight;
 #ifdef VANILLA_STYLE_CUSTOM_DEBUG
@@ -89,6 +109,7 @@ void init_rcp(s32 resetZB);
 void end_master_display_list(void);
 void render_init(void);
 void select_gfx_pool(void);
+void clear_gfx_pool_stats(void);
 void display_and_vsync(void);
 
 #endif // GAME_INIT_H
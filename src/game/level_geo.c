@@ -33,12 +33,8 @@ Gfx *geo_envfx_main(s32 callContext, struct GraphNode *node, Mat4 mtxf) {
             vec3f_to_vec3s(marioPos, gPlayerCameraState->pos);
             particleList = envfx_update_particles(snowMode, marioPos, camTo, camFrom);
             if (particleList != NULL) {
-                Mtx *mtx = alloc_display_list(sizeof(*mtx));
-
-                gfx = alloc_display_list(2 * sizeof(*gfx));
-                mtxf_to_mtx(mtx, mtxf);
-                gSPMatrix(&gfx[0], VIRTUAL_TO_PHYSICAL(mtx), G_MTX_MODELVIEW | G_MTX_LOAD | G_MTX_NOPUSH);
-                gSPBranchList(&gfx[1], VIRTUAL_TO_PHYSICAL(particleList));
+                // The master list already loads mtxf as the matrix for this node's display list.
+                gfx = particleList;
                 SET_GRAPH_NODE_LAYER(execNode->fnNode.node.flags, LAYER_OCCLUDE_SILHOUETTE_ALPHA);
             }
             SET_HIGH_U16_OF_32(*params, gAreaUpdateCounter);
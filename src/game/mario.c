@@ -32,6 +32,7 @@
 #include "save_file.h"
 #include "sound_init.h"
 #include "rumble_init.h"
+#include "profiling.h"
 
 
 /**************************************************
@@ -66,6 +67,7 @@ s16 set_mario_animation(struct MarioState *m, s32 targetAnimID) {
     if (load_patchable_table(m->animList, targetAnimID)) {
         targetAnim->values = (void *) VIRTUAL_TO_PHYSICAL((u8 *) targetAnim + (uintptr_t) targetAnim->values);
         targetAnim->index  = (void *) VIRTUAL_TO_PHYSICAL((u8 *) targetAnim + (uintptr_t) targetAnim->index);
+        invalidate_decoded_animation(targetAnim);
     }
 
     if (marioObj->header.gfx.animInfo.animID != targetAnimID) {
@@ -99,6 +101,7 @@ s16 set_mario_anim_with_accel(struct MarioState *m, s32 targetAnimID, s32 accel)
     if (load_patchable_table(m->animList, targetAnimID)) {
         targetAnim->values = (void *) VIRTUAL_TO_PHYSICAL((u8 *) targetAnim + (uintptr_t) targetAnim->values);
         targetAnim->index = (void *) VIRTUAL_TO_PHYSICAL((u8 *) targetAnim + (uintptr_t) targetAnim->index);
+        invalidate_decoded_animation(targetAnim);
     }
 
     if (marioObj->header.gfx.animInfo.animID != targetAnimID) {
@@ -182,8 +185,10 @@ s16 find_mario_anim_flags_and_translation(struct Object *obj, s32 yaw, Vec3s tra
 
     struct Animation *curAnim = (void *) obj->header.gfx.animInfo.curAnim;
     s16 animFrame = geo_update_animation_frame(&obj->header.gfx.animInfo, NULL);
-    u16 *animIndex = segmented_to_virtual((void *) curAnim->index);
-    s16 *animValues = segmented_to_virtual((void *) curAnim->values);
+    u16 *animIndex;
+    s16 *animValues;
+
+    animFrame = get_animation_frame_tables(curAnim, animFrame, &animIndex, &animValues);
 
     f32 s = (f32) sins(yaw);
     f32 c = (f32) coss(yaw);
@@ -1699,6 +1704,20 @@ void queue_rumble_particles(struct MarioState *m) {
 }
 #endif
 
+#ifdef PROFILER_SCOPES
+// Scope names for each action group, so that the time taken by each group's actions is shown separately.
+static const char *sActionGroupScopeNames[] = {
+    "Stationary actions",
+    "Moving actions",
+    "Airborne actions",
+    "Submerged actions",
+    "Cutscene actions",
+    "Automatic actions",
+    "Object actions",
+    "Custom actions",
+};
+#endif
+
 /**
  * Main function for executing Mario's behavior. Returns particleFlags.
  */
@@ -1730,8 +1749,11 @@ s32 execute_mario_action(UNUSED struct Object *obj) {
 #endif
 
         gMarioState->marioObj->header.gfx.node.flags &= ~GRAPH_RENDER_INVISIBLE;
+        PROFILER_SCOPE_BEGIN("Mario");
         mario_reset_bodystate(gMarioState);
+        PROFILER_SCOPE_BEGIN("Inputs");
         update_mario_inputs(gMarioState);
+        PROFILER_SCOPE_END();
 
 #ifdef PUPPYCAM
         if (!(gPuppyCam.flags & PUPPYCAM_BEHAVIOUR_FREE)) {
@@ -1740,10 +1762,13 @@ s32 execute_mario_action(UNUSED struct Object *obj) {
 #ifdef PUPPYCAM
         }
 #endif
+        PROFILER_SCOPE_BEGIN("Interactions");
         mario_process_interactions(gMarioState);
+        PROFILER_SCOPE_END();
 
         // If Mario is OOB, stop executing actions.
         if (gMarioState->floor == NULL) {
+            PROFILER_SCOPE_END();
             return ACTIVE_PARTICLE_NONE;
         }
 
@@ -1751,6 +1776,7 @@ s32 execute_mario_action(UNUSED struct Object *obj) {
         // which can lead to unexpected sub-frame behavior. Could potentially hang
         // if a loop of actions were found, but there has not been a situation found.
         while (inLoop) {
+            PROFILER_SCOPE_BEGIN(sActionGroupScopeNames[(gMarioState->action & ACT_GROUP_MASK) >> 6]);
             switch (gMarioState->action & ACT_GROUP_MASK) {
                 case ACT_GROUP_STATIONARY: inLoop = mario_execute_stationary_action(gMarioState); break;
                 case ACT_GROUP_MOVING:     inLoop = mario_execute_moving_action(gMarioState);     break;
@@ -1760,6 +1786,7 @@ s32 execute_mario_action(UNUSED struct Object *obj) {
                 case ACT_GROUP_AUTOMATIC:  inLoop = mario_execute_automatic_action(gMarioState);  break;
                 case ACT_GROUP_OBJECT:     inLoop = mario_execute_object_action(gMarioState);     break;
             }
+            PROFILER_SCOPE_END();
         }
 
         sink_mario_in_quicksand(gMarioState);
@@ -1798,6 +1825,7 @@ s32 execute_mario_action(UNUSED struct Object *obj) {
         queue_rumble_particles(gMarioState);
 #endif
 
+        PROFILER_SCOPE_END();
         return gMarioState->particleFlags;
     }
 
@@ -52,10 +52,14 @@ void main_pool_init(void *start, void *end);
 void *main_pool_alloc(u32 size, u32 side);
 u32 main_pool_free(void *addr);
 void *main_pool_realloc(void *addr, u32 size);
+void *main_pool_resize_first_right(void *addr, u32 size);
 u32 main_pool_available(void);
 u32 main_pool_push_state(void);
 u32 main_pool_pop_state(void);
 
+void dma_read(u8 *dest, u8 *srcStart, u8 *srcEnd);
+void *dynamic_dma_read(u8 *srcStart, u8 *srcEnd, u32 side, u32 alignment, u32 bssLength);
+
 #ifndef NO_SEGMENTED_MEMORY
 void *load_segment(s32 segment, u8 *srcStart, u8 *srcEnd, u32 side, u8 *bssStart, u8 *bssEnd);
 void *load_to_fixed_pool_addr(u8 *destAddr, u8 *srcStart, u8 *srcEnd);
@@ -43,6 +43,7 @@
 #include "platform_displacement.h"
 #include "rendering_graph_node.h"
 #include "save_file.h"
+#include "spawn_object.h"
 #include "seq_ids.h"
 #include "spawn_sound.h"
 
@@ -22,30 +22,45 @@ UNUSED struct Object *debug_print_obj_collision(struct Object *a) {
     return NULL;
 }
 
-s32 detect_object_hitbox_overlap(struct Object *a, struct Object *b) {
-    f32 dya_bottom = a->oPosY - a->hitboxDownOffset;
-    f32 dyb_bottom = b->oPosY - b->hitboxDownOffset;
-    f32 dx = a->oPosX - b->oPosX;
-    f32 dz = a->oPosZ - b->oPosZ;
+/**
+ * Object collision reads the hot data of each object (see struct ObjectHotData) rather than the objects
+ * themselves, which are only touched once their hitboxes are found to overlap. The hot data is copied
+ * when the collisions from last frame are cleared, along with the slots of the objects in each list.
+ */
+static u16 sCollisionSlots[OBJECT_POOL_CAPACITY];
+static u16 sNumCollisionSlots;
+// Where each list's slots start in sCollisionSlots, and how many there are
+static u16 sCollisionListStart[NUM_OBJ_LISTS];
+static u16 sCollisionListCount[NUM_OBJ_LISTS];
+
+static s32 detect_object_hitbox_overlap(u16 aSlot, u16 bSlot) {
+    struct ObjectHotData *a = &gObjectHotData[aSlot];
+    struct ObjectHotData *b = &gObjectHotData[bSlot];
+    f32 dya_bottom = a->pos[1] - a->hitboxDownOffset;
+    f32 dyb_bottom = b->pos[1] - b->hitboxDownOffset;
+    f32 dx = a->pos[0] - b->pos[0];
+    f32 dz = a->pos[2] - b->pos[2];
     f32 collisionRadius = a->hitboxRadius + b->hitboxRadius;
     f32 distance = sqr(dx) + sqr(dz);
 
     if (sqr(collisionRadius) > distance) {
         f32 dya_top = a->hitboxHeight + dya_bottom;
         f32 dyb_top = b->hitboxHeight + dyb_bottom;
+        struct Object *objA = &gObjectPool[aSlot];
+        struct Object *objB = &gObjectPool[bSlot];
 
         if (dya_bottom > dyb_top
             || dya_top < dyb_bottom
-            || a->numCollidedObjs >= 4
-            || b->numCollidedObjs >= 4) {
+            || objA->numCollidedObjs >= 4
+            || objB->numCollidedObjs >= 4) {
             return FALSE;
         }
-        a->collidedObjs[a->numCollidedObjs] = b;
-        b->collidedObjs[b->numCollidedObjs] = a;
-        a->collidedObjInteractTypes |= b->oInteractType;
-        b->collidedObjInteractTypes |= a->oInteractType;
-        a->numCollidedObjs++;
-        b->numCollidedObjs++;
+        objA->collidedObjs[objA->numCollidedObjs] = objB;
+        objB->collidedObjs[objB->numCollidedObjs] = objA;
+        objA->collidedObjInteractTypes |= objB->oInteractType;
+        objB->collidedObjInteractTypes |= objA->oInteractType;
+        objA->numCollidedObjs++;
+        objB->numCollidedObjs++;
         return TRUE;
     }
 
@@ -80,97 +95,363 @@ s32 detect_object_hurtbox_overlap(struct Object *a, struct Object *b) {
     return FALSE;
 }
 
-void clear_object_collision(struct Object *a) {
-    struct Object *nextObj = (struct Object *) a->header.next;
+/**
+ * Clear the collisions of every object in a list, and copy their hot data.
+ */
+void clear_object_collision(s32 list) {
+    struct Object *listHead = (struct Object *) &gObjectLists[list];
+    struct Object *nextObj = (struct Object *) listHead->header.next;
+
+    sCollisionListStart[list] = sNumCollisionSlots;
+    while (nextObj != listHead) {
+        u16 slot = nextObj - gObjectPool;
+        struct ObjectHotData *hot = &gObjectHotData[slot];
 
-    while (nextObj != a) {
         nextObj->numCollidedObjs = 0;
         nextObj->collidedObjInteractTypes = 0;
         if (nextObj->oIntangibleTimer > 0) {
             nextObj->oIntangibleTimer--;
         }
+
+        vec3f_copy(hot->pos, &nextObj->oPosVec);
+        hot->hitboxRadius = nextObj->hitboxRadius;
+        hot->hitboxHeight = nextObj->hitboxHeight;
+        hot->hitboxDownOffset = nextObj->hitboxDownOffset;
+        hot->hurtboxRadius = nextObj->hurtboxRadius;
+        hot->activeFlags = nextObj->activeFlags;
+        hot->intangible = (nextObj->oIntangibleTimer != 0);
+        hot->objListIndex = list;
+
+        sCollisionSlots[sNumCollisionSlots++] = slot;
         nextObj = (struct Object *) nextObj->header.next;
     }
+    sCollisionListCount[list] = sNumCollisionSlots - sCollisionListStart[list];
 }
 
-void check_collision_in_list(struct Object *a, struct Object *b, struct Object *c) {
-    if (a->oIntangibleTimer == 0) {
-        while (b != c) {
-            if (b->oIntangibleTimer == 0) {
-                if (detect_object_hitbox_overlap(a, b) && b->hurtboxRadius != 0.0f) {
-                    detect_object_hurtbox_overlap(a, b);
+/**
+ * Check a against every object in slots.
+ */
+void check_collision_in_list(u16 aSlot, const u16 *slots, u32 count) {
+    if (!gObjectHotData[aSlot].intangible) {
+        for (u32 i = 0; i < count; i++) {
+            u16 bSlot = slots[i];
+            if (!gObjectHotData[bSlot].intangible) {
+                if (detect_object_hitbox_overlap(aSlot, bSlot) && gObjectHotData[bSlot].hurtboxRadius != 0.0f) {
+                    detect_object_hurtbox_overlap(&gObjectPool[aSlot], &gObjectPool[bSlot]);
                 }
             }
-            b = (struct Object *) b->header.next;
         }
     }
 }
 
+/**
+ * Check the object at index in the first list against the objects after it in the same list, and
+ * against every object in the other lists.
+ */
+static void check_collision_in_lists(u32 index, const u8 *lists, u32 numLists) {
+    const u16 *slots = &sCollisionSlots[sCollisionListStart[lists[0]]];
+
+    check_collision_in_list(slots[index], &slots[index + 1], sCollisionListCount[lists[0]] - index - 1);
+    for (u32 i = 1; i < numLists; i++) {
+        check_collision_in_list(slots[index], &sCollisionSlots[sCollisionListStart[lists[i]]], sCollisionListCount[lists[i]]);
+    }
+}
+
+// Every list that object collision is checked in, with the lists each of them is checked against.
+// The list itself comes first, and only the objects after the one being checked are checked in it.
+static const u8 sPlayerCollisionLists[] = {
+    OBJ_LIST_PLAYER, OBJ_LIST_POLELIKE, OBJ_LIST_LEVEL, OBJ_LIST_GENACTOR,
+    OBJ_LIST_PUSHABLE, OBJ_LIST_SURFACE, OBJ_LIST_DESTRUCTIVE,
+};
+static const u8 sDestructiveCollisionLists[] = {
+    OBJ_LIST_DESTRUCTIVE, OBJ_LIST_GENACTOR, OBJ_LIST_PUSHABLE, OBJ_LIST_SURFACE,
+};
+static const u8 sPushableCollisionLists[] = {
+    OBJ_LIST_PUSHABLE,
+};
+
 void check_player_object_collision(void) {
-    struct Object *playerObj = (struct Object *) &gObjectLists[OBJ_LIST_PLAYER];
-    struct Object   *nextObj = (struct Object *) playerObj->header.next;
-
-    while (nextObj != playerObj) {
-        check_collision_in_list(nextObj, (struct Object *) nextObj->header.next, playerObj);
-        check_collision_in_list(nextObj,
-                      (struct Object *)  gObjectLists[OBJ_LIST_POLELIKE].next,
-                      (struct Object *) &gObjectLists[OBJ_LIST_POLELIKE]);
-        check_collision_in_list(nextObj,
-                      (struct Object *)  gObjectLists[OBJ_LIST_LEVEL].next,
-                      (struct Object *) &gObjectLists[OBJ_LIST_LEVEL]);
-        check_collision_in_list(nextObj,
-                      (struct Object *)  gObjectLists[OBJ_LIST_GENACTOR].next,
-                      (struct Object *) &gObjectLists[OBJ_LIST_GENACTOR]);
-        check_collision_in_list(nextObj,
-                      (struct Object *)  gObjectLists[OBJ_LIST_PUSHABLE].next,
-                      (struct Object *) &gObjectLists[OBJ_LIST_PUSHABLE]);
-        check_collision_in_list(nextObj,
-                      (struct Object *)  gObjectLists[OBJ_LIST_SURFACE].next,
-                      (struct Object *) &gObjectLists[OBJ_LIST_SURFACE]);
-        check_collision_in_list(nextObj,
-                      (struct Object *)  gObjectLists[OBJ_LIST_DESTRUCTIVE].next,
-                      (struct Object *) &gObjectLists[OBJ_LIST_DESTRUCTIVE]);
-        nextObj = (struct Object *) nextObj->header.next;
+    for (u32 i = 0; i < sCollisionListCount[OBJ_LIST_PLAYER]; i++) {
+        check_collision_in_lists(i, sPlayerCollisionLists, ARRAY_COUNT(sPlayerCollisionLists));
     }
 }
 
 void check_pushable_object_collision(void) {
-    struct Object *pushableObj = (struct Object *) &gObjectLists[OBJ_LIST_PUSHABLE];
-    struct Object *nextObj = (struct Object *) pushableObj->header.next;
-
-    while (nextObj != pushableObj) {
-        check_collision_in_list(nextObj, (struct Object *) nextObj->header.next, pushableObj);
-        nextObj = (struct Object *) nextObj->header.next;
+    for (u32 i = 0; i < sCollisionListCount[OBJ_LIST_PUSHABLE]; i++) {
+        check_collision_in_lists(i, sPushableCollisionLists, ARRAY_COUNT(sPushableCollisionLists));
     }
 }
 
 void check_destructive_object_collision(void) {
-    struct Object *destructiveObj = (struct Object *) &gObjectLists[OBJ_LIST_DESTRUCTIVE];
-    struct Object *nextObj = (struct Object *) destructiveObj->header.next;
-
-    while (nextObj != destructiveObj) {
-        if (nextObj->oDistanceToMario < 2000.0f && !(nextObj->activeFlags & ACTIVE_FLAG_DESTRUCTIVE_OBJ_DONT_DESTROY)) {
-            check_collision_in_list(nextObj, (struct Object *) nextObj->header.next, destructiveObj);
-            check_collision_in_list(nextObj, (struct Object *) gObjectLists[OBJ_LIST_GENACTOR].next,
-                          (struct Object *) &gObjectLists[OBJ_LIST_GENACTOR]);
-            check_collision_in_list(nextObj, (struct Object *) gObjectLists[OBJ_LIST_PUSHABLE].next,
-                          (struct Object *) &gObjectLists[OBJ_LIST_PUSHABLE]);
-            check_collision_in_list(nextObj, (struct Object *) gObjectLists[OBJ_LIST_SURFACE].next,
-                          (struct Object *) &gObjectLists[OBJ_LIST_SURFACE]);
+    const u16 *slots = &sCollisionSlots[sCollisionListStart[OBJ_LIST_DESTRUCTIVE]];
+
+    for (u32 i = 0; i < sCollisionListCount[OBJ_LIST_DESTRUCTIVE]; i++) {
+        if (gObjectPool[slots[i]].oDistanceToMario < 2000.0f && !(gObjectHotData[slots[i]].activeFlags & ACTIVE_FLAG_DESTRUCTIVE_OBJ_DONT_DESTROY)) {
+            check_collision_in_lists(i, sDestructiveCollisionLists, ARRAY_COUNT(sDestructiveCollisionLists));
+        }
+    }
+}
+
+#ifdef OBJECT_COLLISION_BROADPHASE
+/**
+ * Broadphase for object collision. The X and Z extents of the hitbox of every tangible object are put
+ * into a spatial hash of OBJ_COLLISION_CELL_SIZE cells, and each object is only checked against the
+ * objects sharing a bucket with it whose hitbox circles overlap its own. Those are sorted back into the
+ * order the lists are walked in without the broadphase, so objects end up with the same collidedObjs.
+ */
+#define OBJ_COLLISION_CELL_SIZE      512
+#define OBJ_COLLISION_NUM_BUCKETS    128
+// Objects with hitboxes spanning more cells than this on either axis are checked against every object
+#define OBJ_COLLISION_MAX_CELL_SPAN  4
+// Cells further than this from the origin aren't hashed, only possible for objects outside the level
+#define OBJ_COLLISION_CELL_LIMIT     128
+#define OBJ_COLLISION_MAX_ENTRIES    (OBJECT_POOL_CAPACITY * 4)
+#define OBJ_COLLISION_MAX_CANDIDATES 64
+#define OBJ_COLLISION_NONE           0xFFFF
+
+struct ObjCollisionEntry {
+    u16 slot;
+    u16 next;
+    u16 index; // Position in its object list
+};
+
+struct ObjCollisionCandidate {
+    u16 slot;
+    u32 order;
+};
+
+static struct ObjCollisionEntry sObjCollisionEntries[OBJ_COLLISION_MAX_ENTRIES];
+static u16 sObjCollisionBuckets[OBJ_COLLISION_NUM_BUCKETS];
+static u32 sNumObjCollisionEntries;
+// Objects too big or too far out to be hashed
+static struct ObjCollisionEntry sOversizedObjs[OBJECT_POOL_CAPACITY];
+static u32 sNumOversizedObjs;
+
+static struct ObjCollisionCandidate sObjCollisionCandidates[OBJ_COLLISION_MAX_CANDIDATES];
+static u32 sNumObjCollisionCandidates;
+// The order of each list in the lists being checked against, or 0xFF if it isn't one of them
+static u8 sObjCollisionListOrder[NUM_OBJ_LISTS];
+
+/**
+ * Gets the cells that an object's hitbox covers. Returns FALSE if it covers too many to be hashed.
+ */
+static s32 obj_collision_cell_range(struct ObjectHotData *hot, s32 *minX, s32 *maxX, s32 *minZ, s32 *maxZ) {
+    const f32 scale = 1.0f / OBJ_COLLISION_CELL_SIZE;
+    f32 radius = hot->hitboxRadius;
+    f32 lowX  = (hot->pos[0] - radius) * scale;
+    f32 highX = (hot->pos[0] + radius) * scale;
+    f32 lowZ  = (hot->pos[2] - radius) * scale;
+    f32 highZ = (hot->pos[2] + radius) * scale;
+
+    // Written so that NaNs fail too.
+    if (!(lowX > -OBJ_COLLISION_CELL_LIMIT && highX < OBJ_COLLISION_CELL_LIMIT
+       && lowZ > -OBJ_COLLISION_CELL_LIMIT && highZ < OBJ_COLLISION_CELL_LIMIT)) {
+        return FALSE;
+    }
+
+    // Offset to be positive so that the casts round down.
+    *minX = (s32)(lowX  + OBJ_COLLISION_CELL_LIMIT) - OBJ_COLLISION_CELL_LIMIT;
+    *maxX = (s32)(highX + OBJ_COLLISION_CELL_LIMIT) - OBJ_COLLISION_CELL_LIMIT;
+    *minZ = (s32)(lowZ  + OBJ_COLLISION_CELL_LIMIT) - OBJ_COLLISION_CELL_LIMIT;
+    *maxZ = (s32)(highZ + OBJ_COLLISION_CELL_LIMIT) - OBJ_COLLISION_CELL_LIMIT;
+
+    return (*maxX - *minX < OBJ_COLLISION_MAX_CELL_SPAN && *maxZ - *minZ < OBJ_COLLISION_MAX_CELL_SPAN);
+}
+
+static ALWAYS_INLINE u32 obj_collision_bucket(s32 cellX, s32 cellZ) {
+    return (((u32) cellX * 73856093) ^ ((u32) cellZ * 19349663)) & (OBJ_COLLISION_NUM_BUCKETS - 1);
+}
+
+static void obj_collision_broadphase_add(u16 slot, u16 index) {
+    s32 minX, maxX, minZ, maxZ;
+    struct ObjCollisionEntry *entry;
+
+    if (obj_collision_cell_range(&gObjectHotData[slot], &minX, &maxX, &minZ, &maxZ)
+        && sNumObjCollisionEntries + (maxX - minX + 1) * (maxZ - minZ + 1) <= OBJ_COLLISION_MAX_ENTRIES) {
+        for (s32 cellZ = minZ; cellZ <= maxZ; cellZ++) {
+            for (s32 cellX = minX; cellX <= maxX; cellX++) {
+                u32 bucket = obj_collision_bucket(cellX, cellZ);
+
+                entry = &sObjCollisionEntries[sNumObjCollisionEntries];
+                entry->slot = slot;
+                entry->index = index;
+                entry->next = sObjCollisionBuckets[bucket];
+                sObjCollisionBuckets[bucket] = sNumObjCollisionEntries++;
+            }
+        }
+    } else {
+        entry = &sOversizedObjs[sNumOversizedObjs++];
+        entry->slot = slot;
+        entry->index = index;
+    }
+}
+
+/**
+ * Hashes every tangible object in the lists that object collision is checked in.
+ */
+static void obj_collision_broadphase_build(void) {
+    sNumObjCollisionEntries = 0;
+    sNumOversizedObjs = 0;
+    for (s32 i = 0; i < OBJ_COLLISION_NUM_BUCKETS; i++) {
+        sObjCollisionBuckets[i] = OBJ_COLLISION_NONE;
+    }
+
+    for (u32 i = 0; i < ARRAY_COUNT(sPlayerCollisionLists); i++) {
+        u8 list = sPlayerCollisionLists[i];
+        const u16 *slots = &sCollisionSlots[sCollisionListStart[list]];
+
+        for (u16 index = 0; index < sCollisionListCount[list]; index++) {
+            if (!gObjectHotData[slots[index]].intangible) {
+                obj_collision_broadphase_add(slots[index], index);
+            }
+        }
+    }
+}
+
+static void obj_collision_set_lists(const u8 *lists, u32 numLists) {
+    for (s32 i = 0; i < NUM_OBJ_LISTS; i++) {
+        sObjCollisionListOrder[i] = 0xFF;
+    }
+    for (u32 i = 0; i < numLists; i++) {
+        sObjCollisionListOrder[lists[i]] = i;
+    }
+}
+
+/**
+ * Adds an object to the candidates if its hitbox circle overlaps a's, which is the same test
+ * detect_object_hitbox_overlap starts with. Returns FALSE if there's no room left.
+ */
+static s32 obj_collision_add_candidate(struct ObjectHotData *a, u16 aIndex, struct ObjCollisionEntry *entry) {
+    struct ObjectHotData *b = &gObjectHotData[entry->slot];
+    u8 order = sObjCollisionListOrder[b->objListIndex];
+
+    if (order == 0xFF || (order == 0 && entry->index <= aIndex)) {
+        return TRUE;
+    }
+
+    f32 dx = a->pos[0] - b->pos[0];
+    f32 dz = a->pos[2] - b->pos[2];
+    f32 collisionRadius = a->hitboxRadius + b->hitboxRadius;
+    f32 distance = sqr(dx) + sqr(dz);
+
+    if (!(sqr(collisionRadius) > distance)) {
+        return TRUE;
+    }
+
+    if (sNumObjCollisionCandidates >= OBJ_COLLISION_MAX_CANDIDATES) {
+        return FALSE;
+    }
+    sObjCollisionCandidates[sNumObjCollisionCandidates].slot = entry->slot;
+    sObjCollisionCandidates[sNumObjCollisionCandidates].order = ((u32) order << 16) | entry->index;
+    sNumObjCollisionCandidates++;
+    return TRUE;
+}
+
+/**
+ * Checks the object at index in the first list against the objects after it in its own list and every
+ * object in the other lists, the same as check_collision_in_lists does.
+ */
+static void check_collision_in_cells(u32 index, const u8 *lists, u32 numLists) {
+    u16 aSlot = sCollisionSlots[sCollisionListStart[lists[0]] + index];
+    struct ObjectHotData *a = &gObjectHotData[aSlot];
+    s32 minX, maxX, minZ, maxZ;
+
+    if (a->intangible) {
+        return;
+    }
+    if (!obj_collision_cell_range(a, &minX, &maxX, &minZ, &maxZ)) {
+        check_collision_in_lists(index, lists, numLists);
+        return;
+    }
+
+    sNumObjCollisionCandidates = 0;
+    for (s32 cellZ = minZ; cellZ <= maxZ; cellZ++) {
+        for (s32 cellX = minX; cellX <= maxX; cellX++) {
+            u16 entryIndex = sObjCollisionBuckets[obj_collision_bucket(cellX, cellZ)];
+
+            while (entryIndex != OBJ_COLLISION_NONE) {
+                struct ObjCollisionEntry *entry = &sObjCollisionEntries[entryIndex];
+                if (!obj_collision_add_candidate(a, index, entry)) {
+                    check_collision_in_lists(index, lists, numLists);
+                    return;
+                }
+                entryIndex = entry->next;
+            }
+        }
+    }
+    for (u32 i = 0; i < sNumOversizedObjs; i++) {
+        if (!obj_collision_add_candidate(a, index, &sOversizedObjs[i])) {
+            check_collision_in_lists(index, lists, numLists);
+            return;
+        }
+    }
+
+    // Sort them into list order. There are only ever a few, so insertion sort is fine.
+    struct ObjCollisionCandidate *candidates = sObjCollisionCandidates;
+    for (u32 i = 1; i < sNumObjCollisionCandidates; i++) {
+        struct ObjCollisionCandidate candidate = candidates[i];
+        s32 j = i - 1;
+        for (; j >= 0 && candidates[j].order > candidate.order; j--) {
+            candidates[j + 1] = candidates[j];
+        }
+        candidates[j + 1] = candidate;
+    }
+
+    for (u32 i = 0; i < sNumObjCollisionCandidates; i++) {
+        // Objects in several cells that hash to the same bucket are found more than once.
+        if (i > 0 && candidates[i].order == candidates[i - 1].order) {
+            continue;
+        }
+        u16 bSlot = candidates[i].slot;
+        if (detect_object_hitbox_overlap(aSlot, bSlot) && gObjectHotData[bSlot].hurtboxRadius != 0.0f) {
+            detect_object_hurtbox_overlap(&gObjectPool[aSlot], &gObjectPool[bSlot]);
+        }
+    }
+}
+
+void check_player_object_collision_broadphase(void) {
+    obj_collision_set_lists(sPlayerCollisionLists, ARRAY_COUNT(sPlayerCollisionLists));
+    for (u32 i = 0; i < sCollisionListCount[OBJ_LIST_PLAYER]; i++) {
+        check_collision_in_cells(i, sPlayerCollisionLists, ARRAY_COUNT(sPlayerCollisionLists));
+    }
+}
+
+void check_pushable_object_collision_broadphase(void) {
+    obj_collision_set_lists(sPushableCollisionLists, ARRAY_COUNT(sPushableCollisionLists));
+    for (u32 i = 0; i < sCollisionListCount[OBJ_LIST_PUSHABLE]; i++) {
+        check_collision_in_cells(i, sPushableCollisionLists, ARRAY_COUNT(sPushableCollisionLists));
+    }
+}
+
+void check_destructive_object_collision_broadphase(void) {
+    const u16 *slots = &sCollisionSlots[sCollisionListStart[OBJ_LIST_DESTRUCTIVE]];
+
+    obj_collision_set_lists(sDestructiveCollisionLists, ARRAY_COUNT(sDestructiveCollisionLists));
+    for (u32 i = 0; i < sCollisionListCount[OBJ_LIST_DESTRUCTIVE]; i++) {
+        if (gObjectPool[slots[i]].oDistanceToMario < 2000.0f && !(gObjectHotData[slots[i]].activeFlags & ACTIVE_FLAG_DESTRUCTIVE_OBJ_DONT_DESTROY)) {
+            check_collision_in_cells(i, sDestructiveCollisionLists, ARRAY_COUNT(sDestructiveCollisionLists));
         }
-        nextObj = (struct Object *) nextObj->header.next;
     }
 }
+#endif
 
 void detect_object_collisions(void) {
-    clear_object_collision((struct Object *) &gObjectLists[OBJ_LIST_POLELIKE]);
-    clear_object_collision((struct Object *) &gObjectLists[OBJ_LIST_PLAYER]);
-    clear_object_collision((struct Object *) &gObjectLists[OBJ_LIST_PUSHABLE]);
-    clear_object_collision((struct Object *) &gObjectLists[OBJ_LIST_GENACTOR]);
-    clear_object_collision((struct Object *) &gObjectLists[OBJ_LIST_LEVEL]);
-    clear_object_collision((struct Object *) &gObjectLists[OBJ_LIST_SURFACE]);
-    clear_object_collision((struct Object *) &gObjectLists[OBJ_LIST_DESTRUCTIVE]);
+    sNumCollisionSlots = 0;
+    clear_object_collision(OBJ_LIST_POLELIKE);
+    clear_object_collision(OBJ_LIST_PLAYER);
+    clear_object_collision(OBJ_LIST_PUSHABLE);
+    clear_object_collision(OBJ_LIST_GENACTOR);
+    clear_object_collision(OBJ_LIST_LEVEL);
+    clear_object_collision(OBJ_LIST_SURFACE);
+    clear_object_collision(OBJ_LIST_DESTRUCTIVE);
+#ifdef OBJECT_COLLISION_BROADPHASE
+    obj_collision_broadphase_build();
+    check_player_object_collision_broadphase();
+    check_destructive_object_collision_broadphase();
+    check_pushable_object_collision_broadphase();
+#else
     check_player_object_collision();
     check_destructive_object_collision();
     check_pushable_object_collision();
+#endif
 }
@@ -0,0 +1,270 @@
+#include <PR/ultratypes.h>
+
+#include "sm64.h"
+#include "config/config_world.h"
+#include "engine/math_util.h"
+#include "memory.h"
+#include "object_grid.h"
+#include "object_list_processor.h"
+
+/**
+ * @file object_grid.c
+ * A grid of every active object by its X and Z position, using the same cells as the surface
+ * partition, so that behaviors can look for the objects around them by only checking the cells within
+ * their search radius. It's built by the first query of each frame, so frames without any queries
+ * don't pay for it.
+ *
+ * Objects keep their cell for the rest of the frame, so the search is widened by OBJECT_GRID_MARGIN
+ * for the ones that moved since. Objects spawned after the grid was built are kept in a separate list
+ * that every query checks, and distances are always measured from the objects' current positions.
+ */
+
+#define OBJECT_GRID_NONE 0xFFFF
+
+// The first object in each cell, then the next object in the same cell for each object in the pool
+static u16 sObjectGridCells[NUM_CELLS][NUM_CELLS];
+static u16 sObjectGridNext[OBJECT_POOL_CAPACITY];
+// Objects spawned since the grid was built, which aren't in any cell
+static u16 sObjectGridSpawned[OBJECT_POOL_CAPACITY];
+static u8  sObjectGridIsSpawned[OBJECT_POOL_CAPACITY];
+static u32 sNumObjectGridSpawned = 0;
+static u8 sObjectGridBuilt = FALSE;
+
+static s32 object_grid_cell_coord(f32 pos) {
+    s32 coord = ((s32) pos + LEVEL_BOUNDARY_MAX) / CELL_SIZE;
+
+    if (coord < 0) {
+        return 0;
+    }
+    if (coord > NUM_CELLS - 1) {
+        return NUM_CELLS - 1;
+    }
+    return coord;
+}
+
+/**
+ * Put every active object into the cell it's in. Called by the first query after the grid was invalidated.
+ */
+static void object_grid_build(void) {
+    s32 i, j;
+
+    sObjectGridBuilt = TRUE;
+
+    for (i = 0; i < NUM_CELLS; i++) {
+        for (j = 0; j < NUM_CELLS; j++) {
+            sObjectGridCells[i][j] = OBJECT_GRID_NONE;
+        }
+    }
+
+    for (i = 0; i < sNumObjectGridSpawned; i++) {
+        sObjectGridIsSpawned[sObjectGridSpawned[i]] = FALSE;
+    }
+    sNumObjectGridSpawned = 0;
+
+    for (i = 0; i < NUM_OBJ_LISTS; i++) {
+        struct ObjectNode *listHead = &gObjectLists[i];
+        struct Object *obj = (struct Object *) listHead->next;
+
+        while (obj != (struct Object *) listHead) {
+            if (obj->activeFlags != ACTIVE_FLAG_DEACTIVATED) {
+                u16 *cell = &sObjectGridCells[object_grid_cell_coord(obj->oPosZ)][object_grid_cell_coord(obj->oPosX)];
+                u16 index = obj - gObjectPool;
+
+                sObjectGridNext[index] = *cell;
+                *cell = index;
+            }
+            obj = (struct Object *) obj->header.next;
+        }
+    }
+}
+
+/**
+ * Have the next query rebuild the grid. Called at the start of update_objects.
+ */
+void object_grid_invalidate(void) {
+    sObjectGridBuilt = FALSE;
+}
+
+/**
+ * Called by create_object, as objects spawned after the grid was built don't have a cell. The slot
+ * might have had a cell as a different object, which is then skipped instead.
+ */
+void object_grid_add_spawned(struct Object *obj) {
+    u16 index = obj - gObjectPool;
+
+    if (!sObjectGridIsSpawned[index]) {
+        sObjectGridIsSpawned[index] = TRUE;
+        sObjectGridSpawned[sNumObjectGridSpawned++] = index;
+    }
+}
+
+struct ObjectGridQuery {
+    struct Object *center;
+    const BehaviorScript *behavior;
+    f32 radiusSq;
+    struct Object **foundObjs;
+    f32 *distsSq;
+    s32 maxObjs;
+    s32 numFound;
+    s32 sorted; // Keep the nearest maxObjs sorted by distance, rather than the first maxObjs found
+};
+
+static void object_grid_check(struct ObjectGridQuery *query, struct Object *obj) {
+    s32 i;
+
+    if (obj == query->center
+        || obj->activeFlags == ACTIVE_FLAG_DEACTIVATED
+        || (query->behavior != NULL && obj->behavior != query->behavior)) {
+        return;
+    }
+
+    f32 dx = obj->oPosX - query->center->oPosX;
+    f32 dy = obj->oPosY - query->center->oPosY;
+    f32 dz = obj->oPosZ - query->center->oPosZ;
+    f32 distSq = sqr(dx) + sqr(dy) + sqr(dz);
+
+    if (!(distSq <= query->radiusSq)) {
+        return;
+    }
+
+    if (!query->sorted) {
+        if (query->numFound < query->maxObjs) {
+            query->foundObjs[query->numFound++] = obj;
+        }
+        return;
+    }
+
+    // Insert it among the nearest ones found so far, dropping the furthest if there's no room.
+    if (query->numFound == query->maxObjs) {
+        if (distSq >= query->distsSq[query->numFound - 1]) {
+            return;
+        }
+        query->numFound--;
+    }
+    for (i = query->numFound; i > 0 && query->distsSq[i - 1] > distSq; i--) {
+        query->foundObjs[i] = query->foundObjs[i - 1];
+        query->distsSq[i] = query->distsSq[i - 1];
+    }
+    query->foundObjs[i] = obj;
+    query->distsSq[i] = distSq;
+    query->numFound++;
+}
+
+static void object_grid_query(struct ObjectGridQuery *query, f32 radius) {
+    struct Object *center = query->center;
+    f32 range = radius + OBJECT_GRID_MARGIN;
+    s32 minX = object_grid_cell_coord(center->oPosX - range);
+    s32 maxX = object_grid_cell_coord(center->oPosX + range);
+    s32 minZ = object_grid_cell_coord(center->oPosZ - range);
+    s32 maxZ = object_grid_cell_coord(center->oPosZ + range);
+    s32 cellX, cellZ;
+    u32 i;
+
+    query->radiusSq = sqr(radius);
+    query->numFound = 0;
+    if (query->maxObjs <= 0) {
+        return;
+    }
+
+    if (!sObjectGridBuilt) {
+        object_grid_build();
+    }
+
+    for (cellZ = minZ; cellZ <= maxZ; cellZ++) {
+        for (cellX = minX; cellX <= maxX; cellX++) {
+            u16 index = sObjectGridCells[cellZ][cellX];
+
+            while (index != OBJECT_GRID_NONE) {
+                if (!sObjectGridIsSpawned[index]) {
+                    object_grid_check(query, &gObjectPool[index]);
+                }
+                index = sObjectGridNext[index];
+            }
+        }
+    }
+
+    for (i = 0; i < sNumObjectGridSpawned; i++) {
+        object_grid_check(query, &gObjectPool[sObjectGridSpawned[i]]);
+    }
+}
+
+/**
+ * Find the nearest object to obj within radius, only checking ones with the given behavior unless
+ * it's NULL. Returns NULL if there isn't one, otherwise sets dist to its distance.
+ */
+struct Object *obj_find_nearest_object_in_radius(struct Object *obj, const BehaviorScript *behavior, f32 radius, f32 *dist) {
+    struct Object *foundObj;
+
+    if (obj_find_k_nearest_objects(obj, behavior, radius, &foundObj, dist, 1) == 0) {
+        return NULL;
+    }
+
+    return foundObj;
+}
+
+/**
+ * Find up to k objects nearest to obj within radius, nearest first, only checking ones with the given
+ * behavior unless it's NULL. k is clamped to OBJECT_GRID_MAX_NEAREST. Returns how many were found.
+ * dists can be NULL if the distances aren't needed.
+ */
+s32 obj_find_k_nearest_objects(struct Object *obj, const BehaviorScript *behavior, f32 radius,
+                               struct Object **foundObjs, f32 *dists, s32 k) {
+    struct ObjectGridQuery query;
+    s32 i;
+
+    f32 distsSq[OBJECT_GRID_MAX_NEAREST];
+
+    if (k <= 0) {
+        return 0;
+    }
+    if (k > OBJECT_GRID_MAX_NEAREST) {
+        k = OBJECT_GRID_MAX_NEAREST;
+    }
+
+    query.center = obj;
+    query.behavior = (behavior != NULL) ? segmented_to_virtual(behavior) : NULL;
+    query.foundObjs = foundObjs;
+    query.distsSq = distsSq;
+    query.maxObjs = k;
+    query.sorted = TRUE;
+    object_grid_query(&query, radius);
+
+    if (dists != NULL) {
+        for (i = 0; i < query.numFound; i++) {
+            dists[i] = sqrtf(distsSq[i]);
+        }
+    }
+
+    return query.numFound;
+}
+
+/**
+ * Find up to maxObjs objects within radius of obj, in no particular order, only checking ones with the
+ * given behavior unless it's NULL. Returns how many were found.
+ */
+s32 obj_find_objects_in_radius(struct Object *obj, const BehaviorScript *behavior, f32 radius,
+                               struct Object **foundObjs, s32 maxObjs) {
+    struct ObjectGridQuery query;
+
+    query.center = obj;
+    query.behavior = (behavior != NULL) ? segmented_to_virtual(behavior) : NULL;
+    query.foundObjs = foundObjs;
+    query.distsSq = NULL;
+    query.maxObjs = maxObjs;
+    query.sorted = FALSE;
+    object_grid_query(&query, radius);
+
+    return query.numFound;
+}
+
+struct Object *cur_obj_find_nearest_object_in_radius(const BehaviorScript *behavior, f32 radius, f32 *dist) {
+    return obj_find_nearest_object_in_radius(o, behavior, radius, dist);
+}
+
+s32 cur_obj_find_k_nearest_objects(const BehaviorScript *behavior, f32 radius, struct Object **foundObjs, f32 *dists, s32 k) {
+    return obj_find_k_nearest_objects(o, behavior, radius, foundObjs, dists, k);
+}
+
+s32 cur_obj_find_objects_in_radius(const BehaviorScript *behavior, f32 radius, struct Object **foundObjs, s32 maxObjs) {
+    return obj_find_objects_in_radius(o, behavior, radius, foundObjs, maxObjs);
+}
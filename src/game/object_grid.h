@@ -0,0 +1,27 @@
+#ifndef OBJECT_GRID_H
+#define OBJECT_GRID_H
+
+#include <PR/ultratypes.h>
+
+#include "types.h"
+
+// How far objects can move between the grid being built and being queried while still being found.
+// Objects that moved further than this since the first query of the frame can be missed.
+#define OBJECT_GRID_MARGIN 200.0f
+// The most objects obj_find_k_nearest_objects can return
+#define OBJECT_GRID_MAX_NEAREST 32
+
+void object_grid_invalidate(void);
+void object_grid_add_spawned(struct Object *obj);
+
+struct Object *obj_find_nearest_object_in_radius(struct Object *obj, const BehaviorScript *behavior, f32 radius, f32 *dist);
+s32 obj_find_k_nearest_objects(struct Object *obj, const BehaviorScript *behavior, f32 radius,
+                               struct Object **foundObjs, f32 *dists, s32 k);
+s32 obj_find_objects_in_radius(struct Object *obj, const BehaviorScript *behavior, f32 radius,
+                               struct Object **foundObjs, s32 maxObjs);
+
+struct Object *cur_obj_find_nearest_object_in_radius(const BehaviorScript *behavior, f32 radius, f32 *dist);
+s32 cur_obj_find_k_nearest_objects(const BehaviorScript *behavior, f32 radius, struct Object **foundObjs, f32 *dists, s32 k);
+s32 cur_obj_find_objects_in_radius(const BehaviorScript *behavior, f32 radius, struct Object **foundObjs, s32 maxObjs);
+
+#endif // OBJECT_GRID_H
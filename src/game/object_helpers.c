@@ -21,6 +21,7 @@
 #include "mario_actions_cutscene.h"
 #include "memory.h"
 #include "obj_behaviors.h"
+#include "particle_system.h"
 #include "object_helpers.h"
 #include "object_list_processor.h"
 #include "rendering_graph_node.h"
@@ -697,13 +698,14 @@ static s32 obj_bparam_ckeck(struct Object *obj, s32 bparamToCheck, s32 unused, f
 
 static struct Object *cur_obj_find_nearest_object_with_behavior_and_func(const BehaviorScript *behavior, f32 *dist, s32 fieldOrBparamToCheck, s32 objFieldType, f32 wantedValue, s32 operator, s32 (*func)(struct Object *, s32, s32, f32, s32)){
     uintptr_t *behaviorAddr = segmented_to_virtual(behavior);
-    struct ObjectNode *listHead = &gObjectLists[get_object_list_from_behavior(behaviorAddr)];
-    struct Object *obj = (struct Object *) listHead->next;
+    u32 objList = get_object_list_from_behavior(behaviorAddr);
+    struct Object *obj = behavior_bucket_first(behaviorAddr);
     struct Object *closestObj = NULL;
     f32 minDist = 0x20000;
 
-    while (obj != (struct Object *) listHead) {
+    while (obj != NULL) {
         if (obj->behavior == behaviorAddr
+            && obj->objListIndex == objList
             && obj->activeFlags != ACTIVE_FLAG_DEACTIVATED
             && obj != o
             && func(obj, fieldOrBparamToCheck, objFieldType, wantedValue, operator)
@@ -715,7 +717,7 @@ static struct Object *cur_obj_find_nearest_object_with_behavior_and_func(const B
             }
         }
 
-        obj = (struct Object *) obj->header.next;
+        obj = obj->bhvBucketNext;
     }
 
     *dist = minDist;
@@ -797,16 +799,16 @@ s32 count_unimportant_objects(void) {
 
 s32 count_objects_with_behavior(const BehaviorScript *behavior) {
     uintptr_t *behaviorAddr = segmented_to_virtual(behavior);
-    struct ObjectNode *listHead = &gObjectLists[get_object_list_from_behavior(behaviorAddr)];
-    struct ObjectNode *obj = listHead->next;
+    u32 objList = get_object_list_from_behavior(behaviorAddr);
+    struct Object *obj = behavior_bucket_first(behaviorAddr);
     s32 count = 0;
 
-    while (listHead != obj) {
-        if (((struct Object *) obj)->behavior == behaviorAddr) {
+    while (obj != NULL) {
+        if (obj->behavior == behaviorAddr && obj->objListIndex == objList) {
             count++;
         }
 
-        obj = obj->next;
+        obj = obj->bhvBucketNext;
     }
 
     return count;
@@ -814,13 +816,13 @@ s32 count_objects_with_behavior(const BehaviorScript *behavior) {
 
 struct Object *cur_obj_find_nearby_held_actor(const BehaviorScript *behavior, f32 maxDist) {
     const BehaviorScript *behaviorAddr = segmented_to_virtual(behavior);
-    struct ObjectNode *listHead = &gObjectLists[OBJ_LIST_GENACTOR];
-    struct Object *obj = (struct Object *) listHead->next;
+    struct Object *obj = behavior_bucket_first(behaviorAddr);
     struct Object *foundObj = NULL;
 
-    while ((struct Object *) listHead != obj) {
+    while (obj != NULL) {
         if (
             obj->behavior == behaviorAddr
+            && obj->objListIndex == OBJ_LIST_GENACTOR
             && obj->activeFlags != ACTIVE_FLAG_DEACTIVATED
             && obj->oHeldState != HELD_FREE
             && dist_between_objects(o, obj) < maxDist
@@ -831,7 +833,7 @@ struct Object *cur_obj_find_nearby_held_actor(const BehaviorScript *behavior, f3
             break;
         }
 
-        obj = (struct Object *) obj->header.next;
+        obj = obj->bhvBucketNext;
     }
 
     return foundObj;
@@ -1032,6 +1034,7 @@ void obj_mark_for_deletion(struct Object *obj) {
     //  so this is worth looking into.
     //! NOTE: Changing this can cause reference issues!
     obj->activeFlags = ACTIVE_FLAG_DEACTIVATED;
+    queue_object_unload(obj);
 }
 
 void cur_obj_disable(void) {
@@ -1071,7 +1074,7 @@ struct Surface *cur_obj_update_floor_height_and_get_floor(void) {
     return floor;
 }
 
-static void apply_drag_to_value(f32 *value, f32 dragStrength) {
+void apply_drag_to_value(f32 *value, f32 dragStrength) {
     f32 decel;
 
     if (*value != 0) {
@@ -1329,11 +1332,11 @@ s32 obj_check_if_collided_with_object(struct Object *obj1, struct Object *obj2)
 }
 
 void cur_obj_set_behavior(const BehaviorScript *behavior) {
-    o->behavior = segmented_to_virtual(behavior);
+    set_object_behavior(o, segmented_to_virtual(behavior));
 }
 
 void obj_set_behavior(struct Object *obj, const BehaviorScript *behavior) {
-    obj->behavior = segmented_to_virtual(behavior);
+    set_object_behavior(obj, segmented_to_virtual(behavior));
 }
 
 s32 cur_obj_has_behavior(const BehaviorScript *behavior) {
@@ -1809,6 +1812,12 @@ void cur_obj_spawn_particles(struct SpawnParticlesInfo *info) {
     f32 scale;
     s32 numParticles = info->count;
 
+#ifdef PARTICLE_SYSTEM
+    if (spawn_particles_from_info(o, info)) {
+        return;
+    }
+#endif
+
     // If there are a lot of objects already, limit the number of particles
     if ((gPrevFrameObjectCount > (OBJECT_POOL_CAPACITY - 90)) && numParticles > 10) {
         numParticles = 10;
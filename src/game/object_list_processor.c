@@ -10,13 +10,16 @@
 #include "engine/surface_collision.h"
 #include "engine/surface_load.h"
 #include "engine/math_util.h"
+#include "game_init.h"
 #include "interaction.h"
 #include "level_update.h"
 #include "mario.h"
 #include "memory.h"
 #include "object_collision.h"
+#include "object_grid.h"
 #include "object_helpers.h"
 #include "object_list_processor.h"
+#include "particle_system.h"
 #include "platform_displacement.h"
 #include "spawn_object.h"
 #include "puppyprint.h"
@@ -68,6 +71,11 @@ u32 gTimeStopState;
  */
 struct Object gObjectPool[OBJECT_POOL_CAPACITY];
 
+/**
+ * The collision fields of each object in the pool, see struct ObjectHotData.
+ */
+struct ObjectHotData gObjectHotData[OBJECT_POOL_CAPACITY] ALIGNED16;
+
 /**
  * A special object whose purpose is to act as a parent for macro objects.
  */
@@ -282,6 +290,46 @@ void bhv_mario_update(void) {
     }
 }
 
+#ifdef OBJECT_LOD_TICKING
+static const f32 sLodTickDistances[NUM_OBJ_LISTS][2] = OBJECT_LOD_TICK_DISTANCES;
+
+/**
+ * Whether an object should be updated this frame. Objects far from Mario only update every 2nd or
+ * 4th frame, staggered by their slot in the pool, and count the frames they skip for cur_obj_update.
+ */
+static s32 obj_lod_tick(struct Object *obj) {
+    const f32 *distances = sLodTickDistances[obj->objListIndex];
+    u32 interval = 1;
+
+    if (distances[0] > 0.0f && gMarioObject != NULL && obj != gMarioObject && obj->oHeldState == HELD_FREE) {
+        f32 dx = obj->oPosX - gMarioObject->oPosX;
+        f32 dy = obj->oPosY - gMarioObject->oPosY;
+        f32 dz = obj->oPosZ - gMarioObject->oPosZ;
+        f32 distSq = sqr(dx) + sqr(dy) + sqr(dz);
+
+        // Objects that weren't on screen last frame count as twice as far.
+        if (gGlobalTimer - obj->lastInViewFrame > 1) {
+            distSq *= 4.0f;
+        }
+
+        if (distances[1] > 0.0f && distSq > sqr(distances[1])) {
+            interval = 4;
+        } else if (distSq > sqr(distances[0])) {
+            interval = 2;
+        }
+    }
+
+    if (interval > 1
+        && ((gGlobalTimer + (obj - gObjectPool)) & (interval - 1)) != 0
+        && obj->lodSkippedFrames < interval - 1) {
+        obj->lodSkippedFrames++;
+        return FALSE;
+    }
+
+    return TRUE;
+}
+#endif
+
 /**
  * Update every object that occurs after firstObj in the given object list,
  * including firstObj itself. Return the number of objects that were updated.
@@ -293,7 +341,22 @@ s32 update_objects_starting_at(struct ObjectNode *objList, struct ObjectNode *fi
         gCurrentObject = (struct Object *) firstObj;
 
         gCurrentObject->header.gfx.node.flags |= GRAPH_RENDER_HAS_ANIMATION;
-        cur_obj_update();
+#ifdef OBJECT_LOD_TICKING
+        if (obj_lod_tick(gCurrentObject))
+#endif
+        {
+            PROFILER_BEHAVIOR_BEGIN(gCurrentObject);
+            cur_obj_update();
+            PROFILER_BEHAVIOR_END();
+#ifdef BATCHED_FLOOR_PROBES
+            queue_object_floor_probe(gCurrentObject);
+#endif
+        }
+
+        // Also catches objects deactivated by others after they updated last frame
+        if ((gCurrentObject->activeFlags & ACTIVE_FLAG_ACTIVE) != ACTIVE_FLAG_ACTIVE) {
+            queue_object_unload(gCurrentObject);
+        }
 
         firstObj = firstObj->next;
         count++;
@@ -340,11 +403,20 @@ s32 update_objects_during_time_stop(struct ObjectNode *objList, struct ObjectNod
         // Only update if unfrozen
         if (unfrozen) {
             gCurrentObject->header.gfx.node.flags |= GRAPH_RENDER_HAS_ANIMATION;
+            PROFILER_BEHAVIOR_BEGIN(gCurrentObject);
             cur_obj_update();
+            PROFILER_BEHAVIOR_END();
+#ifdef BATCHED_FLOOR_PROBES
+            queue_object_floor_probe(gCurrentObject);
+#endif
         } else {
             gCurrentObject->header.gfx.node.flags &= ~GRAPH_RENDER_HAS_ANIMATION;
         }
 
+        if ((gCurrentObject->activeFlags & ACTIVE_FLAG_ACTIVE) != ACTIVE_FLAG_ACTIVE) {
+            queue_object_unload(gCurrentObject);
+        }
+
         firstObj = firstObj->next;
         count++;
     }
@@ -369,31 +441,6 @@ s32 update_objects_in_list(struct ObjectNode *objList) {
     return count;
 }
 
-/**
- * Unload any objects in the list that have been deactivated.
- */
-s32 unload_deactivated_objects_in_list(struct ObjectNode *objList) {
-    struct ObjectNode *obj = objList->next;
-
-    while (objList != obj) {
-        gCurrentObject = (struct Object *) obj;
-
-        obj = obj->next;
-
-        if ((gCurrentObject->activeFlags & ACTIVE_FLAG_ACTIVE) != ACTIVE_FLAG_ACTIVE) {
-            // Prevent object from respawning after exiting and re-entering the
-            // area
-            if (!(gCurrentObject->oFlags & OBJ_FLAG_PERSISTENT_RESPAWN)) {
-                set_object_respawn_info_bits(gCurrentObject, RESPAWN_INFO_DONT_RESPAWN);
-            }
-
-            unload_object(gCurrentObject);
-        }
-    }
-
-    return 0;
-}
-
 /**
  * OR the object's respawn info with bits << 8. If bits = 0xFF, this prevents
  * the object from respawning after leaving and re-entering the area.
@@ -441,6 +488,10 @@ void unload_objects_from_area(UNUSED s32 unused, s32 areaIndex) {
             }
         }
     }
+
+#ifdef PARTICLE_SYSTEM
+    unload_particles_from_area(areaIndex);
+#endif
 }
 
 /**
@@ -523,6 +574,15 @@ void clear_objects(void) {
 
     init_free_object_list();
     clear_object_lists(gObjectListArray);
+#ifdef COMPILED_BEHAVIOR_LOOPS
+    bhv_clear_compiled_loops();
+#endif
+#ifdef PROFILER_BEHAVIORS
+    profiler_behaviors_reset();
+#endif
+#ifdef PARTICLE_SYSTEM
+    clear_particles();
+#endif
 
     for (i = 0; i < OBJECT_POOL_CAPACITY; i++) {
         gObjectPool[i].activeFlags = ACTIVE_FLAG_DEACTIVATED;
@@ -535,18 +595,41 @@ void clear_objects(void) {
     clear_dynamic_surfaces();
 }
 
+#ifdef PROFILER_SCOPES
+// Scope names for each object list, so that the time taken by each list's objects is shown separately.
+static const char *sObjectListScopeNames[NUM_OBJ_LISTS] = {
+    [OBJ_LIST_PLAYER]      = "Player list",
+    [OBJ_LIST_UNUSED_1]    = "List 1",
+    [OBJ_LIST_DESTRUCTIVE] = "Destructive list",
+    [OBJ_LIST_UNUSED_3]    = "List 3",
+    [OBJ_LIST_GENACTOR]    = "Actor list",
+    [OBJ_LIST_PUSHABLE]    = "Pushable list",
+    [OBJ_LIST_LEVEL]       = "Level list",
+    [OBJ_LIST_UNUSED_7]    = "List 7",
+    [OBJ_LIST_DEFAULT]     = "Default list",
+    [OBJ_LIST_SURFACE]     = "Surface list",
+    [OBJ_LIST_POLELIKE]    = "Polelike list",
+    [OBJ_LIST_SPAWNER]     = "Spawner list",
+    [OBJ_LIST_UNIMPORTANT] = "Unimportant list",
+};
+#endif
+
 /**
  * Update spawner and surface objects.
  */
 void update_terrain_objects(void) {
     PROFILER_GET_SNAPSHOT_TYPE(PROFILER_DELTA_COLLISION);
+    PROFILER_SCOPE_BEGIN(sObjectListScopeNames[OBJ_LIST_SPAWNER]);
     gObjectCounter = update_objects_in_list(&gObjectLists[OBJ_LIST_SPAWNER]);
+    PROFILER_SCOPE_END();
     profiler_update(PROFILER_TIME_SPAWNER, profiler_get_delta(PROFILER_DELTA_COLLISION) - first);
 
 #ifdef PUPPYPRINT_DEBUG
     first = profiler_get_delta(PROFILER_DELTA_COLLISION);
 #endif
+    PROFILER_SCOPE_BEGIN(sObjectListScopeNames[OBJ_LIST_SURFACE]);
     gObjectCounter += update_objects_in_list(&gObjectLists[OBJ_LIST_SURFACE]);
+    PROFILER_SCOPE_END();
     profiler_update(PROFILER_TIME_DYNAMIC, profiler_get_delta(PROFILER_DELTA_COLLISION) - first);
 
     // If the dynamic surface pool has overflowed, throw an error.
@@ -566,7 +649,9 @@ void update_non_terrain_objects(void) {
         if (listIndex == OBJ_LIST_PLAYER) {
             profiler_update(PROFILER_TIME_BEHAVIOR_BEFORE_MARIO, profiler_get_delta(PROFILER_DELTA_COLLISION) - first);
         }
+        PROFILER_SCOPE_BEGIN(sObjectListScopeNames[listIndex]);
         gObjectCounter += update_objects_in_list(&gObjectLists[listIndex]);
+        PROFILER_SCOPE_END();
         if (listIndex == OBJ_LIST_PLAYER) {
             profiler_update(PROFILER_TIME_MARIO, profiler_get_delta(PROFILER_DELTA_COLLISION) - first);
         }
@@ -575,15 +660,23 @@ void update_non_terrain_objects(void) {
 }
 
 /**
- * Unload deactivated objects in any object list.
+ * Unload the objects that were deactivated this frame.
  */
 void unload_deactivated_objects(void) {
-    s32 listIndex;
+    struct Object *obj;
 
-    s32 i = 0;
-    while ((listIndex = sObjectListUpdateOrder[i]) != -1) {
-        unload_deactivated_objects_in_list(&gObjectLists[listIndex]);
-        i++;
+    while ((obj = next_pending_unload()) != NULL) {
+        if ((obj->activeFlags & ACTIVE_FLAG_ACTIVE) != ACTIVE_FLAG_ACTIVE) {
+            gCurrentObject = obj;
+
+            // Prevent object from respawning after exiting and re-entering the
+            // area
+            if (!(obj->oFlags & OBJ_FLAG_PERSISTENT_RESPAWN)) {
+                set_object_respawn_info_bits(obj, RESPAWN_INFO_DONT_RESPAWN);
+            }
+
+            unload_object(obj);
+        }
     }
 
     // TIME_STOP_UNKNOWN_0 was most likely intended to be used to track whether
@@ -632,6 +725,7 @@ void clear_dynamic_surface_references(void) {
  * and object surface management.
  */
 void update_objects(UNUSED s32 unused) {
+    PROFILER_SCOPE_BEGIN("Objects");
 
     gTimeStopState &= ~TIME_STOP_MARIO_OPENED_DOOR;
 
@@ -644,8 +738,13 @@ void update_objects(UNUSED s32 unused) {
 
     gObjectLists = gObjectListArray;
 
+    // The object grid is rebuilt by the first query of the frame, if there is one
+    object_grid_invalidate();
+
     // If time stop is not active, unload object surfaces
+    PROFILER_SCOPE_BEGIN("Clear surfaces");
     clear_dynamic_surfaces();
+    PROFILER_SCOPE_END();
 
     // Update spawners and objects with surfaces
     update_terrain_objects();
@@ -657,20 +756,40 @@ void update_objects(UNUSED s32 unused) {
     apply_mario_platform_displacement();
 
     // Detect which objects are intersecting
+    PROFILER_SCOPE_BEGIN("Object collisions");
     detect_object_collisions();
+    PROFILER_SCOPE_END();
 
     // Update all other objects that haven't been updated yet
     update_non_terrain_objects();
+
+#ifdef PARTICLE_SYSTEM
+    // Particles freeze during time stop, like the unimportant objects they replace.
+    if (!(gTimeStopState & TIME_STOP_ACTIVE)) {
+        PROFILER_SCOPE_BEGIN("Particles");
+        update_particles();
+        PROFILER_SCOPE_END();
+    }
+#endif
     
     // Take a snapshot of the current collision processing time.
     UNUSED u32 firstPoint = profiler_get_delta(PROFILER_DELTA_COLLISION); 
 
     // Unload any objects that have been deactivated
+    PROFILER_SCOPE_BEGIN("Unload");
     unload_deactivated_objects();
+    PROFILER_SCOPE_END();
 
     // Check if Mario is on a platform object and save this object
     update_mario_platform();
 
+#ifdef BATCHED_FLOOR_PROBES
+    // Find the static floors under the objects for next frame
+    PROFILER_SCOPE_BEGIN("Floor probes");
+    resolve_floor_probes();
+    PROFILER_SCOPE_END();
+#endif
+
     try_print_debug_mario_object_info();
 
     // If time stop was enabled this frame, activate it now so that it will
@@ -684,4 +803,5 @@ void update_objects(UNUSED s32 unused) {
     gPrevFrameObjectCount = gObjectCounter;
     // Set the recorded behaviour time, minus the difference between the snapshotted collision time and the actual collision time.
     profiler_update(PROFILER_TIME_BEHAVIOR_AFTER_MARIO, profiler_get_delta(PROFILER_DELTA_COLLISION) - firstPoint);
+    PROFILER_SCOPE_END();
 }
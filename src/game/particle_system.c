@@ -0,0 +1,291 @@
+#include <ultra64.h>
+
+#include "sm64.h"
+#include "config.h"
+
+#ifdef PARTICLE_SYSTEM
+
+#include "actors/common1.h"
+#include "engine/math_util.h"
+#include "game_init.h"
+#include "memory.h"
+#include "model_ids.h"
+#include "object_helpers.h"
+#include "object_list_processor.h"
+#include "particle_system.h"
+#include "rendering_graph_node.h"
+
+/**
+ * @file particle_system.c
+ * Particles that only move and fade, kept in a pool of their own instead of each taking an object slot
+ * and running a behavior. They're updated together once the objects have been, and drawn with one display
+ * list per material, which loads the material once and then only sets each particle's matrix.
+ *
+ * cur_obj_spawn_particles spawns its particles here if their model has a material, the same way
+ * bhvWhitePuffExplosion would have moved them. Other particles can be spawned with spawn_particle_from_object.
+ */
+
+// How long the particles spawned from a SpawnParticlesInfo last, as bhv_white_puff_exploding_loop
+#define PARTICLE_INFO_LIFETIME 21
+
+struct ParticleMaterial {
+    const Gfx *begin;
+    const Gfx *quad;
+    const Gfx *end;
+    u8 layer;
+    u8 usesOpacity; // Drawn with the particle's opacity as the env alpha, so invisible at 0
+};
+
+static const struct ParticleMaterial sParticleMaterials[PARTICLE_MATERIAL_COUNT] = {
+    [PARTICLE_MATERIAL_MIST] = { mist_seg3_dl_particle_begin, mist_seg3_dl_particle_quad, mist_seg3_dl_particle_end, LAYER_TRANSPARENT,              TRUE  },
+    [PARTICLE_MATERIAL_SAND] = { sand_seg3_dl_particle_begin, sand_seg3_dl_particle_quad, sand_seg3_dl_particle_end, LAYER_OCCLUDE_SILHOUETTE_ALPHA, FALSE },
+    [PARTICLE_MATERIAL_SNOW] = { white_particle_dl_begin,     white_particle_dl_quad,     white_particle_dl_end,     LAYER_OCCLUDE_SILHOUETTE_ALPHA, FALSE },
+};
+
+// Live particles, in the order they were spawned
+static struct Particle sParticles[PARTICLE_POOL_CAPACITY];
+static u32 sNumParticles = 0;
+
+/**
+ * The material that draws the same as the given model, or PARTICLE_MATERIAL_NONE if there isn't one.
+ */
+s32 particle_material_for_model(ModelID16 model) {
+    switch (model) {
+        case MODEL_MIST:              return PARTICLE_MATERIAL_MIST;
+        case MODEL_SAND_DUST:         return PARTICLE_MATERIAL_SAND;
+        case MODEL_WHITE_PARTICLE_DL: return PARTICLE_MATERIAL_SNOW;
+        default:                      return PARTICLE_MATERIAL_NONE;
+    }
+}
+
+/**
+ * Spawn a particle at the source object's position and in its area. It starts still, unscaled, without
+ * an opacity and lasting for as long as a u8 timer can count. Returns NULL if the pool is full.
+ */
+struct Particle *spawn_particle_from_object(struct Object *source, s32 material) {
+    struct Particle *particle;
+
+    if (sNumParticles >= PARTICLE_POOL_CAPACITY) {
+        return NULL;
+    }
+
+    particle = &sParticles[sNumParticles++];
+    vec3f_copy(particle->pos, &source->oPosVec);
+    vec3_zero(particle->vel);
+    particle->scale = 1.0f;
+    particle->baseScale = 1.0f;
+    particle->gravity = 0.0f;
+    particle->dragStrength = 0.0f;
+    particle->opacity = 0;
+    particle->opacityStep = 0;
+    particle->flags = 0;
+    particle->timer = 0;
+    particle->lifetime = 0xFF;
+    particle->material = material;
+    particle->areaIndex = source->header.gfx.areaIndex;
+
+    return particle;
+}
+
+/**
+ * Spawn the particles of a SpawnParticlesInfo as cur_obj_spawn_particles would have spawned objects, using
+ * the same random numbers in the same order. Returns FALSE without spawning any if the model has no material.
+ */
+s32 spawn_particles_from_info(struct Object *source, struct SpawnParticlesInfo *info) {
+    s32 material = particle_material_for_model(info->model);
+    s32 i;
+
+    if (material == PARTICLE_MATERIAL_NONE) {
+        return FALSE;
+    }
+
+    for (i = 0; i < info->count; i++) {
+        struct Particle *particle;
+        f32 scale;
+        s16 yaw;
+        f32 forwardVel;
+
+        if (sNumParticles >= PARTICLE_POOL_CAPACITY) {
+            break;
+        }
+
+        scale = random_float() * (info->sizeRange * 0.1f) + info->sizeBase * 0.1f;
+        particle = spawn_particle_from_object(source, material);
+
+        yaw = random_u16();
+        particle->pos[1] += info->offsetY;
+        forwardVel = random_float() * info->forwardVelRange + info->forwardVelBase;
+        particle->vel[0] = forwardVel * sins(yaw);
+        particle->vel[1] = random_float() * info->velYRange + info->velYBase;
+        particle->vel[2] = forwardVel * coss(yaw);
+        particle->gravity = info->gravity;
+        particle->dragStrength = info->dragStrength;
+        particle->scale = scale;
+        particle->baseScale = scale;
+        particle->lifetime = PARTICLE_INFO_LIFETIME;
+
+        switch (info->behParam) {
+            case 2:
+                particle->opacity = 254;
+                particle->opacityStep = -21;
+                break;
+            case 3:
+                particle->opacity = 254;
+                particle->opacityStep = -13;
+                particle->flags |= PARTICLE_FLAG_SLOW_FADE;
+                break;
+        }
+    }
+
+    return TRUE;
+}
+
+/**
+ * Move and fade a particle for a frame. Returns FALSE once it should disappear.
+ */
+static s32 update_particle(struct Particle *particle) {
+    particle->vel[1] += particle->gravity;
+    vec3f_add(particle->pos, particle->vel);
+    apply_drag_to_value(&particle->vel[0], particle->dragStrength);
+    apply_drag_to_value(&particle->vel[2], particle->dragStrength);
+
+    if (particle->vel[1] > 100.0f) {
+        particle->vel[1] = 100.0f;
+    }
+
+    if (particle->timer >= particle->lifetime) {
+        return FALSE;
+    }
+
+    if (particle->opacity != 0) {
+        particle->opacity += particle->opacityStep;
+        if (particle->opacity < 2) {
+            return FALSE;
+        }
+
+        if (particle->flags & PARTICLE_FLAG_SLOW_FADE) {
+            particle->scale = particle->baseScale * ((254 - particle->opacity) / 254.0f);
+        } else {
+            particle->scale = particle->baseScale * (particle->opacity / 254.0f);
+        }
+    }
+
+    particle->timer++;
+    return TRUE;
+}
+
+/**
+ * Update every particle, keeping the rest in spawn order as ones disappear. Called by update_objects once
+ * the objects have updated, so particles spawned this frame move before they're first drawn like objects would.
+ * Not called during time stop, so particles stay frozen along with the objects.
+ */
+void update_particles(void) {
+    u32 numKept = 0;
+    u32 i;
+
+    for (i = 0; i < sNumParticles; i++) {
+        if (update_particle(&sParticles[i])) {
+            if (numKept != i) {
+                sParticles[numKept] = sParticles[i];
+            }
+            numKept++;
+        }
+    }
+
+    sNumParticles = numKept;
+}
+
+void clear_particles(void) {
+    sNumParticles = 0;
+}
+
+/**
+ * Remove the particles in the given area, along with its objects.
+ */
+void unload_particles_from_area(s32 areaIndex) {
+    u32 numKept = 0;
+    u32 i;
+
+    for (i = 0; i < sNumParticles; i++) {
+        if (sParticles[i].areaIndex != areaIndex) {
+            sParticles[numKept++] = sParticles[i];
+        }
+    }
+
+    sNumParticles = numKept;
+}
+
+static s32 particle_is_visible(struct Particle *particle, s32 areaIndex) {
+    return (particle->areaIndex == areaIndex
+            && !(sParticleMaterials[particle->material].usesOpacity && particle->opacity == 0));
+}
+
+/**
+ * Draw the particles in the area being rendered, facing the camera. Called by geo_process_object_parent
+ * with the matrix the objects are drawn relative to. The billboard rotation is the same for all of them,
+ * so it's only worked out once, and each material's particles go into a single display list.
+ */
+void render_particles(Mat4 parentMtx, s16 roll, s32 areaIndex) {
+    u32 counts[PARTICLE_MATERIAL_COUNT] = { 0 };
+    Mat4 billboard;
+    Mat4 mtxf;
+    u32 i;
+    s32 material;
+
+    for (i = 0; i < sNumParticles; i++) {
+        if (particle_is_visible(&sParticles[i], areaIndex)) {
+            counts[sParticles[i].material]++;
+        }
+    }
+
+    mtxf_billboard(billboard, parentMtx, gVec3fZero, gVec3fOne, roll);
+    mtxf_copy(mtxf, billboard);
+
+    for (material = 0; material < PARTICLE_MATERIAL_COUNT; material++) {
+        const struct ParticleMaterial *info = &sParticleMaterials[material];
+        u32 count = counts[material];
+
+        if (count == 0) {
+            continue;
+        }
+
+        // The material, each particle's matrix, opacity and quad, then the material's reset
+        Mtx *mtx = alloc_display_list(count * sizeof(Mtx));
+        Gfx *dlStart = alloc_display_list((3 + count * (info->usesOpacity ? 3 : 2)) * sizeof(Gfx));
+        if (mtx == NULL || dlStart == NULL) {
+            return;
+        }
+        Gfx *dlHead = dlStart;
+
+        gSPDisplayList(dlHead++, info->begin);
+        for (i = 0; i < sNumParticles; i++) {
+            struct Particle *particle = &sParticles[i];
+            s32 j;
+
+            if (particle->material != material || !particle_is_visible(particle, areaIndex)) {
+                continue;
+            }
+
+            for (j = 0; j < 3; j++) {
+                mtxf[0][j] = billboard[0][j] * particle->scale;
+                mtxf[1][j] = billboard[1][j] * particle->scale;
+                mtxf[2][j] = billboard[2][j] * particle->scale;
+            }
+            vec3f_sum(mtxf[3], particle->pos, parentMtx[3]);
+            mtxf_to_mtx(mtx, mtxf);
+
+            gSPMatrix(dlHead++, VIRTUAL_TO_PHYSICAL(mtx), (G_MTX_MODELVIEW | G_MTX_LOAD | G_MTX_NOPUSH));
+            if (info->usesOpacity) {
+                gDPSetEnvColor(dlHead++, 255, 255, 255, particle->opacity);
+            }
+            gSPDisplayList(dlHead++, info->quad);
+            mtx++;
+        }
+        gSPDisplayList(dlHead++, info->end);
+        gSPEndDisplayList(dlHead);
+
+        geo_append_display_list_with_matrices(dlStart, info->layer);
+    }
+}
+
+#endif // PARTICLE_SYSTEM
@@ -0,0 +1,53 @@
+#ifndef PARTICLE_SYSTEM_H
+#define PARTICLE_SYSTEM_H
+
+#include <PR/ultratypes.h>
+
+#include "config.h"
+#include "types.h"
+#include "object_helpers.h"
+
+enum ParticleMaterials {
+    PARTICLE_MATERIAL_MIST,
+    PARTICLE_MATERIAL_SAND,
+    PARTICLE_MATERIAL_SNOW,
+    PARTICLE_MATERIAL_COUNT,
+    PARTICLE_MATERIAL_NONE = 0xFF,
+};
+
+enum ParticleFlags {
+    PARTICLE_FLAG_SLOW_FADE = (1 << 0), // Grow as it fades, instead of shrinking
+};
+
+/**
+ * A particle that only moves, fades and disappears. Set up like the objects that bhvWhitePuffExplosion
+ * runs on: it moves by its velocity and gravity, slows down by its drag, and if it has an opacity, fades by
+ * opacityStep each frame while its scale follows. It disappears once its timer reaches its lifetime.
+ */
+struct Particle {
+    /*0x00*/ Vec3f pos;
+    /*0x0C*/ Vec3f vel;
+    /*0x18*/ f32 scale;
+    /*0x1C*/ f32 baseScale;
+    /*0x20*/ f32 gravity;
+    /*0x24*/ f32 dragStrength;
+    /*0x28*/ s16 opacity;
+    /*0x2A*/ s8 opacityStep;
+    /*0x2B*/ u8 flags;
+    /*0x2C*/ u8 timer;
+    /*0x2D*/ u8 lifetime;
+    /*0x2E*/ u8 material;
+    /*0x2F*/ s8 areaIndex;
+}; /*0x30*/
+
+#ifdef PARTICLE_SYSTEM
+s32 particle_material_for_model(ModelID16 model);
+struct Particle *spawn_particle_from_object(struct Object *source, s32 material);
+s32 spawn_particles_from_info(struct Object *source, struct SpawnParticlesInfo *info);
+void update_particles(void);
+void clear_particles(void);
+void unload_particles_from_area(s32 areaIndex);
+void render_particles(Mat4 parentMtx, s16 roll, s32 areaIndex);
+#endif
+
+#endif // PARTICLE_SYSTEM_H
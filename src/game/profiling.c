@@ -5,12 +5,21 @@
 #include "profiling.h"
 #include "fasttext.h"
 #include "puppyprint.h"
+#ifdef PROFILER_CAPTURE
+#include <string.h>
+#include "usb/debug.h"
+#endif
+#if defined(PROFILER_CAPTURE) || defined(PROFILER_BEHAVIORS)
+#include "object_list_processor.h"
+#endif
 
 #ifdef USE_PROFILER
 
 #define RDP_CYCLE_CONV(x) ((10 * (x)) / 625) // 62.5 million cycles per frame
 
 ProfileTimeData all_profiling_data[PROFILER_TIME_COUNT];
+ProfileTimeData all_profiling_counts[PROFILER_COUNT_COUNT];
+u32 profiler_frame_counts[PROFILER_COUNT_COUNT];
 
 int profile_buffer_index = -1;
 int rsp_buffer_indices[PROFILER_RSP_COUNT];
@@ -23,6 +32,10 @@ u32 audio_start;
 u32 audio_buffer_index;
 u32 preempted_time;
 u32 collision_time = 0;
+#if defined(PROFILER_SCOPES) || defined(PROFILER_BEHAVIORS)
+// Audio time that has preempted the game thread in total, subtracted from the scopes and objects it interrupted
+u32 game_preempted_time = 0;
+#endif
 
 #ifdef AUDIO_PROFILING
 u32 audio_subset_starts[AUDIO_SUBSET_SIZE];
@@ -126,6 +139,9 @@ void profiler_audio_completed() {
     u32 cur_index = audio_buffer_index;
 
     preempted_time = time - audio_start;
+#if defined(PROFILER_SCOPES) || defined(PROFILER_BEHAVIORS)
+    game_preempted_time += time - audio_start;
+#endif
     buffer_update(cur_data, time - audio_start, cur_index);
 
 #ifdef AUDIO_PROFILING
@@ -167,6 +183,18 @@ extern u8 sPPDebugPage;
 extern u8 fDebug;
 #endif
 
+static void update_counts() {
+    for (int i = 0; i < PROFILER_COUNT_COUNT; i++) {
+        buffer_update(&all_profiling_counts[i], profiler_frame_counts[i], profile_buffer_index);
+        profiler_frame_counts[i] = 0;
+    }
+}
+
+// Average per frame
+u32 profiler_get_count(enum ProfilerCount which) {
+    return all_profiling_counts[which].total / PROFILING_BUFFER_SIZE;
+}
+
 static void update_rdp_timers() {
     u32 tmem = IO_READ(DPC_TMEM_REG);
     u32 cmd =  IO_READ(DPC_BUFBUSY_REG);
@@ -181,6 +209,504 @@ static void update_rdp_timers() {
     buffer_update(&all_profiling_data[PROFILER_TIME_PIPE], pipe, profile_buffer_index);
 }
 
+// The index of the last entry written to a buffer, given the index of the next one
+static int last_buffer_index(int next_index) {
+    return (next_index + PROFILING_BUFFER_SIZE - 1) % PROFILING_BUFFER_SIZE;
+}
+
+#ifdef PROFILER_CAPTURE
+/**
+ * Per-frame capture over USB, decoded by tools/profiler_capture.py. Everything is big endian.
+ *
+ * Every packet starts with a ProfilerCapturePacket. Each capture starts with a header packet, which
+ * lists a u8 unit followed by a null terminated name for each field. It's followed by frame packets,
+ * which hold each frame's gGlobalTimer as a u32 and a u16 for each field, padded to 4 bytes.
+ * Field names use ';' to nest timings under another field, like flame graphs.
+ */
+#define PROFILER_CAPTURE_HEADER_MAGIC 0x50435031 // "PCP1", the last character is the format version
+#define PROFILER_CAPTURE_FRAMES_MAGIC 0x5046524D // "PFRM"
+
+// Frames sent in each packet
+#define PROFILER_CAPTURE_BATCH 32
+
+enum ProfilerCaptureUnit {
+    CAPTURE_UNIT_MICROSECONDS,
+    CAPTURE_UNIT_COUNT,
+};
+
+enum ProfilerCaptureSource {
+    CAPTURE_SOURCE_CPU,     // A ProfilerTime of the main thread
+    CAPTURE_SOURCE_RSP,     // The last completed task of a ProfilerRSPTime
+    CAPTURE_SOURCE_AUDIO,   // The last audio update
+    CAPTURE_SOURCE_RDP,     // An RDP counter
+    CAPTURE_SOURCE_COUNT,   // A ProfilerCount
+    CAPTURE_SOURCE_OBJECTS, // Number of active objects
+    CAPTURE_SOURCE_FLUSH,   // Time spent sending the last packet
+};
+
+struct ProfilerCaptureField {
+    const char *name;
+    u8 unit;
+    u8 source;
+    u8 index;
+};
+
+static const struct ProfilerCaptureField sCaptureFields[] = {
+    { "frame",                      CAPTURE_UNIT_MICROSECONDS, CAPTURE_SOURCE_CPU,     PROFILER_TIME_FPS                   },
+    { "cpu",                        CAPTURE_UNIT_MICROSECONDS, CAPTURE_SOURCE_CPU,     PROFILER_TIME_TOTAL                 },
+    { "cpu;input",                  CAPTURE_UNIT_MICROSECONDS, CAPTURE_SOURCE_CPU,     PROFILER_TIME_CONTROLLERS           },
+    { "cpu;spawner",                CAPTURE_UNIT_MICROSECONDS, CAPTURE_SOURCE_CPU,     PROFILER_TIME_SPAWNER               },
+    { "cpu;dynamic",                CAPTURE_UNIT_MICROSECONDS, CAPTURE_SOURCE_CPU,     PROFILER_TIME_DYNAMIC               },
+    { "cpu;behavior_before_mario",  CAPTURE_UNIT_MICROSECONDS, CAPTURE_SOURCE_CPU,     PROFILER_TIME_BEHAVIOR_BEFORE_MARIO },
+    { "cpu;mario",                  CAPTURE_UNIT_MICROSECONDS, CAPTURE_SOURCE_CPU,     PROFILER_TIME_MARIO                 },
+    { "cpu;behavior_after_mario",   CAPTURE_UNIT_MICROSECONDS, CAPTURE_SOURCE_CPU,     PROFILER_TIME_BEHAVIOR_AFTER_MARIO  },
+    { "cpu;graph",                  CAPTURE_UNIT_MICROSECONDS, CAPTURE_SOURCE_CPU,     PROFILER_TIME_GFX                   },
+#ifdef PUPPYPRINT_DEBUG
+    { "cpu;collision",              CAPTURE_UNIT_MICROSECONDS, CAPTURE_SOURCE_CPU,     PROFILER_TIME_COLLISION             },
+    { "cpu;camera",                 CAPTURE_UNIT_MICROSECONDS, CAPTURE_SOURCE_CPU,     PROFILER_TIME_CAMERA                },
+#endif
+    { "audio",                      CAPTURE_UNIT_MICROSECONDS, CAPTURE_SOURCE_AUDIO,   0                                   },
+    { "rsp;gfx",                    CAPTURE_UNIT_MICROSECONDS, CAPTURE_SOURCE_RSP,     PROFILER_RSP_GFX                    },
+    { "rsp;audio",                  CAPTURE_UNIT_MICROSECONDS, CAPTURE_SOURCE_RSP,     PROFILER_RSP_AUDIO                  },
+    { "rdp_tmem",                   CAPTURE_UNIT_MICROSECONDS, CAPTURE_SOURCE_RDP,     PROFILER_TIME_TMEM                  },
+    { "rdp_cmd",                    CAPTURE_UNIT_MICROSECONDS, CAPTURE_SOURCE_RDP,     PROFILER_TIME_CMD                   },
+    { "rdp_pipe",                   CAPTURE_UNIT_MICROSECONDS, CAPTURE_SOURCE_RDP,     PROFILER_TIME_PIPE                  },
+    { "objects",                    CAPTURE_UNIT_COUNT,        CAPTURE_SOURCE_OBJECTS, 0                                   },
+    { "raycasts",                   CAPTURE_UNIT_COUNT,        CAPTURE_SOURCE_COUNT,   PROFILER_COUNT_RAYCASTS             },
+    { "ray_triangles",              CAPTURE_UNIT_COUNT,        CAPTURE_SOURCE_COUNT,   PROFILER_COUNT_RAY_TRIANGLES        },
+    { "cull_tests",                 CAPTURE_UNIT_COUNT,        CAPTURE_SOURCE_COUNT,   PROFILER_COUNT_CULL_TESTS           },
+    { "culled",                     CAPTURE_UNIT_COUNT,        CAPTURE_SOURCE_COUNT,   PROFILER_COUNT_CULLED               },
+    { "batched_dls",                CAPTURE_UNIT_COUNT,        CAPTURE_SOURCE_COUNT,   PROFILER_COUNT_BATCHED_DLS          },
+    { "skipped_matrices",           CAPTURE_UNIT_COUNT,        CAPTURE_SOURCE_COUNT,   PROFILER_COUNT_SKIPPED_MATRICES     },
+    { "instances",                  CAPTURE_UNIT_COUNT,        CAPTURE_SOURCE_COUNT,   PROFILER_COUNT_INSTANCES            },
+    { "cached_matrices",            CAPTURE_UNIT_COUNT,        CAPTURE_SOURCE_COUNT,   PROFILER_COUNT_CACHED_MATRICES      },
+    { "decoded_anim_frames",        CAPTURE_UNIT_COUNT,        CAPTURE_SOURCE_COUNT,   PROFILER_COUNT_DECODED_ANIM_FRAMES  },
+    { "shared_anim_frames",         CAPTURE_UNIT_COUNT,        CAPTURE_SOURCE_COUNT,   PROFILER_COUNT_SHARED_ANIM_FRAMES   },
+    { "capture",                    CAPTURE_UNIT_MICROSECONDS, CAPTURE_SOURCE_FLUSH,   0                                   },
+};
+
+#define CAPTURE_NUM_FIELDS  ARRAY_COUNT(sCaptureFields)
+#define CAPTURE_RECORD_SIZE ALIGN4(sizeof(u32) + CAPTURE_NUM_FIELDS * sizeof(u16))
+
+struct ProfilerCapturePacket {
+    u32 magic;
+    u16 numFields;
+    u16 numFrames; // 0 in the header packet
+};
+
+static u8 sCaptureBuffer[sizeof(struct ProfilerCapturePacket) + PROFILER_CAPTURE_BATCH * CAPTURE_RECORD_SIZE] ALIGNED8;
+static u32 sCaptureSize = 0;
+static u32 sCaptureFlushTime = 0;
+static u8 sCaptureActive = FALSE;
+
+static void profiler_capture_flush() {
+    if (sCaptureSize == 0) {
+        return;
+    }
+
+    u32 start = osGetCount();
+    debug_dumpbinary(sCaptureBuffer, sCaptureSize);
+    sCaptureFlushTime = osGetCount() - start;
+    sCaptureSize = 0;
+}
+
+static void profiler_capture_start() {
+    struct ProfilerCapturePacket *packet = (struct ProfilerCapturePacket *) sCaptureBuffer;
+    packet->magic = PROFILER_CAPTURE_HEADER_MAGIC;
+    packet->numFields = CAPTURE_NUM_FIELDS;
+    packet->numFrames = 0;
+    sCaptureSize = sizeof(struct ProfilerCapturePacket);
+
+    for (int i = 0; i < CAPTURE_NUM_FIELDS; i++) {
+        u32 length = strlen(sCaptureFields[i].name) + 1;
+        sCaptureBuffer[sCaptureSize++] = sCaptureFields[i].unit;
+        memcpy(&sCaptureBuffer[sCaptureSize], sCaptureFields[i].name, length);
+        sCaptureSize += length;
+    }
+    sCaptureSize = ALIGN4(sCaptureSize);
+
+    profiler_capture_flush();
+    sCaptureFlushTime = 0;
+    sCaptureActive = TRUE;
+}
+
+static void profiler_capture_stop() {
+    profiler_capture_flush();
+    sCaptureActive = FALSE;
+}
+
+static u32 profiler_capture_value(const struct ProfilerCaptureField *field) {
+    switch (field->source) {
+        case CAPTURE_SOURCE_CPU:
+            return OS_CYCLES_TO_USEC(all_profiling_data[field->index].counts[profile_buffer_index]);
+        case CAPTURE_SOURCE_RSP:
+            return OS_CYCLES_TO_USEC(all_profiling_data[PROFILER_TIME_RSP_GFX + field->index].counts[last_buffer_index(rsp_buffer_indices[field->index])]);
+        case CAPTURE_SOURCE_AUDIO:
+            return OS_CYCLES_TO_USEC(all_profiling_data[PROFILER_TIME_AUDIO].counts[last_buffer_index(audio_buffer_index)]);
+        case CAPTURE_SOURCE_RDP:
+            return RDP_CYCLE_CONV(all_profiling_data[field->index].counts[profile_buffer_index]);
+        case CAPTURE_SOURCE_COUNT:
+            return all_profiling_counts[field->index].counts[profile_buffer_index];
+        case CAPTURE_SOURCE_OBJECTS:
+            return gObjectCounter;
+        case CAPTURE_SOURCE_FLUSH:
+            return OS_CYCLES_TO_USEC(sCaptureFlushTime);
+    }
+    return 0;
+}
+
+/**
+ * Add the frame that just ended to the capture, sending the packet once it's full.
+ */
+static void profiler_capture_frame() {
+    struct ProfilerCapturePacket *packet = (struct ProfilerCapturePacket *) sCaptureBuffer;
+
+    if (sCaptureSize == 0) {
+        packet->magic = PROFILER_CAPTURE_FRAMES_MAGIC;
+        packet->numFields = CAPTURE_NUM_FIELDS;
+        packet->numFrames = 0;
+        sCaptureSize = sizeof(struct ProfilerCapturePacket);
+    }
+
+    u8 *record = &sCaptureBuffer[sCaptureSize];
+    u16 *values = (u16 *) (record + sizeof(u32));
+    *(u32 *) record = gGlobalTimer;
+
+    for (int i = 0; i < CAPTURE_NUM_FIELDS; i++) {
+        values[i] = MIN(profiler_capture_value(&sCaptureFields[i]), 0xFFFF);
+    }
+
+    sCaptureFlushTime = 0;
+    sCaptureSize += CAPTURE_RECORD_SIZE;
+    packet->numFrames++;
+
+    if (packet->numFrames >= PROFILER_CAPTURE_BATCH) {
+        profiler_capture_flush();
+    }
+}
+#endif
+
+#ifdef PROFILER_SCOPES
+struct ProfilerScope gProfilerScopes[PROFILER_SCOPE_MAX_NODES];
+u32 gNumProfilerScopes = 0;
+u32 gNumDroppedProfilerScopes = 0;
+
+struct ProfilerScopeStackEntry {
+    u8 node;
+    u32 start;
+    u32 preempted;  // game_preempted_time when the scope began
+    u32 children;   // Inclusive time of the scopes directly inside this one
+};
+
+static struct ProfilerScopeStackEntry sScopeStack[PROFILER_SCOPE_MAX_DEPTH];
+static s32 sScopeDepth = 0;
+// Scopes that were begun while the stack was full or the nodes ran out, and haven't ended yet
+static u32 sScopesDropped = 0;
+static int scope_buffer_index = 0;
+
+static u8 profiler_scope_find_or_add(u8 parent, const char *name) {
+    struct ProfilerScope *scope;
+    u8 index = gProfilerScopes[parent].firstChild;
+    u8 prev = PROFILER_SCOPE_NONE;
+
+    while (index != PROFILER_SCOPE_NONE) {
+        if (gProfilerScopes[index].name == name) {
+            return index;
+        }
+        prev = index;
+        index = gProfilerScopes[index].nextSibling;
+    }
+
+    if (gNumProfilerScopes >= PROFILER_SCOPE_MAX_NODES) {
+        return PROFILER_SCOPE_NONE;
+    }
+
+    index = gNumProfilerScopes++;
+    scope = &gProfilerScopes[index];
+    bzero(scope, sizeof(*scope));
+    scope->name = name;
+    scope->parent = parent;
+    scope->firstChild = PROFILER_SCOPE_NONE;
+    scope->nextSibling = PROFILER_SCOPE_NONE;
+    scope->depth = gProfilerScopes[parent].depth + 1;
+
+    // Append, so that siblings are listed in the order they first ran.
+    if (prev == PROFILER_SCOPE_NONE) {
+        gProfilerScopes[parent].firstChild = index;
+    } else {
+        gProfilerScopes[prev].nextSibling = index;
+    }
+    return index;
+}
+
+void profiler_scope_begin(const char *name) {
+    struct ProfilerScopeStackEntry *entry;
+    u8 node;
+
+    // Also drops scopes outside of the game loop, before the frame's scope begins.
+    if (sScopesDropped > 0 || sScopeDepth == 0 || sScopeDepth >= PROFILER_SCOPE_MAX_DEPTH) {
+        sScopesDropped++;
+        gNumDroppedProfilerScopes++;
+        return;
+    }
+
+    node = profiler_scope_find_or_add(sScopeStack[sScopeDepth - 1].node, name);
+    if (node == PROFILER_SCOPE_NONE) {
+        sScopesDropped++;
+        gNumDroppedProfilerScopes++;
+        return;
+    }
+
+    entry = &sScopeStack[sScopeDepth++];
+    entry->node = node;
+    entry->children = 0;
+    entry->preempted = game_preempted_time;
+    entry->start = osGetCount();
+}
+
+// Add the time of the innermost scope to its node and to its parent's children.
+static void profiler_scope_pop(u32 time) {
+    struct ProfilerScopeStackEntry *entry = &sScopeStack[--sScopeDepth];
+    struct ProfilerScope *scope = &gProfilerScopes[entry->node];
+    u32 elapsed = time - entry->start - (game_preempted_time - entry->preempted);
+
+    scope->inclusive += elapsed;
+    scope->self += elapsed - entry->children;
+    scope->calls++;
+    if (sScopeDepth > 0) {
+        sScopeStack[sScopeDepth - 1].children += elapsed;
+    }
+}
+
+void profiler_scope_end(void) {
+    u32 time = osGetCount();
+
+    // A dropped scope's time is left in its parent's self time.
+    if (sScopesDropped > 0) {
+        sScopesDropped--;
+        return;
+    }
+    // Only the frame is left, so this doesn't match any begin.
+    if (sScopeDepth <= 1) {
+        return;
+    }
+    profiler_scope_pop(time);
+}
+
+/**
+ * End the frame's scope, then save every scope's times for this frame into their buffers.
+ */
+static void profiler_scopes_frame_end() {
+    struct ProfilerScope *scope;
+    u32 time = osGetCount();
+
+    // Close anything left open too, so that one missing end doesn't break the whole tree.
+    sScopesDropped = 0;
+    while (sScopeDepth > 0) {
+        profiler_scope_pop(time);
+    }
+
+    for (int i = 0; i < (int) gNumProfilerScopes; i++) {
+        scope = &gProfilerScopes[i];
+        scope->inclusiveTotal += scope->inclusive - scope->inclusiveTimes[scope_buffer_index];
+        scope->selfTotal += scope->self - scope->selfTimes[scope_buffer_index];
+        scope->inclusiveTimes[scope_buffer_index] = scope->inclusive;
+        scope->selfTimes[scope_buffer_index] = scope->self;
+
+        scope->inclusiveMax = 0;
+        for (int j = 0; j < PROFILER_SCOPE_BUFFER_SIZE; j++) {
+            scope->inclusiveMax = MAX(scope->inclusiveMax, scope->inclusiveTimes[j]);
+        }
+
+        scope->lastCalls = scope->calls;
+        scope->calls = 0;
+        scope->inclusive = 0;
+        scope->self = 0;
+    }
+
+    scope_buffer_index++;
+    if (scope_buffer_index >= PROFILER_SCOPE_BUFFER_SIZE) {
+        scope_buffer_index = 0;
+    }
+}
+
+/**
+ * Begin the scope for the whole frame, which every other scope is nested in.
+ */
+static void profiler_scopes_frame_begin() {
+    if (gNumProfilerScopes == 0) {
+        bzero(&gProfilerScopes[0], sizeof(gProfilerScopes[0]));
+        gProfilerScopes[0].name = "Frame";
+        gProfilerScopes[0].parent = PROFILER_SCOPE_NONE;
+        gProfilerScopes[0].firstChild = PROFILER_SCOPE_NONE;
+        gProfilerScopes[0].nextSibling = PROFILER_SCOPE_NONE;
+        gNumProfilerScopes = 1;
+    }
+
+    sScopeStack[0].node = 0;
+    sScopeStack[0].children = 0;
+    sScopeStack[0].preempted = game_preempted_time;
+    sScopeStack[0].start = osGetCount();
+    sScopeDepth = 1;
+}
+#endif
+
+#ifdef PROFILER_BEHAVIORS
+struct ProfilerBehaviorCost gProfilerBehaviors[PROFILER_BEHAVIOR_MAX_ENTRIES];
+struct ProfilerBehaviorCost gProfilerObjectLists[NUM_OBJ_LISTS];
+u32 gNumDroppedProfilerBehaviors = 0;
+
+// The object being updated, and when its update began
+static struct Object *sBehaviorObject = NULL;
+static const BehaviorScript *sBehaviorScript = NULL;
+static u32 sBehaviorStart = 0;
+static u32 sBehaviorPreempted = 0;
+static int behavior_buffer_index = 0;
+
+/**
+ * Find the entry of a behavior, or add it if it's new. Returns NULL if the table is full.
+ */
+static struct ProfilerBehaviorCost *profiler_behavior_find_or_add(const BehaviorScript *behavior) {
+    u32 index = (uintptr_t) behavior >> 2;
+
+    for (int i = 0; i < PROFILER_BEHAVIOR_MAX_ENTRIES; i++) {
+        struct ProfilerBehaviorCost *entry = &gProfilerBehaviors[(index + i) & (PROFILER_BEHAVIOR_MAX_ENTRIES - 1)];
+
+        if (entry->behavior == behavior) {
+            return entry;
+        }
+        if (entry->behavior == NULL) {
+            entry->behavior = behavior;
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+void profiler_behavior_begin(struct Object *obj) {
+    sBehaviorObject = obj;
+    sBehaviorScript = obj->behavior;
+    sBehaviorPreempted = game_preempted_time;
+    sBehaviorStart = osGetCount();
+}
+
+void profiler_behavior_end(void) {
+    u32 elapsed = osGetCount() - sBehaviorStart - (game_preempted_time - sBehaviorPreempted);
+    struct ProfilerBehaviorCost *entry = profiler_behavior_find_or_add(sBehaviorScript);
+
+    if (entry != NULL) {
+        entry->time += elapsed;
+        entry->instances++;
+    } else {
+        gNumDroppedProfilerBehaviors++;
+    }
+
+    entry = &gProfilerObjectLists[sBehaviorObject->objListIndex];
+    entry->time += elapsed;
+    entry->instances++;
+}
+
+/**
+ * Forget every behavior, as the behaviors of one level are mostly not used in the next.
+ * Called when the objects are cleared.
+ */
+void profiler_behaviors_reset(void) {
+    bzero(gProfilerBehaviors, sizeof(gProfilerBehaviors));
+    bzero(gProfilerObjectLists, sizeof(gProfilerObjectLists));
+    gNumDroppedProfilerBehaviors = 0;
+}
+
+static void profiler_behavior_cost_update(struct ProfilerBehaviorCost *entry) {
+    entry->timeTotal += entry->time - entry->times[behavior_buffer_index];
+    entry->instanceTotal += entry->instances - entry->instanceCounts[behavior_buffer_index];
+    entry->times[behavior_buffer_index] = entry->time;
+    entry->instanceCounts[behavior_buffer_index] = entry->instances;
+
+    entry->lastInstances = entry->instances;
+    entry->time = 0;
+    entry->instances = 0;
+}
+
+// Average cycles per object over the buffer, or per frame in total
+u32 profiler_behavior_cost(struct ProfilerBehaviorCost *entry, s32 perObject) {
+    if (perObject) {
+        return (entry->instanceTotal > 0) ? (entry->timeTotal / entry->instanceTotal) : 0;
+    }
+    return entry->timeTotal / PROFILER_BEHAVIOR_BUFFER_SIZE;
+}
+
+/**
+ * Fill indices with the behaviors that ran recently, the most expensive in total or per object first.
+ * Returns how many there are.
+ */
+s32 profiler_behaviors_sort(u8 *indices, s32 perObject) {
+    s32 count = 0;
+
+    for (int i = 0; i < PROFILER_BEHAVIOR_MAX_ENTRIES; i++) {
+        if (gProfilerBehaviors[i].timeTotal == 0) {
+            continue;
+        }
+        u32 cost = profiler_behavior_cost(&gProfilerBehaviors[i], perObject);
+        s32 j = count++;
+        while (j > 0 && profiler_behavior_cost(&gProfilerBehaviors[indices[j - 1]], perObject) < cost) {
+            indices[j] = indices[j - 1];
+            j--;
+        }
+        indices[j] = i;
+    }
+
+    return count;
+}
+
+/**
+ * Print every behavior's and object list's average costs over USB, as CSV.
+ */
+void profiler_behaviors_dump(void) {
+    u8 indices[PROFILER_BEHAVIOR_MAX_ENTRIES];
+    s32 count = profiler_behaviors_sort(indices, FALSE);
+
+    osSyncPrintf("behavior_costs: %d frames, " PP_CYCLE_STRING "\n", PROFILER_BEHAVIOR_BUFFER_SIZE);
+    osSyncPrintf("behavior,objects,total,per_object\n");
+    for (s32 i = 0; i < count; i++) {
+        struct ProfilerBehaviorCost *entry = &gProfilerBehaviors[indices[i]];
+        osSyncPrintf("%08X,%d,%d,%d\n", (uintptr_t) entry->behavior, entry->lastInstances,
+                     PP_CYCLE_CONV(profiler_behavior_cost(entry, FALSE)), PP_CYCLE_CONV(profiler_behavior_cost(entry, TRUE)));
+    }
+
+    osSyncPrintf("list,objects,total,per_object\n");
+    for (s32 i = 0; i < NUM_OBJ_LISTS; i++) {
+        struct ProfilerBehaviorCost *entry = &gProfilerObjectLists[i];
+        osSyncPrintf("%d,%d,%d,%d\n", i, entry->lastInstances,
+                     PP_CYCLE_CONV(profiler_behavior_cost(entry, FALSE)), PP_CYCLE_CONV(profiler_behavior_cost(entry, TRUE)));
+    }
+
+    if (gNumDroppedProfilerBehaviors > 0) {
+        osSyncPrintf("behavior_costs: %d objects dropped\n", gNumDroppedProfilerBehaviors);
+    }
+}
+
+/**
+ * Save every behavior's and object list's times for this frame into their buffers.
+ */
+static void profiler_behaviors_frame_end() {
+    for (int i = 0; i < PROFILER_BEHAVIOR_MAX_ENTRIES; i++) {
+        if (gProfilerBehaviors[i].behavior != NULL) {
+            profiler_behavior_cost_update(&gProfilerBehaviors[i]);
+        }
+    }
+
+    for (int i = 0; i < NUM_OBJ_LISTS; i++) {
+        profiler_behavior_cost_update(&gProfilerObjectLists[i]);
+    }
+
+    behavior_buffer_index++;
+    if (behavior_buffer_index >= PROFILER_BEHAVIOR_BUFFER_SIZE) {
+        behavior_buffer_index = 0;
+    }
+}
+#endif
+
 float profiler_get_fps() {
     return (1000000.0f * PROFILING_BUFFER_SIZE) / (OS_CYCLES_TO_USEC(all_profiling_data[PROFILER_TIME_FPS].total));
 }
@@ -229,13 +755,31 @@ u32 profiler_get_rdp_microseconds() {
     return RDP_CYCLE_CONV(rdp_max_cycles / PROFILING_BUFFER_SIZE);
 }
 
+/**
+ * The times of the frame that was just completed, in microseconds, rather than the averages of the functions above.
+ * Must be called before profiler_frame_setup starts the next frame.
+ */
+void profiler_get_frame_microseconds(ProfilerFrameTimes *times) {
+    u32 rdp_max_cycles = MAX(MAX(all_profiling_data[PROFILER_TIME_PIPE].counts[profile_buffer_index],
+                                 all_profiling_data[PROFILER_TIME_TMEM].counts[profile_buffer_index]),
+                                 all_profiling_data[PROFILER_TIME_CMD].counts[profile_buffer_index]);
+    u32 audio_time = all_profiling_data[PROFILER_TIME_AUDIO].counts[last_buffer_index(audio_buffer_index)];
+
+    times->frame = OS_CYCLES_TO_USEC(all_profiling_data[PROFILER_TIME_FPS].counts[profile_buffer_index]);
+    times->cpu = OS_CYCLES_TO_USEC(all_profiling_data[PROFILER_TIME_TOTAL].counts[profile_buffer_index] + audio_time * 2);
+    times->rsp = OS_CYCLES_TO_USEC(all_profiling_data[PROFILER_TIME_RSP_GFX].counts[last_buffer_index(rsp_buffer_indices[PROFILER_RSP_GFX])]
+                                 + all_profiling_data[PROFILER_TIME_RSP_AUDIO].counts[last_buffer_index(rsp_buffer_indices[PROFILER_RSP_AUDIO])]);
+    times->rdp = RDP_CYCLE_CONV(rdp_max_cycles);
+}
+
 void profiler_print_times() {
     u32 microseconds[PROFILER_TIME_COUNT];
-    char text_buffer[196];
+    char text_buffer[320];
 
     update_fps_timer();
     update_total_timer();
     update_rdp_timers();
+    update_counts();
 
 #ifndef PUPPYPRINT_DEBUG
     static u8 show_profiler = 0;
@@ -244,6 +788,17 @@ void profiler_print_times() {
     }
 #endif
 
+#ifdef PROFILER_CAPTURE
+    // Clear of L and the D-pad, which PUPPYPRINT_DEBUG uses for its menu.
+    if ((gPlayer1Controller->buttonPressed & D_CBUTTONS) && (gPlayer1Controller->buttonDown & (R_TRIG | Z_TRIG)) == (R_TRIG | Z_TRIG)) {
+        if (sCaptureActive) {
+            profiler_capture_stop();
+        } else {
+            profiler_capture_start();
+        }
+    }
+#endif
+
 #ifdef PUPPYPRINT_DEBUG
     if (fDebug && sPPDebugPage == PUPPYPRINT_PAGE_PROFILER) {
 #else
@@ -287,7 +842,10 @@ void profiler_print_times() {
             "\n"
             "RSP\t\t%d (%d%%)\n"
             " Gfx\t\t\t%d\n"
-            " Audio\t\t\t%d\n",
+            " Audio\t\t\t%d\n"
+            "\n"
+            "Rays\t\t\t%d\n"
+            " Triangles\t\t%d\n",
             1000000.0f / microseconds[PROFILER_TIME_FPS],
             total_cpu, total_cpu / 333, 
             microseconds[PROFILER_TIME_CONTROLLERS],
@@ -309,7 +867,9 @@ void profiler_print_times() {
             microseconds[PROFILER_TIME_PIPE],
             total_rsp, total_rsp / 333,
             microseconds[PROFILER_TIME_RSP_GFX],
-            microseconds[PROFILER_TIME_RSP_AUDIO] * 2
+            microseconds[PROFILER_TIME_RSP_AUDIO] * 2,
+            profiler_get_count(PROFILER_COUNT_RAYCASTS),
+            profiler_get_count(PROFILER_COUNT_RAY_TRIANGLES)
         );
 
         Gfx* dlHead = gDisplayListHead;
@@ -320,11 +880,47 @@ void profiler_print_times() {
         gDPSetTextureFilter(dlHead++, G_TF_POINT);
         gDPSetTextureLUT(dlHead++, G_TT_NONE);
         drawSmallStringCol(&dlHead, 10, 8, text_buffer, 255, 255, 255);
+
+        // The rendering counts go in a second column, as the first one already reaches the bottom of the screen.
+        sprintf(text_buffer,
+            "Culled\t\t%d / %d\n"
+            "Batched\t\t%d\n"
+            " Mtx skipped\t%d\n"
+            " Instanced\t%d\n"
+            "Mtx cached\t%d\n"
+            "Anim decoded\t%d\n"
+            " Shared\t\t%d\n",
+            profiler_get_count(PROFILER_COUNT_CULLED),
+            profiler_get_count(PROFILER_COUNT_CULL_TESTS),
+            profiler_get_count(PROFILER_COUNT_BATCHED_DLS),
+            profiler_get_count(PROFILER_COUNT_SKIPPED_MATRICES),
+            profiler_get_count(PROFILER_COUNT_INSTANCES),
+            profiler_get_count(PROFILER_COUNT_CACHED_MATRICES),
+            profiler_get_count(PROFILER_COUNT_DECODED_ANIM_FRAMES),
+            profiler_get_count(PROFILER_COUNT_SHARED_ANIM_FRAMES)
+        );
+        drawSmallStringCol(&dlHead, 170, 8, text_buffer, 255, 255, 255);
         gDisplayListHead = dlHead;
     }
 }
 
 void profiler_frame_setup() {
+#ifdef PROFILER_CAPTURE
+    if (sCaptureActive && profile_buffer_index >= 0) {
+        profiler_capture_frame();
+    }
+#endif
+#ifdef PROFILER_SCOPES
+    if (profile_buffer_index >= 0) {
+        profiler_scopes_frame_end();
+    }
+#endif
+#ifdef PROFILER_BEHAVIORS
+    if (profile_buffer_index >= 0) {
+        profiler_behaviors_frame_end();
+    }
+#endif
+
     profile_buffer_index++;
     preempted_time = 0;
 
@@ -333,6 +929,9 @@ void profiler_frame_setup() {
     }
 
     prev_time = cur_start = osGetCount();
+#ifdef PROFILER_SCOPES
+    profiler_scopes_frame_begin();
+#endif
 }
 
 #endif
@@ -75,6 +75,20 @@ enum ProfilerDeltaTime {
 #endif
 };
 
+enum ProfilerCount {
+    PROFILER_COUNT_RAYCASTS,
+    PROFILER_COUNT_RAY_TRIANGLES,
+    PROFILER_COUNT_CULL_TESTS,
+    PROFILER_COUNT_CULLED,
+    PROFILER_COUNT_BATCHED_DLS,
+    PROFILER_COUNT_SKIPPED_MATRICES,
+    PROFILER_COUNT_INSTANCES,
+    PROFILER_COUNT_CACHED_MATRICES,
+    PROFILER_COUNT_DECODED_ANIM_FRAMES,
+    PROFILER_COUNT_SHARED_ANIM_FRAMES,
+    PROFILER_COUNT_COUNT
+};
+
 #ifndef PUPPYPRINT_DEBUG
 #define PROFILER_TIME_PUPPYPRINT1 0
 #define PROFILER_TIME_PUPPYPRINT2 0
@@ -88,6 +102,18 @@ typedef struct {
     u32 total;
 } ProfileTimeData;
 extern ProfileTimeData all_profiling_data[PROFILER_TIME_COUNT];
+extern ProfileTimeData all_profiling_counts[PROFILER_COUNT_COUNT];
+
+typedef struct {
+    u32 frame;
+    u32 cpu;
+    u32 rsp;
+    u32 rdp;
+} ProfilerFrameTimes;
+// Counts for the current frame, added to all_profiling_counts once the frame is done
+extern u32 profiler_frame_counts[PROFILER_COUNT_COUNT];
+
+#define PROFILER_ADD_COUNT(which, amount) (profiler_frame_counts[which] += (amount))
 
 void profiler_update(enum ProfilerTime which, u32 delta);
 void profiler_print_times();
@@ -107,9 +133,11 @@ void profiler_collision_update(u32 time);
 #define profiler_collision_update(time)
 #endif
 u32 profiler_get_delta(enum ProfilerDeltaTime which);
+u32 profiler_get_count(enum ProfilerCount which);
 u32 profiler_get_cpu_microseconds();
 u32 profiler_get_rsp_microseconds();
 u32 profiler_get_rdp_microseconds();
+void profiler_get_frame_microseconds(ProfilerFrameTimes *times);
 // See profiling.c to see why profiler_rsp_yielded isn't its own function
 static ALWAYS_INLINE void profiler_rsp_yielded() {
     profiler_rsp_resumed();
@@ -119,6 +147,7 @@ static ALWAYS_INLINE void profiler_rsp_yielded() {
 #else
 #define PROFILER_GET_SNAPSHOT()
 #define PROFILER_GET_SNAPSHOT_TYPE(type)
+#define PROFILER_ADD_COUNT(which, amount)
 #define profiler_update(which, delta)
 #define profiler_print_times()
 #define profiler_frame_setup()
@@ -132,11 +161,99 @@ static ALWAYS_INLINE void profiler_rsp_yielded() {
 #define profiler_collision_completed()
 #define profiler_collision_update(time)
 #define profiler_get_delta(which) 0
+#define profiler_get_count(which) 0
 #define profiler_get_cpu_microseconds() 0
 #define profiler_get_rsp_microseconds() 0
 #define profiler_get_rdp_microseconds() 0
 #endif
 
+#ifdef PROFILER_SCOPES
+// Number of scopes that can be timed, and how deep they can be nested
+#define PROFILER_SCOPE_MAX_NODES   64
+#define PROFILER_SCOPE_MAX_DEPTH   16
+// Frames of each scope's times kept for averaging
+#define PROFILER_SCOPE_BUFFER_SIZE 16
+// No parent, child or sibling
+#define PROFILER_SCOPE_NONE        0xFF
+
+/**
+ * A named scope in the tree. A scope is identified by its name pointer and its parent, so the same
+ * name can appear under several parents. Node 0 is the whole frame.
+ */
+struct ProfilerScope {
+    const char *name;
+    u8 parent;
+    u8 firstChild;
+    u8 nextSibling;
+    u8 depth;
+    u16 calls;         // This frame
+    u16 lastCalls;     // Last frame
+    u32 inclusive;     // This frame
+    u32 self;          // This frame
+    u32 inclusiveTimes[PROFILER_SCOPE_BUFFER_SIZE];
+    u32 selfTimes[PROFILER_SCOPE_BUFFER_SIZE];
+    u32 inclusiveTotal;
+    u32 selfTotal;
+    u32 inclusiveMax;  // The highest inclusive time in the buffer
+};
+
+extern struct ProfilerScope gProfilerScopes[PROFILER_SCOPE_MAX_NODES];
+extern u32 gNumProfilerScopes;
+// Scopes that couldn't be timed because there were too many or they were nested too deep
+extern u32 gNumDroppedProfilerScopes;
+
+void profiler_scope_begin(const char *name);
+void profiler_scope_end(void);
+
+#define PROFILER_SCOPE_BEGIN(name) profiler_scope_begin(name)
+#define PROFILER_SCOPE_END() profiler_scope_end()
+#else
+#define PROFILER_SCOPE_BEGIN(name)
+#define PROFILER_SCOPE_END()
+#endif
+
+#ifdef PROFILER_BEHAVIORS
+#include "types.h"
+
+// Number of behaviors that can be timed, must be a power of two
+#define PROFILER_BEHAVIOR_MAX_ENTRIES 128
+// Frames of each behavior's times kept for averaging
+#define PROFILER_BEHAVIOR_BUFFER_SIZE 16
+
+/**
+ * The time taken to update the objects of a behavior or of an object list. Objects are counted under
+ * the behavior they had when their update began.
+ */
+struct ProfilerBehaviorCost {
+    const BehaviorScript *behavior; // NULL for the object lists
+    u32 time;                       // This frame
+    u16 instances;                  // This frame
+    u16 lastInstances;              // Last frame
+    u32 times[PROFILER_BEHAVIOR_BUFFER_SIZE];
+    u16 instanceCounts[PROFILER_BEHAVIOR_BUFFER_SIZE];
+    u32 timeTotal;
+    u32 instanceTotal;
+};
+
+extern struct ProfilerBehaviorCost gProfilerBehaviors[PROFILER_BEHAVIOR_MAX_ENTRIES];
+extern struct ProfilerBehaviorCost gProfilerObjectLists[];
+// Behaviors that couldn't be timed because there were too many
+extern u32 gNumDroppedProfilerBehaviors;
+
+void profiler_behavior_begin(struct Object *obj);
+void profiler_behavior_end(void);
+void profiler_behaviors_reset(void);
+u32 profiler_behavior_cost(struct ProfilerBehaviorCost *entry, s32 perObject);
+s32 profiler_behaviors_sort(u8 *indices, s32 perObject);
+void profiler_behaviors_dump(void);
+
+#define PROFILER_BEHAVIOR_BEGIN(obj) profiler_behavior_begin(obj)
+#define PROFILER_BEHAVIOR_END() profiler_behavior_end()
+#else
+#define PROFILER_BEHAVIOR_BEGIN(obj)
+#define PROFILER_BEHAVIOR_END()
+#endif
+
 #ifdef AUDIO_PROFILING
 #define AUDIO_SUBSET_SIZE PROFILER_TIME_SUB_AUDIO_END - PROFILER_TIME_SUB_AUDIO_START
 extern u32 audio_subset_starts[AUDIO_SUBSET_SIZE];
@@ -40,6 +40,7 @@ a modern game engine's developer's console.
 #include "puppyprint.h"
 #include "level_update.h"
 #include "object_list_processor.h"
+#include "spawn_object.h"
 #include "engine/surface_load.h"
 #include "audio/data.h"
 #include "audio/external.h"
@@ -283,6 +284,34 @@ void print_ram_overview(void) {
         }
         y += 12;
     }
+
+    // The gfx pools' usage, for sizing GFX_POOL_SIZE for the level.
+    y += 12;
+    sprintf(textBytes, "Gfx Pools:");
+    print_small_text_light(24, y - gPPSegScroll, textBytes, PRINT_TEXT_ALIGN_LEFT, PRINT_ALL, FONT_DEFAULT);
+    sprintf(textBytes, "0x%X", gGfxPoolStats.size * 2);
+    print_small_text_light(SCREEN_WIDTH/2, y - gPPSegScroll, textBytes, PRINT_TEXT_ALIGN_CENTRE, PRINT_ALL, FONT_DEFAULT);
+    sprintf(textBytes, "(%2.3f%%)", ((f32)(gGfxPoolStats.size * 2) / ramSize) * 100.0f);
+    print_small_text_light(SCREEN_WIDTH - 24, y - gPPSegScroll, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_DEFAULT);
+    y += 12;
+    sprintf(textBytes, "Gfx Used:");
+    print_small_text_light(24, y - gPPSegScroll, textBytes, PRINT_TEXT_ALIGN_LEFT, PRINT_ALL, FONT_DEFAULT);
+    sprintf(textBytes, "0x%X", gGfxPoolStats.used);
+    print_small_text_light(SCREEN_WIDTH/2, y - gPPSegScroll, textBytes, PRINT_TEXT_ALIGN_CENTRE, PRINT_ALL, FONT_DEFAULT);
+    sprintf(textBytes, "(%2.3f%%)", ((f32)gGfxPoolStats.used / gGfxPoolStats.size) * 100.0f);
+    print_small_text_light(SCREEN_WIDTH - 24, y - gPPSegScroll, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_DEFAULT);
+    y += 12;
+    sprintf(textBytes, "Gfx Peak:");
+    print_small_text_light(24, y - gPPSegScroll, textBytes, PRINT_TEXT_ALIGN_LEFT, PRINT_ALL, FONT_DEFAULT);
+    sprintf(textBytes, "0x%X", gGfxPoolStats.peakUsed);
+    print_small_text_light(SCREEN_WIDTH/2, y - gPPSegScroll, textBytes, PRINT_TEXT_ALIGN_CENTRE, PRINT_ALL, FONT_DEFAULT);
+    sprintf(textBytes, "(%2.3f%%)", ((f32)gGfxPoolStats.peakUsed / gGfxPoolStats.size) * 100.0f);
+    print_small_text_light(SCREEN_WIDTH - 24, y - gPPSegScroll, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_DEFAULT);
+    y += 12;
+    sprintf(textBytes, "Gfx Overflows:");
+    print_small_text_light(24, y - gPPSegScroll, textBytes, PRINT_TEXT_ALIGN_LEFT, PRINT_ALL, FONT_DEFAULT);
+    sprintf(textBytes, "%d", gGfxPoolStats.numOverflows);
+    print_small_text_light(SCREEN_WIDTH/2, y - gPPSegScroll, textBytes, PRINT_TEXT_ALIGN_CENTRE, PRINT_ALL, FONT_DEFAULT);
 }
 
 static const char *audioPoolNames[NUM_AUDIO_POOLS] = {
@@ -474,6 +503,26 @@ void puppyprint_render_collision(void) {
     gSurfacesAllocated, gSurfaceNodesAllocated);
     print_small_text_light(SCREEN_WIDTH-16, 60, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, 1);
 
+    u32 numQueries = gPuppyCallCounter.collision_floor + gPuppyCallCounter.collision_wall + gPuppyCallCounter.collision_ceil
+                   + gPuppyCallCounter.collision_water + gPuppyCallCounter.collision_raycast;
+    u32 collisionTime = OS_CYCLES_TO_USEC(all_profiling_data[PROFILER_TIME_COLLISION].total / PROFILING_BUFFER_SIZE);
+#ifdef STATIC_SURFACE_SUBCELLS
+    sprintf(textBytes, "Split Cells: %d (0x%X)\nSub-cell Queries: %d\nQueries: %d\nTime: %dus (%dns/query)",
+    gNumStaticSubdividedCells, gStaticSubCellData, gPuppyCallCounter.collision_subcell,
+#else
+    sprintf(textBytes, "Queries: %d\nTime: %dus (%dns/query)",
+#endif
+    numQueries, collisionTime, (numQueries > 0) ? ((collisionTime * 1000) / numQueries) : 0);
+    print_small_text_light(SCREEN_WIDTH-16, 120, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, 1);
+#ifdef BATCHED_FLOOR_PROBES
+    sprintf(textBytes, "Probed Floors: %d/%d", gPuppyCallCounter.collision_probe, gPuppyCallCounter.collision_floor);
+    print_small_text_light(SCREEN_WIDTH-16, 168, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, 1);
+#endif
+#ifdef REUSE_UNMOVED_DYNAMIC_SURFACES
+    sprintf(textBytes, "Reused Dynamic Surfaces: %d", gNumReusedDynamicSurfaces);
+    print_small_text_light(SCREEN_WIDTH-16, 178, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, 1);
+#endif
+
 #ifdef VISUAL_DEBUG
     print_small_text_light(160, (SCREEN_HEIGHT - 42), "Use the dpad to toggle visual collision modes", PRINT_TEXT_ALIGN_CENTRE, PRINT_ALL, FONT_OUTLINE);
     switch (viewCycle) {
@@ -488,6 +537,173 @@ void puppyprint_render_collision(void) {
 #endif
 }
 
+#ifdef PROFILER_SCOPES
+s32 gPPScopeScroll = 0;
+// Height of the scope tree when it was last printed, for limiting the scroll.
+s32 gPPScopeTreeHeight = 0;
+
+#define SCOPE_LINE_HEIGHT 10
+#define SCOPE_TREE_TOP    32
+
+/**
+ * Print a scope's average times over the last frames, and then its children below it with the most expensive first.
+ * Scopes that haven't run recently are left out. Returns the y of the next line.
+ */
+static s32 print_profiler_scope(u8 index, s32 y) {
+    struct ProfilerScope *scope = &gProfilerScopes[index];
+    u8 children[PROFILER_SCOPE_MAX_NODES];
+    s32 numChildren = 0;
+    char textBytes[32];
+
+    if (y - gPPScopeScroll > SCOPE_TREE_TOP && y - gPPScopeScroll < SCREEN_HEIGHT - 16) {
+        s32 printY = y - gPPScopeScroll;
+        print_small_text_light(16 + (scope->depth * 8), printY, scope->name, PRINT_TEXT_ALIGN_LEFT, PRINT_ALL, FONT_DEFAULT);
+        sprintf(textBytes, "%d", PP_CYCLE_CONV(scope->inclusiveTotal / PROFILER_SCOPE_BUFFER_SIZE));
+        print_small_text_light(SCREEN_WIDTH - 112, printY, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_DEFAULT);
+        sprintf(textBytes, "%d", PP_CYCLE_CONV(scope->selfTotal / PROFILER_SCOPE_BUFFER_SIZE));
+        print_small_text_light(SCREEN_WIDTH - 72, printY, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_DEFAULT);
+        sprintf(textBytes, "%d", PP_CYCLE_CONV(scope->inclusiveMax));
+        print_small_text_light(SCREEN_WIDTH - 32, printY, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_DEFAULT);
+        sprintf(textBytes, "%d", scope->lastCalls);
+        print_small_text_light(SCREEN_WIDTH - 8, printY, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_DEFAULT);
+    }
+    y += SCOPE_LINE_HEIGHT;
+
+    for (u8 child = scope->firstChild; child != PROFILER_SCOPE_NONE; child = gProfilerScopes[child].nextSibling) {
+        if (gProfilerScopes[child].inclusiveTotal == 0) {
+            continue;
+        }
+        // Insertion sort, as there are only a few children.
+        s32 i = numChildren++;
+        while (i > 0 && gProfilerScopes[children[i - 1]].inclusiveTotal < gProfilerScopes[child].inclusiveTotal) {
+            children[i] = children[i - 1];
+            i--;
+        }
+        children[i] = child;
+    }
+
+    for (s32 i = 0; i < numChildren; i++) {
+        y = print_profiler_scope(children[i], y);
+    }
+    return y;
+}
+
+void puppyprint_render_scopes(void) {
+    char textBytes[64];
+    prepare_blank_box();
+    render_blank_box(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, 0, 0, 0, 168);
+    finish_blank_box();
+
+    print_set_envcolour(255, 255, 255, 255);
+    sprintf(textBytes, "Scope (" PP_CYCLE_STRING ")");
+    print_small_text_light(16, 20, textBytes, PRINT_TEXT_ALIGN_LEFT, PRINT_ALL, FONT_DEFAULT);
+    print_small_text_light(SCREEN_WIDTH - 112, 20, "Incl", PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_DEFAULT);
+    print_small_text_light(SCREEN_WIDTH - 72, 20, "Self", PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_DEFAULT);
+    print_small_text_light(SCREEN_WIDTH - 32, 20, "Max", PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_DEFAULT);
+    print_small_text_light(SCREEN_WIDTH - 8, 20, "N", PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_DEFAULT);
+
+    if (gNumProfilerScopes > 0) {
+        gPPScopeTreeHeight = print_profiler_scope(0, SCOPE_TREE_TOP + SCOPE_LINE_HEIGHT) - SCOPE_TREE_TOP;
+    }
+
+    if (gNumDroppedProfilerScopes > 0) {
+        sprintf(textBytes, "Dropped scopes: %d", gNumDroppedProfilerScopes);
+        print_small_text_light(SCREEN_WIDTH / 2, SCREEN_HEIGHT - 12, textBytes, PRINT_TEXT_ALIGN_CENTRE, PRINT_ALL, FONT_OUTLINE);
+    }
+}
+
+#undef SCOPE_LINE_HEIGHT
+#undef SCOPE_TREE_TOP
+#endif
+
+#ifdef PROFILER_BEHAVIORS
+enum PPBehaviorView {
+    PP_BEHAVIOR_VIEW_TOTAL,
+    PP_BEHAVIOR_VIEW_PER_OBJECT,
+    PP_BEHAVIOR_VIEW_LISTS,
+    PP_BEHAVIOR_VIEW_COUNT,
+};
+
+s32 gPPBehaviorView = PP_BEHAVIOR_VIEW_TOTAL;
+
+// Most behaviors shown at once
+#define BEHAVIOR_TOP_COUNT 16
+
+static const char *sPPBehaviorViewNames[PP_BEHAVIOR_VIEW_COUNT] = {
+    [PP_BEHAVIOR_VIEW_TOTAL]      = "Behaviors by total",
+    [PP_BEHAVIOR_VIEW_PER_OBJECT] = "Behaviors by object",
+    [PP_BEHAVIOR_VIEW_LISTS]      = "Object lists",
+};
+
+static const char *sPPObjectListNames[NUM_OBJ_LISTS] = {
+    [OBJ_LIST_PLAYER]      = "Player",
+    [OBJ_LIST_UNUSED_1]    = "List 1",
+    [OBJ_LIST_DESTRUCTIVE] = "Destructive",
+    [OBJ_LIST_UNUSED_3]    = "List 3",
+    [OBJ_LIST_GENACTOR]    = "Actor",
+    [OBJ_LIST_PUSHABLE]    = "Pushable",
+    [OBJ_LIST_LEVEL]       = "Level",
+    [OBJ_LIST_UNUSED_7]    = "List 7",
+    [OBJ_LIST_DEFAULT]     = "Default",
+    [OBJ_LIST_SURFACE]     = "Surface",
+    [OBJ_LIST_POLELIKE]    = "Polelike",
+    [OBJ_LIST_SPAWNER]     = "Spawner",
+    [OBJ_LIST_UNIMPORTANT] = "Unimportant",
+};
+
+static void print_behavior_cost(s32 y, const char *name, struct ProfilerBehaviorCost *entry) {
+    char textBytes[16];
+
+    print_small_text_light(16, y, name, PRINT_TEXT_ALIGN_LEFT, PRINT_ALL, FONT_DEFAULT);
+    sprintf(textBytes, "%d", PP_CYCLE_CONV(profiler_behavior_cost(entry, FALSE)));
+    print_small_text_light(SCREEN_WIDTH - 88, y, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_DEFAULT);
+    sprintf(textBytes, "%d", PP_CYCLE_CONV(profiler_behavior_cost(entry, TRUE)));
+    print_small_text_light(SCREEN_WIDTH - 40, y, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_DEFAULT);
+    sprintf(textBytes, "%d", entry->lastInstances);
+    print_small_text_light(SCREEN_WIDTH - 8, y, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_DEFAULT);
+}
+
+void puppyprint_render_behaviors(void) {
+    u8 indices[PROFILER_BEHAVIOR_MAX_ENTRIES];
+    char textBytes[64];
+    s32 y = 32;
+    prepare_blank_box();
+    render_blank_box(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, 0, 0, 0, 168);
+    finish_blank_box();
+
+    print_set_envcolour(255, 255, 255, 255);
+    sprintf(textBytes, "%s (" PP_CYCLE_STRING ")", sPPBehaviorViewNames[gPPBehaviorView]);
+    print_small_text_light(16, 20, textBytes, PRINT_TEXT_ALIGN_LEFT, PRINT_ALL, FONT_DEFAULT);
+    print_small_text_light(SCREEN_WIDTH - 88, 20, "Total", PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_DEFAULT);
+    print_small_text_light(SCREEN_WIDTH - 40, 20, "Each", PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_DEFAULT);
+    print_small_text_light(SCREEN_WIDTH - 8, 20, "N", PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_DEFAULT);
+
+    if (gPPBehaviorView == PP_BEHAVIOR_VIEW_LISTS) {
+        for (s32 i = 0; i < NUM_OBJ_LISTS; i++) {
+            print_behavior_cost(y, sPPObjectListNames[i], &gProfilerObjectLists[i]);
+            y += 10;
+        }
+    } else {
+        s32 count = profiler_behaviors_sort(indices, (gPPBehaviorView == PP_BEHAVIOR_VIEW_PER_OBJECT));
+
+        for (s32 i = 0; i < MIN(count, BEHAVIOR_TOP_COUNT); i++) {
+            struct ProfilerBehaviorCost *entry = &gProfilerBehaviors[indices[i]];
+            sprintf(textBytes, "%08X", (uintptr_t) entry->behavior);
+            print_behavior_cost(y, textBytes, entry);
+            y += 10;
+        }
+    }
+
+    if (gNumDroppedProfilerBehaviors > 0) {
+        sprintf(textBytes, "Dropped objects: %d", gNumDroppedProfilerBehaviors);
+        print_small_text_light(SCREEN_WIDTH / 2, SCREEN_HEIGHT - 24, textBytes, PRINT_TEXT_ALIGN_CENTRE, PRINT_ALL, FONT_OUTLINE);
+    }
+    print_small_text_light(SCREEN_WIDTH / 2, SCREEN_HEIGHT - 12, "D-Pad Left/Right: View   A: Print over USB", PRINT_TEXT_ALIGN_CENTRE, PRINT_ALL, FONT_DEFAULT);
+}
+
+#undef BEHAVIOR_TOP_COUNT
+#endif
+
 extern void print_fps(s32 x, s32 y);
 
 void print_basic_profiling(void) {
@@ -994,9 +1210,11 @@ void puppyprint_render_general_vars(void) {
     }
 
 
-    sprintf(textBytes, "World\n\nObjects: %d/%d\n\nLevel ID: %d\nCourse ID: %d\nArea ID: %d\nRoom ID: %d\n\nInteract:   \n0x%08X\nWarp: 0x%02X", 
+    sprintf(textBytes, "World\n\nObjects: %d/%d\nPeak: %d\nOverruns: %d\n\nLevel ID: %d\nCourse ID: %d\nArea ID: %d\nRoom ID: %d\n\nInteract:   \n0x%08X\nWarp: 0x%02X", 
             gObjectCounter, 
             OBJECT_POOL_CAPACITY,
+            gObjectPoolStats.peakAllocated,
+            gObjectPoolStats.numReserveOverruns,
             gCurrLevelNum,
             gCurrCourseNum,
             gCurrAreaIndex,
@@ -1022,7 +1240,7 @@ void puppyprint_render_general_vars(void) {
             (s32)(gMarioState->waterLevel)
             );
         print_small_text_light(16, 36, textBytes, PRINT_TEXT_ALIGN_LEFT, PRINT_ALL, FONT_OUTLINE);
-        sprintf(textBytes, "Gfx Pool: %d / %d", ((u32)gDisplayListHead - ((u32)gGfxPool->buffer)) / 4, GFX_POOL_SIZE);
+        sprintf(textBytes, "Gfx Pool: %d / %d", gGfxPoolStats.used, gGfxPoolStats.size);
         print_small_text_light(SCREEN_WIDTH/2, SCREEN_HEIGHT-16, textBytes, PRINT_TEXT_ALIGN_CENTRE, PRINT_ALL, FONT_OUTLINE);
     }
 #endif
@@ -1032,6 +1250,12 @@ struct PuppyPrintPage ppPages[] = {
 #ifdef USE_PROFILER
     [PUPPYPRINT_PAGE_PROFILER]      = {&puppyprint_render_standard,     "Profiler"},
     [PUPPYPRINT_PAGE_MINIMAL]       = {&puppyprint_render_minimal,      "Minimal"},
+#endif
+#ifdef PROFILER_SCOPES
+    [PUPPYPRINT_PAGE_SCOPES]        = {&puppyprint_render_scopes,       "Scopes"},
+#endif
+#ifdef PROFILER_BEHAVIORS
+    [PUPPYPRINT_PAGE_BEHAVIORS]     = {&puppyprint_render_behaviors,    "Behaviors"},
 #endif
     [PUPPYPRINT_PAGE_GENERAL]       = {&puppyprint_render_general_vars, "General"},
     [PUPPYPRINT_PAGE_AUDIO]         = {&print_audio_overview,           "Audio"},
@@ -1185,6 +1409,28 @@ void puppyprint_profiler_process(void) {
             if (viewCycle == 255)
                 viewCycle = 3;
         }
+#endif
+#ifdef PROFILER_SCOPES
+        if (sPPDebugPage == PUPPYPRINT_PAGE_SCOPES) {
+            s32 maxScroll = MAX(gPPScopeTreeHeight - (SCREEN_HEIGHT - 64), 0);
+            if (gPlayer1Controller->buttonDown & U_JPAD && gPPScopeScroll > 0) {
+                gPPScopeScroll -= 4;
+            } else if (gPlayer1Controller->buttonDown & D_JPAD && gPPScopeScroll < maxScroll) {
+                gPPScopeScroll += 4;
+            }
+        }
+#endif
+#ifdef PROFILER_BEHAVIORS
+        if (sPPDebugPage == PUPPYPRINT_PAGE_BEHAVIORS) {
+            if (gPlayer1Controller->buttonPressed & R_JPAD) {
+                gPPBehaviorView = (gPPBehaviorView + 1) % PP_BEHAVIOR_VIEW_COUNT;
+            } else if (gPlayer1Controller->buttonPressed & L_JPAD) {
+                gPPBehaviorView = (gPPBehaviorView + PP_BEHAVIOR_VIEW_COUNT - 1) % PP_BEHAVIOR_VIEW_COUNT;
+            }
+            if (gPlayer1Controller->buttonPressed & A_BUTTON) {
+                profiler_behaviors_dump();
+            }
+        }
 #endif
         if (sPPDebugPage == PUPPYPRINT_PAGE_RAM) {
             if (gPlayer1Controller->buttonDown & U_JPAD && gPPSegScroll > 0)  {
@@ -49,6 +49,8 @@ struct CallCounter {
     u16 collision_ceil;
     u16 collision_water;
     u16 collision_raycast;
+    u16 collision_subcell;
+    u16 collision_probe;
     u16 matrix;
 };
 
@@ -87,6 +89,12 @@ enum PPPages {
 #ifdef USE_PROFILER
     PUPPYPRINT_PAGE_PROFILER,
     PUPPYPRINT_PAGE_MINIMAL,
+#endif
+#ifdef PROFILER_SCOPES
+    PUPPYPRINT_PAGE_SCOPES,
+#endif
+#ifdef PROFILER_BEHAVIORS
+    PUPPYPRINT_PAGE_BEHAVIORS,
 #endif
     PUPPYPRINT_PAGE_GENERAL,
     PUPPYPRINT_PAGE_AUDIO,
@@ -1,17 +1,20 @@
 #include <PR/ultratypes.h>
 
+#include "actors/common1.h"
 #include "area.h"
 #include "engine/math_util.h"
 #include "game_init.h"
 #include "gfx_dimensions.h"
 #include "main.h"
 #include "memory.h"
+#include "particle_system.h"
 #include "print.h"
 #include "rendering_graph_node.h"
 #include "shadow.h"
 #include "sm64.h"
 #include "game_init.h"
 #include "puppyprint.h"
+#include "profiling.h"
 #include "debug_box.h"
 #include "level_update.h"
 #include "behavior_data.h"
@@ -161,6 +164,9 @@ ALIGNED16 struct GraphNodeObject *gCurGraphNodeObject = NULL;
 ALIGNED16 struct GraphNodeHeldObject *gCurGraphNodeHeldObject = NULL;
 u16 gAreaUpdateCounter = 0;
 LookAt* gCurLookAt;
+#if defined(F3DEX_GBI_2) && defined(MASTER_LIST_BATCHING)
+static s32 sLookAtLoaded = FALSE;
+#endif
 
 #if SILHOUETTE
 // AA_EN        Enable anti aliasing (not actually used for AA in this case).
@@ -248,6 +254,228 @@ Mtx identityMatrixWorldScale = {{
      0x00000000,                            LOWER_FIXED(1.0f)               <<  0}
 }};
 
+#ifdef MASTER_LIST_BATCHING
+/**
+ * Whether the order of a layer's display lists doesn't matter, which is the case for the z-buffered layers
+ * that don't blend or decal onto what's already been drawn.
+ */
+static s32 layer_is_batched(s32 layer) {
+    switch (layer) {
+        case LAYER_OPAQUE:
+        case LAYER_OPAQUE_INTER:
+        case LAYER_ALPHA:
+#if SILHOUETTE
+        case LAYER_SILHOUETTE_OPAQUE:
+        case LAYER_SILHOUETTE_ALPHA:
+        case LAYER_OCCLUDE_SILHOUETTE_OPAQUE:
+        case LAYER_OCCLUDE_SILHOUETTE_ALPHA:
+#endif
+            return TRUE;
+        default:
+            return FALSE;
+    }
+}
+
+static s32 display_list_node_goes_first(struct DisplayListNode *a, struct DisplayListNode *b) {
+    if (a->displayList != b->displayList) {
+        return ((uintptr_t) a->displayList < (uintptr_t) b->displayList);
+    }
+    return ((uintptr_t) a->transform <= (uintptr_t) b->transform);
+}
+
+/**
+ * Merge sort a layer's display lists by their display list, then by their matrix. Returns the new first one.
+ */
+static struct DisplayListNode *sort_display_list_nodes(struct DisplayListNode *head) {
+    struct DisplayListNode *slow, *fast, *second;
+    struct DisplayListNode *sorted = NULL;
+    struct DisplayListNode **tail = &sorted;
+
+    if (head == NULL || head->next == NULL) {
+        return head;
+    }
+
+    // Split the list in half.
+    slow = head;
+    fast = head->next;
+    while (fast != NULL && fast->next != NULL) {
+        slow = slow->next;
+        fast = fast->next->next;
+    }
+    second = slow->next;
+    slow->next = NULL;
+
+    head = sort_display_list_nodes(head);
+    second = sort_display_list_nodes(second);
+
+    while (head != NULL && second != NULL) {
+        if (display_list_node_goes_first(head, second)) {
+            *tail = head;
+            head = head->next;
+        } else {
+            *tail = second;
+            second = second->next;
+        }
+        tail = &(*tail)->next;
+    }
+    *tail = (head != NULL) ? head : second;
+
+    return sorted;
+}
+
+// Objects are numbered as they're drawn so their display lists can be told apart. Group 0 is for anything outside of one.
+#define DISPLAY_LIST_GROUPS 512
+
+static u32 sCurDisplayListGroup = 0;
+static u32 sNumDisplayListGroups = 0;
+// Groups with a generated display list on the layer being sorted have sPinnedGroupStamp here
+static u16 sPinnedGroups[DISPLAY_LIST_GROUPS];
+static u16 sPinnedGroupStamp = 0;
+
+/**
+ * Whether a display list was built this frame, rather than being part of a model.
+ */
+static s32 display_list_is_generated(void *displayList) {
+    return ((u8 *) displayList >= (u8 *) gGfxPool->buffer && (u8 *) displayList < (u8 *) gGfxPool->buffer + gGfxPoolStats.size);
+}
+
+/**
+ * Sort a layer's display lists, except for those of the objects that added a generated display list to it, which can
+ * set render state for the rest of their model. Those stay where they are, and the others are only sorted among the ones
+ * between them, so every display list is still drawn after the same generated ones as it would have been.
+ * Returns the new first one.
+ */
+static struct DisplayListNode *sort_layer_display_lists(struct DisplayListNode *head) {
+    struct DisplayListNode *sorted = NULL;
+    struct DisplayListNode **tail = &sorted;
+    struct DisplayListNode *node;
+
+    if (++sPinnedGroupStamp == 0) {
+        bzero(sPinnedGroups, sizeof(sPinnedGroups));
+        sPinnedGroupStamp = 1;
+    }
+    for (node = head; node != NULL; node = node->next) {
+        if (display_list_is_generated(node->displayList)) {
+            sPinnedGroups[node->group % DISPLAY_LIST_GROUPS] = sPinnedGroupStamp;
+        }
+    }
+
+    while (head != NULL) {
+        struct DisplayListNode *runEnd = head;
+
+        if (sPinnedGroups[head->group % DISPLAY_LIST_GROUPS] == sPinnedGroupStamp) {
+            *tail = head;
+            tail = &head->next;
+            head = head->next;
+            continue;
+        }
+
+        while (runEnd->next != NULL && sPinnedGroups[runEnd->next->group % DISPLAY_LIST_GROUPS] != sPinnedGroupStamp) {
+            runEnd = runEnd->next;
+        }
+        node = runEnd->next;
+        runEnd->next = NULL;
+
+        *tail = sort_display_list_nodes(head);
+        while (*tail != NULL) {
+            tail = &(*tail)->next;
+        }
+        head = node;
+    }
+
+    return sorted;
+}
+#endif
+
+#ifdef INSTANCED_MODELS
+/**
+ * A display list that draws the same as drawing its begin, quad and end display lists one after another, where
+ * only the quad draws anything. A run of copies of it on a sorted layer is drawn with a single begin and end.
+ */
+struct InstancedDisplayList {
+    const Gfx *displayList;
+    const Gfx *begin;
+    const Gfx *quad;
+    const Gfx *end;
+};
+
+#ifdef IA8_30FPS_COINS
+#define INSTANCED_COIN(color)                                                                                               \
+    { coin_seg3_dl_##color##_0,      coin_seg3_sub_dl_texture_0,    coin_seg3_sub_dl_quad_##color,      coin_seg3_dl_end }, \
+    { coin_seg3_dl_##color##_22_5,   coin_seg3_sub_dl_texture_22_5, coin_seg3_sub_dl_quad_##color,      coin_seg3_dl_end }, \
+    { coin_seg3_dl_##color##_45,     coin_seg3_sub_dl_texture_45,   coin_seg3_sub_dl_quad_##color,      coin_seg3_dl_end }, \
+    { coin_seg3_dl_##color##_67_5,   coin_seg3_sub_dl_texture_67_5, coin_seg3_sub_dl_quad_##color,      coin_seg3_dl_end }, \
+    { coin_seg3_dl_##color##_90,     coin_seg3_sub_dl_texture_90,   coin_seg3_sub_dl_quad_##color,      coin_seg3_dl_end }, \
+    { coin_seg3_dl_##color##_67_5_r, coin_seg3_sub_dl_texture_67_5, coin_seg3_sub_dl_quad_##color##_r, coin_seg3_dl_end }, \
+    { coin_seg3_dl_##color##_45_r,   coin_seg3_sub_dl_texture_45,   coin_seg3_sub_dl_quad_##color##_r, coin_seg3_dl_end }, \
+    { coin_seg3_dl_##color##_22_5_r, coin_seg3_sub_dl_texture_22_5, coin_seg3_sub_dl_quad_##color##_r, coin_seg3_dl_end }
+#else
+#define INSTANCED_COIN(color)                                                                                                        \
+    { coin_seg3_dl_##color##_front,      coin_seg3_sub_dl_texture_front,      coin_seg3_sub_dl_quad_##color, coin_seg3_sub_dl_end }, \
+    { coin_seg3_dl_##color##_tilt_right, coin_seg3_sub_dl_texture_tilt_right, coin_seg3_sub_dl_quad_##color, coin_seg3_sub_dl_end }, \
+    { coin_seg3_dl_##color##_side,       coin_seg3_sub_dl_texture_side,       coin_seg3_sub_dl_quad_##color, coin_seg3_sub_dl_end }, \
+    { coin_seg3_dl_##color##_tilt_left,  coin_seg3_sub_dl_texture_tilt_left,  coin_seg3_sub_dl_quad_##color, coin_seg3_sub_dl_end }
+#endif
+
+#define INSTANCED_TREE(name) \
+    { tree_seg3_dl_##name, tree_seg3_dl_##name##_begin, tree_seg3_dl_##name##_quad, tree_seg3_dl_end }
+
+static const struct InstancedDisplayList sInstancedDisplayLists[] = {
+    INSTANCED_COIN(yellow),
+    INSTANCED_COIN(blue),
+    INSTANCED_COIN(red),
+#ifdef IA8_30FPS_COINS
+    INSTANCED_COIN(secret),
+#endif
+    INSTANCED_TREE(spiky),
+    INSTANCED_TREE(snowy_pine),
+    INSTANCED_TREE(palm),
+};
+
+#undef INSTANCED_COIN
+#undef INSTANCED_TREE
+
+static const struct InstancedDisplayList *find_instanced_display_list(void *displayList) {
+    s32 i;
+
+    for (i = 0; i < ARRAY_COUNT(sInstancedDisplayLists); i++) {
+        if (sInstancedDisplayLists[i].displayList == displayList) {
+            return &sInstancedDisplayLists[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Draw the run of copies of an instanced display list starting at currList, loading each one's matrix and
+ * drawing its quad between a single begin and end. Returns the display list after the run. The run is only
+ * ever consecutive nodes of the sorted layer, so no generated display list can be drawn in the middle of it.
+ */
+static struct DisplayListNode *draw_instances(Gfx **gfx, struct DisplayListNode *currList,
+                                              const struct InstancedDisplayList *instanced, Mtx **loadedTransform) {
+    Gfx *gfxHead = *gfx;
+
+    gSPDisplayList(gfxHead++, instanced->begin);
+    do {
+        if (currList->transform == *loadedTransform) {
+            PROFILER_ADD_COUNT(PROFILER_COUNT_SKIPPED_MATRICES, 1);
+        } else {
+            gSPMatrix(gfxHead++, VIRTUAL_TO_PHYSICAL(currList->transform),
+                      (G_MTX_MODELVIEW | G_MTX_LOAD | G_MTX_NOPUSH));
+            *loadedTransform = currList->transform;
+        }
+        gSPDisplayList(gfxHead++, instanced->quad);
+        PROFILER_ADD_COUNT(PROFILER_COUNT_INSTANCES, 1);
+
+        currList = currList->next;
+    } while (currList != NULL && currList->displayList == instanced->displayList);
+    gSPDisplayList(gfxHead++, instanced->end);
+
+    *gfx = gfxHead;
+    return currList;
+}
+#endif
+
 /**
  * Process a master list node. This has been modified, so now it runs twice, for each microcode.
  * It iterates through the first 5 layers of if the first index using F3DLX2.Rej, then it switches
@@ -267,6 +495,17 @@ void geo_process_master_list_sub(struct GraphNodeMasterList *node) {
     struct RenderModeContainer *mode1List = &renderModeTable_1Cycle[enableZBuffer];
     struct RenderModeContainer *mode2List = &renderModeTable_2Cycle[enableZBuffer];
     Gfx *tempGfxHead = gDisplayListHead;
+#ifdef MASTER_LIST_BATCHING
+    s32 batched;
+    Mtx *loadedTransform;
+    void *prevDisplayList;
+
+    for (currLayer = LAYER_FIRST; currLayer < LAYER_COUNT; currLayer++) {
+        if (layer_is_batched(currLayer)) {
+            node->listHeads[currLayer] = sort_layer_display_lists(node->listHeads[currLayer]);
+        }
+    }
+#endif
 
     // Loop through the render phases
     for (phaseIndex = RENDER_PHASE_FIRST; phaseIndex < finalPhase; phaseIndex++) {
@@ -301,12 +540,53 @@ void geo_process_master_list_sub(struct GraphNodeMasterList *node) {
                 gDPSetRenderMode(tempGfxHead++, mode1List->modes[currLayer],
                                                      mode2List->modes[currLayer]);
             }
+#endif
+#ifdef MASTER_LIST_BATCHING
+            batched = layer_is_batched(currLayer);
+            loadedTransform = NULL;
+            prevDisplayList = NULL;
 #endif
             // Iterate through all the displaylists on the current layer.
             while (currList != NULL) {
-                // Add the display list's transformation to the master list.
-                gSPMatrix(tempGfxHead++, VIRTUAL_TO_PHYSICAL(currList->transform),
-                          (G_MTX_MODELVIEW | G_MTX_LOAD | G_MTX_NOPUSH));
+#ifdef INSTANCED_MODELS
+                if (batched && currList->next != NULL && currList->next->displayList == currList->displayList
+#if SILHOUETTE
+                    && phaseIndex != RENDER_PHASE_SILHOUETTE
+#endif
+                ) {
+                    const struct InstancedDisplayList *instanced = find_instanced_display_list(currList->displayList);
+
+                    if (instanced != NULL) {
+                        prevDisplayList = currList->displayList;
+                        currList = draw_instances(&tempGfxHead, currList, instanced, &loadedTransform);
+                        continue;
+                    }
+                }
+#endif
+#ifdef MASTER_LIST_BATCHING
+                if (batched && currList->displayList == prevDisplayList) {
+                    PROFILER_ADD_COUNT(PROFILER_COUNT_BATCHED_DLS, 1);
+                }
+                prevDisplayList = currList->displayList;
+
+                // The display lists on the batched layers leave the matrix as it was, so it only needs loading when it's a different one.
+                if (currList->transform == NULL) {
+                    // The display list loads its own matrices, so which one is loaded after it isn't known.
+                    loadedTransform = NULL;
+                } else if (batched && currList->transform == loadedTransform) {
+                    PROFILER_ADD_COUNT(PROFILER_COUNT_SKIPPED_MATRICES, 1);
+                } else {
+                    gSPMatrix(tempGfxHead++, VIRTUAL_TO_PHYSICAL(currList->transform),
+                              (G_MTX_MODELVIEW | G_MTX_LOAD | G_MTX_NOPUSH));
+                    loadedTransform = currList->transform;
+                }
+#else
+                // Add the display list's transformation to the master list, unless it loads its own.
+                if (currList->transform != NULL) {
+                    gSPMatrix(tempGfxHead++, VIRTUAL_TO_PHYSICAL(currList->transform),
+                              (G_MTX_MODELVIEW | G_MTX_LOAD | G_MTX_NOPUSH));
+                }
+#endif
 #if SILHOUETTE
                 if (phaseIndex == RENDER_PHASE_SILHOUETTE) {
                     // Add the current display list to the master list, with silhouette F3D.
@@ -342,15 +622,18 @@ void geo_process_master_list_sub(struct GraphNodeMasterList *node) {
     gDisplayListHead = tempGfxHead;
 }
 
-/**
- * Appends the display list to one of the master lists based on the layer
- * parameter. Look at the RenderModeContainer struct to see the corresponding
- * render modes of layers.
- */
-void geo_append_display_list(void *displayList, s32 layer) {
+static void append_display_list_node(void *displayList, Mtx *transform, s32 layer) {
 #ifdef F3DEX_GBI_2
+#ifdef MASTER_LIST_BATCHING
+    // The RSP only reads gCurLookAt once it gets to the command, so it only needs loading once per root.
+    if (!sLookAtLoaded) {
+        gSPLookAt(gDisplayListHead++, gCurLookAt);
+        sLookAtLoaded = TRUE;
+    }
+#else
     gSPLookAt(gDisplayListHead++, gCurLookAt);
 #endif
+#endif
 #if SILHOUETTE
     if (gCurGraphNodeObject != NULL) {
         if (gCurGraphNodeObject->node.flags & GRAPH_RENDER_SILHOUETTE) {
@@ -371,9 +654,12 @@ void geo_append_display_list(void *displayList, s32 layer) {
         struct DisplayListNode *listNode =
             alloc_only_pool_alloc(gDisplayListHeap, sizeof(struct DisplayListNode));
 
-        listNode->transform = gMatStackFixed[gMatStackIndex];
+        listNode->transform = transform;
         listNode->displayList = displayList;
         listNode->next = NULL;
+#ifdef MASTER_LIST_BATCHING
+        listNode->group = sCurDisplayListGroup;
+#endif
         if (gCurGraphNodeMasterList->listHeads[layer] == NULL) {
             gCurGraphNodeMasterList->listHeads[layer] = listNode;
         } else {
@@ -383,11 +669,153 @@ void geo_append_display_list(void *displayList, s32 layer) {
     }
 }
 
+/**
+ * Appends the display list to one of the master lists based on the layer
+ * parameter. Look at the RenderModeContainer struct to see the corresponding
+ * render modes of layers.
+ */
+void geo_append_display_list(void *displayList, s32 layer) {
+    append_display_list_node(displayList, gMatStackFixed[gMatStackIndex], layer);
+}
+
+/**
+ * Appends a display list that loads the modelview matrices it's drawn with itself,
+ * so the master list doesn't load one before it.
+ */
+void geo_append_display_list_with_matrices(void *displayList, s32 layer) {
+    append_display_list_node(displayList, NULL, layer);
+}
+
+#ifdef GRAPH_NODE_MATRIX_CACHE
+/**
+ * Whether the matrix at a matrix stack index can be relied on to be the same next frame, when the node
+ * it belongs to is drawn again.
+ */
+enum MatStackCacheStates {
+    MAT_STACK_UNCACHED,     // Allocated from the display list pool this frame
+    MAT_STACK_CACHED_NEW,   // Kept in a matrix cache, but worked out again this frame
+    MAT_STACK_CACHED,       // Kept in a matrix cache, and the same as last frame
+};
+
+/**
+ * The matrix of a translation, rotation or scale node, kept from the frame it was worked out in for as
+ * long as its parent's matrix stays the same. Only the level geometry's nodes use these, as objects
+ * work out their matrices every frame.
+ */
+struct GraphNodeMatrixCache {
+    Mat4 mtxf;
+    Mtx mtx[2];     // Written in turn, so the one the previous frame is still being drawn with isn't changed
+    Mtx *parentMtx; // The fixed point matrix of the parent it was worked out from
+    u16 frame;      // The frame it was last worked out in
+    u8 mtxIndex;
+    u8 dirty;
+};
+
+static struct GraphNodeMatrixCache sMatrixCaches[GRAPH_NODE_MATRIX_CACHE_CAPACITY];
+static u32 sNumMatrixCaches = 0;
+static u8 sMatStackCacheStates[32];
+static u16 sMatrixCacheFrame = 0;
+// The root's matrix, which is the same every frame so the level geometry's nodes can be cached under it
+static Mtx sIdentityMtx;
+
+/**
+ * Forget every node's matrix cache. Called by clear_areas, as the nodes that had them are unloaded.
+ */
+void clear_matrix_caches(void) {
+    sNumMatrixCaches = 0;
+}
+#endif
+
 static void inc_mat_stack() {
     Mtx *mtx = alloc_display_list(sizeof(*mtx));
     gMatStackIndex++;
     mtxf_to_mtx(mtx, gMatStack[gMatStackIndex]);
     gMatStackFixed[gMatStackIndex] = mtx;
+#ifdef GRAPH_NODE_MATRIX_CACHE
+    sMatStackCacheStates[gMatStackIndex] = MAT_STACK_UNCACHED;
+#endif
+}
+
+/**
+ * Push the node's cached matrix instead of working it out again, if it's still the same. Returns FALSE
+ * if the node has to push a new one with inc_mat_stack_and_cache.
+ */
+static s32 push_cached_mat_stack(UNUSED struct GraphNodeMatrixCache **cachePtr) {
+#ifdef GRAPH_NODE_MATRIX_CACHE
+    struct GraphNodeMatrixCache *cache = *cachePtr;
+
+    if (cache == NULL
+        || cache->dirty
+        || sMatStackCacheStates[gMatStackIndex] != MAT_STACK_CACHED
+        || cache->parentMtx != gMatStackFixed[gMatStackIndex]) {
+        return FALSE;
+    }
+
+    gMatStackIndex++;
+    mtxf_copy(gMatStack[gMatStackIndex], cache->mtxf);
+    gMatStackFixed[gMatStackIndex] = &cache->mtx[cache->mtxIndex];
+    sMatStackCacheStates[gMatStackIndex] = MAT_STACK_CACHED;
+    PROFILER_ADD_COUNT(PROFILER_COUNT_CACHED_MATRICES, 1);
+    return TRUE;
+#else
+    return FALSE;
+#endif
+}
+
+/**
+ * Push the matrix in gMatStack[gMatStackIndex + 1], keeping it in the node's matrix cache if its parent's
+ * matrix is cached too, so that it can be reused next frame.
+ */
+static void inc_mat_stack_and_cache(UNUSED struct GraphNodeMatrixCache **cachePtr) {
+#ifdef GRAPH_NODE_MATRIX_CACHE
+    struct GraphNodeMatrixCache *cache = *cachePtr;
+
+    if (sMatStackCacheStates[gMatStackIndex] != MAT_STACK_UNCACHED) {
+        if (cache == NULL && sNumMatrixCaches < ARRAY_COUNT(sMatrixCaches)) {
+            cache = &sMatrixCaches[sNumMatrixCaches++];
+            cache->frame = sMatrixCacheFrame - 1;
+            cache->mtxIndex = 0;
+            *cachePtr = cache;
+        }
+
+        // A node drawn twice in one frame only caches the first matrix, so neither buffer is still being drawn with.
+        if (cache != NULL && cache->frame != sMatrixCacheFrame) {
+            cache->parentMtx = gMatStackFixed[gMatStackIndex];
+            cache->frame = sMatrixCacheFrame;
+            cache->mtxIndex ^= 1;
+            cache->dirty = FALSE;
+
+            gMatStackIndex++;
+            mtxf_copy(cache->mtxf, gMatStack[gMatStackIndex]);
+            mtxf_to_mtx(&cache->mtx[cache->mtxIndex], cache->mtxf);
+            gMatStackFixed[gMatStackIndex] = &cache->mtx[cache->mtxIndex];
+            sMatStackCacheStates[gMatStackIndex] = MAT_STACK_CACHED_NEW;
+            return;
+        }
+    }
+#endif
+    inc_mat_stack();
+}
+
+/**
+ * Make a translation, rotation or scale node work out its matrix again the next time it's drawn, for when
+ * its transformation is changed. The matrices of nodes under objects are never cached, so those don't need it.
+ */
+void geo_invalidate_matrix_cache(UNUSED struct GraphNode *node) {
+#ifdef GRAPH_NODE_MATRIX_CACHE
+    struct GraphNodeMatrixCache *cache = NULL;
+
+    switch (node->type) {
+        case GRAPH_NODE_TYPE_TRANSLATION_ROTATION: cache = ((struct GraphNodeTranslationRotation *) node)->matrixCache; break;
+        case GRAPH_NODE_TYPE_TRANSLATION:          cache = ((struct GraphNodeTranslation         *) node)->matrixCache; break;
+        case GRAPH_NODE_TYPE_ROTATION:             cache = ((struct GraphNodeRotation            *) node)->matrixCache; break;
+        case GRAPH_NODE_TYPE_SCALE:                cache = ((struct GraphNodeScale               *) node)->matrixCache; break;
+    }
+
+    if (cache != NULL) {
+        cache->dirty = TRUE;
+    }
+#endif
 }
 
 static void append_dl_and_return(struct GraphNodeDisplayList *node) {
@@ -412,7 +840,9 @@ void geo_process_master_list(struct GraphNodeMasterList *node) {
             node->listHeads[layer] = NULL;
         }
         geo_process_node_and_siblings(node->node.children);
+        PROFILER_SCOPE_BEGIN("Master list");
         geo_process_master_list_sub(gCurGraphNodeMasterList);
+        PROFILER_SCOPE_END();
         gCurGraphNodeMasterList = NULL;
     }
 }
@@ -437,6 +867,30 @@ void geo_process_master_list(struct GraphNodeMasterList *node) {
     }
 }
 
+/**
+ * The side planes of the view frustum in camera space, set once per frame by geo_process_perspective.
+ * Each is the unit normal pointing out of the frustum, and the planes all go through the camera, so a
+ * point's distance outside of one is just the dot product with it.
+ */
+static Vec3f sFrustumPlanes[3];
+static s32 sNumFrustumPlanes = 0;
+
+static void set_frustum_plane(f32 x, f32 y, f32 slope) {
+    f32 invLength = 1.0f / sqrtf(1.0f + sqr(slope));
+
+    vec3f_set(sFrustumPlanes[sNumFrustumPlanes++], x * invLength, y * invLength, slope * invLength);
+}
+
+static void set_frustum_planes(struct GraphNodePerspective *node) {
+    sNumFrustumPlanes = 0;
+    set_frustum_plane( 1.0f, 0.0f, node->halfFovHorizontal); // Right
+    set_frustum_plane(-1.0f, 0.0f, node->halfFovHorizontal); // Left
+#ifdef VERTICAL_CULLING
+    // Unlike with horizontal culling, only the bottom of the screen is checked to prevent shadows from being culled.
+    set_frustum_plane(0.0f, -1.0f, node->halfFovVertical);
+#endif
+}
+
 /**
  * Process a perspective projection node.
  */
@@ -459,13 +913,13 @@ void geo_process_perspective(struct GraphNodePerspective *node) {
 
         f32 vHalfFov = ( ((node->fov * 4096.f) + 8192.f) ) / 45.f;
 
-        // We need to account for aspect ratio changes by multiplying by the widescreen horizontal stretch 
-        // (normally 1.775).
-        node->halfFovHorizontal = tans(vHalfFov * sAspectRatio);
+        // The screen is wider than it is tall by the aspect ratio, so the slope of its sides is the vertical one scaled by it.
+        node->halfFovHorizontal = tans(vHalfFov) * sAspectRatio;
 
 #ifdef VERTICAL_CULLING
         node->halfFovVertical = tans(vHalfFov);
 #endif
+        set_frustum_planes(node);
 
         // With low fovs, coordinate overflow can occur more easily. This slightly reduces precision only while zoomed in.
         f32 scale = node->fov < 28.0f ? remap(MAX(node->fov, 15), 15, 28, 0.5f, 1.0f): 1.0f;
@@ -555,6 +1009,26 @@ void setup_global_light() {
     gSPSetLights1(gDisplayListHead++, (*curLight));
 }
 
+// The rotation that faces the camera being rendered, which every billboard under it shares
+static Mat4 sBillboardBasis;
+
+/**
+ * Set dest to the camera's billboard rotation scaled by scale and translated to pos relative to
+ * parentMtx. The same as mtxf_billboard with the camera's roll, without working out the rotation again.
+ */
+static void mtxf_billboard_from_basis(Mat4 dest, Mat4 parentMtx, Vec3f pos, Vec3f scale) {
+    s32 i;
+
+    for (i = 0; i < 3; i++) {
+        dest[0][i] = sBillboardBasis[0][i] * scale[0];
+        dest[1][i] = sBillboardBasis[1][i] * scale[1];
+        dest[2][i] = sBillboardBasis[2][i] * scale[2];
+        dest[i][3] = 0.0f;
+    }
+    vec3f_sum(dest[3], pos, parentMtx[3]);
+    dest[3][3] = 1.0f;
+}
+
 /**
  * Process a camera node.
  */
@@ -570,6 +1044,7 @@ void geo_process_camera(struct GraphNodeCamera *node) {
     gSPMatrix(gDisplayListHead++, VIRTUAL_TO_PHYSICAL(rollMtx), G_MTX_PROJECTION | G_MTX_MUL | G_MTX_NOPUSH);
 
     mtxf_lookat(gCameraTransform, node->pos, node->focus, node->roll);
+    mtxf_billboard(sBillboardBasis, gMatStack[gMatStackIndex], gVec3fZero, gVec3fOne, node->roll);
 
     // Calculate the lookAt
 #ifdef F3DEX_GBI_2
@@ -623,10 +1098,12 @@ void geo_process_camera(struct GraphNodeCamera *node) {
 void geo_process_translation_rotation(struct GraphNodeTranslationRotation *node) {
     Vec3f translation;
 
-    vec3s_to_vec3f(translation, node->translation);
-    mtxf_rotate_zxy_and_translate_and_mul(node->rotation, translation, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
+    if (!push_cached_mat_stack(&node->matrixCache)) {
+        vec3s_to_vec3f(translation, node->translation);
+        mtxf_rotate_zxy_and_translate_and_mul(node->rotation, translation, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
 
-    inc_mat_stack();
+        inc_mat_stack_and_cache(&node->matrixCache);
+    }
     append_dl_and_return((struct GraphNodeDisplayList *)node);
 }
 
@@ -638,10 +1115,12 @@ void geo_process_translation_rotation(struct GraphNodeTranslationRotation *node)
 void geo_process_translation(struct GraphNodeTranslation *node) {
     Vec3f translation;
 
-    vec3s_to_vec3f(translation, node->translation);
-    mtxf_rotate_zxy_and_translate_and_mul(gVec3sZero, translation, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
+    if (!push_cached_mat_stack(&node->matrixCache)) {
+        vec3s_to_vec3f(translation, node->translation);
+        mtxf_rotate_zxy_and_translate_and_mul(gVec3sZero, translation, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
 
-    inc_mat_stack();
+        inc_mat_stack_and_cache(&node->matrixCache);
+    }
     append_dl_and_return((struct GraphNodeDisplayList *)node);
 }
 
@@ -651,9 +1130,11 @@ void geo_process_translation(struct GraphNodeTranslation *node) {
  * For the rest it acts as a normal display list node.
  */
 void geo_process_rotation(struct GraphNodeRotation *node) {
-    mtxf_rotate_zxy_and_translate_and_mul(node->rotation, gVec3fZero, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
+    if (!push_cached_mat_stack(&node->matrixCache)) {
+        mtxf_rotate_zxy_and_translate_and_mul(node->rotation, gVec3fZero, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
 
-    inc_mat_stack();
+        inc_mat_stack_and_cache(&node->matrixCache);
+    }
     append_dl_and_return(((struct GraphNodeDisplayList *)node));
 }
 
@@ -665,10 +1146,12 @@ void geo_process_rotation(struct GraphNodeRotation *node) {
 void geo_process_scale(struct GraphNodeScale *node) {
     Vec3f scaleVec;
 
-    vec3f_set(scaleVec, node->scale, node->scale, node->scale);
-    mtxf_scale_vec3f(gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex], scaleVec);
+    if (!push_cached_mat_stack(&node->matrixCache)) {
+        vec3f_set(scaleVec, node->scale, node->scale, node->scale);
+        mtxf_scale_vec3f(gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex], scaleVec);
 
-    inc_mat_stack();
+        inc_mat_stack_and_cache(&node->matrixCache);
+    }
     append_dl_and_return((struct GraphNodeDisplayList *)node);
 }
 
@@ -690,7 +1173,7 @@ void geo_process_billboard(struct GraphNodeBillboard *node) {
         vec3f_copy(scale, gCurGraphNodeObject->scale);
     }
 
-    mtxf_billboard(gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex], translation, scale, gCurGraphNodeCamera->roll);
+    mtxf_billboard_from_basis(gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex], translation, scale);
 
     inc_mat_stack();
     append_dl_and_return((struct GraphNodeDisplayList *)node);
@@ -836,10 +1319,8 @@ void geo_set_animation_globals(struct AnimInfo *node, s32 hasAnimation) {
         gCurrAnimType = ANIM_TYPE_TRANSLATION;
     }
 
-    gCurrAnimFrame = node->animFrame;
     gCurrAnimEnabled = (anim->flags & ANIM_FLAG_DISABLED) == 0;
-    gCurrAnimAttribute = segmented_to_virtual((void *) anim->index);
-    gCurrAnimData = segmented_to_virtual((void *) anim->values);
+    gCurrAnimFrame = get_animation_frame_tables(anim, node->animFrame, &gCurrAnimAttribute, &gCurrAnimData);
 
     if (anim->animYTransDivisor == 0) {
         gCurrAnimTranslationMultiplier = 1.0f;
@@ -952,27 +1433,23 @@ void geo_process_shadow(struct GraphNodeShadow *node) {
 
 #define NO_CULLING_EMULATOR_BLACKLIST (EMU_CONSOLE | EMU_WIIVC | EMU_ARES | EMU_SIMPLE64 | EMU_CEN64)
 
-s32 obj_is_in_view(struct GraphNodeObject *node) {
-    struct GraphNode *geo = node->sharedChild;
-
-    s16 cullingRadius;
+/**
+ * Check whether a sphere at the given camera space position can be seen, counting the test for the profiler.
+ */
+static s32 sphere_is_in_view(Vec3f cameraToPos, f32 radius) {
+    s32 i;
 
-    if (geo != NULL && geo->type == GRAPH_NODE_TYPE_CULLING_RADIUS) {
-        cullingRadius = ((struct GraphNodeCullingRadius *) geo)->cullingRadius;
-    } else {
-        cullingRadius = DEFAULT_CULLING_RADIUS;
-    }
+    PROFILER_ADD_COUNT(PROFILER_COUNT_CULL_TESTS, 1);
 
     // Check whether the object is not too far away or too close / behind the camera.
     // This makes the HOLP not update when the camera is far away, and it
     // makes PU travel safe when the camera is locked on the main map.
     // If Mario were rendered with a depth over 65536 it would cause overflow
     // when converting the transformation matrix to a fixed point matrix.
-    f32 cameraToObjectDepth = node->cameraToObject[2];
-
     #define VALID_DEPTH_MIDDLE (-20100.f / 2.f)
     #define VALID_DEPTH_RANGE (19900 / 2.f)
-    if (absf(cameraToObjectDepth - VALID_DEPTH_MIDDLE) >= VALID_DEPTH_RANGE + cullingRadius) {
+    if (absf(cameraToPos[2] - VALID_DEPTH_MIDDLE) >= VALID_DEPTH_RANGE + radius) {
+        PROFILER_ADD_COUNT(PROFILER_COUNT_CULLED, 1);
         return FALSE;
     }
 
@@ -983,23 +1460,27 @@ s32 obj_is_in_view(struct GraphNodeObject *node) {
     }
 #endif
 
-#ifdef VERTICAL_CULLING
-    f32 vScreenEdge = -cameraToObjectDepth * gCurGraphNodeCamFrustum->halfFovVertical;
-
-    // Unlike with horizontal culling, we only check if the object is bellow the screen
-    // to prevent shadows from being culled.
-    if (node->cameraToObject[1] < -vScreenEdge - cullingRadius) {
-        return FALSE;
+    for (i = 0; i < sNumFrustumPlanes; i++) {
+        if (vec3_dot(sFrustumPlanes[i], cameraToPos) > radius) {
+            PROFILER_ADD_COUNT(PROFILER_COUNT_CULLED, 1);
+            return FALSE;
+        }
     }
+    return TRUE;
+}
 
-#endif
-    
-    f32 hScreenEdge = -cameraToObjectDepth * gCurGraphNodeCamFrustum->halfFovHorizontal;
+s32 obj_is_in_view(struct GraphNodeObject *node) {
+    struct GraphNode *geo = node->sharedChild;
 
-    if (absf(node->cameraToObject[0]) > hScreenEdge + cullingRadius) {
-        return FALSE;
+    s16 cullingRadius;
+
+    if (geo != NULL && geo->type == GRAPH_NODE_TYPE_CULLING_RADIUS) {
+        cullingRadius = ((struct GraphNodeCullingRadius *) geo)->cullingRadius;
+    } else {
+        cullingRadius = DEFAULT_CULLING_RADIUS;
     }
-    return TRUE;
+
+    return sphere_is_in_view(node->cameraToObject, cullingRadius);
 }
 
 #ifdef VISUAL_DEBUG
@@ -1041,27 +1522,19 @@ void geo_process_object(struct Object *node) {
         s32 noThrowMatrix = (node->header.gfx.throwMatrix == NULL);
         // Maintain throw matrix pointer if the game is paused as it won't be updated.
         Mat4 *oldThrowMatrix = (sCurrPlayMode == PLAY_MODE_PAUSED) ? node->header.gfx.throwMatrix : NULL;
-
-        // If the throw matrix is null and the object is invisible, there is no need
-        // to update billboarding, scale, rotation, etc. 
-        // This still updates translation since it is needed for sound.
-        if (isInvisible && noThrowMatrix) {
-            mtxf_translate(gMatStack[gMatStackIndex + 1], node->header.gfx.pos);
-        }
-        else{
-            if (!noThrowMatrix) {
-                mtxf_scale_vec3f(gMatStack[gMatStackIndex + 1], *node->header.gfx.throwMatrix, node->header.gfx.scale);
-            } else if (node->header.gfx.node.flags & GRAPH_RENDER_BILLBOARD) {
-                mtxf_billboard(gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex],
-                            node->header.gfx.pos, node->header.gfx.scale, gCurGraphNodeCamera->roll);
-            } else {
-                mtxf_rotate_zxy_and_translate(gMatStack[gMatStackIndex + 1], node->header.gfx.pos, node->header.gfx.angle);
-                mtxf_scale_vec3f(gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex + 1], node->header.gfx.scale);
-            }
+        Mat4 *mtxf = &gMatStack[gMatStackIndex + 1];
+
+        // Only the translation is needed to check whether the object can be seen, so the rest of the matrix
+        // (billboarding, scale, rotation, etc.) is only worked out once it passes.
+        // The translation is always needed since it is used for sound.
+        if (!noThrowMatrix) {
+            vec3f_copy((*mtxf)[3], (*node->header.gfx.throwMatrix)[3]);
+        } else if (node->header.gfx.node.flags & GRAPH_RENDER_BILLBOARD) {
+            vec3f_sum((*mtxf)[3], node->header.gfx.pos, gMatStack[gMatStackIndex][3]);
+        } else {
+            vec3f_copy((*mtxf)[3], node->header.gfx.pos);
         }
-
-        node->header.gfx.throwMatrix = &gMatStack[++gMatStackIndex];
-        linear_mtxf_mul_vec3f_and_translate(gCameraTransform, node->header.gfx.cameraToObject, (*node->header.gfx.throwMatrix)[3]);
+        linear_mtxf_mul_vec3f_and_translate(gCameraTransform, node->header.gfx.cameraToObject, (*mtxf)[3]);
 
         // FIXME: correct types
         if (node->header.gfx.animInfo.curAnim != NULL) {
@@ -1069,9 +1542,27 @@ void geo_process_object(struct Object *node) {
         }
 
         if (!isInvisible && obj_is_in_view(&node->header.gfx)) {
-            gMatStackIndex--;
+            if (!noThrowMatrix) {
+                mtxf_scale_vec3f(*mtxf, *node->header.gfx.throwMatrix, node->header.gfx.scale);
+            } else if (node->header.gfx.node.flags & GRAPH_RENDER_BILLBOARD) {
+                mtxf_billboard_from_basis(*mtxf, gMatStack[gMatStackIndex], node->header.gfx.pos, node->header.gfx.scale);
+            } else {
+                mtxf_rotate_zxy_and_translate(*mtxf, node->header.gfx.pos, node->header.gfx.angle);
+                mtxf_scale_vec3f(*mtxf, *mtxf, node->header.gfx.scale);
+            }
+
+            node->header.gfx.throwMatrix = mtxf;
+            node->lastInViewFrame = gGlobalTimer;
             inc_mat_stack();
 
+#ifdef MASTER_LIST_BATCHING
+            u32 prevGroup = sCurDisplayListGroup;
+            // Skip 0, which is for display lists outside of objects.
+            if (++sNumDisplayListGroups % DISPLAY_LIST_GROUPS == 0) {
+                sNumDisplayListGroups++;
+            }
+            sCurDisplayListGroup = sNumDisplayListGroups;
+#endif
             if (node->header.gfx.sharedChild != NULL) {
 #ifdef VISUAL_DEBUG
                 if (hitboxView) visualise_object_hitbox(node);
@@ -1085,9 +1576,13 @@ void geo_process_object(struct Object *node) {
             if (node->header.gfx.node.children != NULL) {
                 geo_process_node_and_siblings(node->header.gfx.node.children);
             }
+#ifdef MASTER_LIST_BATCHING
+            sCurDisplayListGroup = prevGroup;
+#endif
+
+            gMatStackIndex--;
         }
 
-        gMatStackIndex--;
         gCurrAnimType = ANIM_TYPE_NONE;
         node->header.gfx.throwMatrix = oldThrowMatrix;
     }
@@ -1107,6 +1602,11 @@ void geo_process_object_parent(struct GraphNodeObjectParent *node) {
     if (node->node.children != NULL) {
         geo_process_node_and_siblings(node->node.children);
     }
+#ifdef PARTICLE_SYSTEM
+    if (gCurGraphNodeCamera != NULL) {
+        render_particles(gMatStack[gMatStackIndex], gCurGraphNodeCamera->roll, gCurGraphNodeRoot->areaIndex);
+    }
+#endif
 }
 
 /**
@@ -1176,6 +1676,27 @@ void geo_try_process_children(struct GraphNode *node) {
     }
 }
 
+/**
+ * Process a culling radius node. The ones at the top of an object's geo were already checked by
+ * obj_is_in_view, and held objects (whose geo has no parent while drawn) are never culled, so only the
+ * ones further down are checked here, at the origin of the current transform. Their children are
+ * skipped if they can't be seen.
+ */
+void geo_process_culling_radius(struct GraphNodeCullingRadius *node) {
+    struct GraphNode *parent = node->node.parent;
+
+    if (parent != NULL && parent->type != GRAPH_NODE_TYPE_OBJECT) {
+        Vec3f cameraToNode;
+
+        linear_mtxf_mul_vec3f_and_translate(gCameraTransform, cameraToNode, gMatStack[gMatStackIndex][3]);
+        if (!sphere_is_in_view(cameraToNode, node->cullingRadius)) {
+            return;
+        }
+    }
+
+    geo_try_process_children(&node->node);
+}
+
 typedef void (*GeoProcessFunc)();
 
 // See enum 'GraphNodeTypes' in 'graph_node.h'.
@@ -1199,7 +1720,7 @@ static GeoProcessFunc GeoProcessJumpTable[] = {
     [GRAPH_NODE_TYPE_GENERATED_LIST      ] = geo_process_generated_list,
     [GRAPH_NODE_TYPE_BACKGROUND          ] = geo_process_background,
     [GRAPH_NODE_TYPE_HELD_OBJ            ] = geo_process_held_object,
-    [GRAPH_NODE_TYPE_CULLING_RADIUS      ] = geo_try_process_children,
+    [GRAPH_NODE_TYPE_CULLING_RADIUS      ] = geo_process_culling_radius,
     [GRAPH_NODE_TYPE_ROOT                ] = geo_try_process_children,
     [GRAPH_NODE_TYPE_START               ] = geo_try_process_children,
 };
@@ -1244,11 +1765,21 @@ void geo_process_root(struct GraphNodeRoot *node, Vp *b, Vp *c, s32 clearColor)
     if (node->node.flags & GRAPH_RENDER_ACTIVE) {
         Mtx *initialMatrix;
         Vp *viewport = alloc_display_list(sizeof(*viewport));
+        PROFILER_SCOPE_BEGIN("Graph");
 
         gDisplayListHeap = alloc_only_pool_init(main_pool_available() - sizeof(struct AllocOnlyPool), MEMORY_POOL_LEFT);
+#ifdef GRAPH_NODE_MATRIX_CACHE
+        initialMatrix = &sIdentityMtx;
+        sMatStackCacheStates[0] = MAT_STACK_CACHED;
+        sMatrixCacheFrame++;
+#else
         initialMatrix = alloc_display_list(sizeof(*initialMatrix));
+#endif
         gCurLookAt = (LookAt*)alloc_display_list(sizeof(LookAt));
         bzero(gCurLookAt, sizeof(LookAt));
+#if defined(F3DEX_GBI_2) && defined(MASTER_LIST_BATCHING)
+        sLookAtLoaded = FALSE;
+#endif
 
         gMatStackIndex = 0;
         gCurrAnimType = ANIM_TYPE_NONE;
@@ -1283,5 +1814,6 @@ void geo_process_root(struct GraphNodeRoot *node, Vp *b, Vp *c, s32 clearColor)
         }
 #endif
         main_pool_free(gDisplayListHeap);
+        PROFILER_SCOPE_END();
     }
 }
@@ -68,6 +68,12 @@ struct RenderModeContainer {
 
 #define RENDER_PHASE_FIRST 0
 
+void geo_append_display_list(void *displayList, s32 layer);
+void geo_append_display_list_with_matrices(void *displayList, s32 layer);
+void geo_invalidate_matrix_cache(struct GraphNode *node);
+#ifdef GRAPH_NODE_MATRIX_CACHE
+void clear_matrix_caches(void);
+#endif
 void geo_process_node_and_siblings(struct GraphNode *firstNode);
 void geo_process_root(struct GraphNodeRoot *node, Vp *b, Vp *c, s32 clearColor);
 
@@ -1,18 +1,90 @@
 #include <PR/ultratypes.h>
 
 #include "audio/external.h"
+#include "config.h"
 #include "engine/geo_layout.h"
 #include "engine/graph_node.h"
 #include "engine/math_util.h"
 #include "engine/surface_collision.h"
+#include "game_init.h"
 #include "level_table.h"
 #include "object_constants.h"
 #include "object_fields.h"
+#include "object_grid.h"
 #include "object_helpers.h"
 #include "object_list_processor.h"
 #include "spawn_object.h"
 #include "types.h"
 
+/**
+ * Every allocated object, bucketed by a hash of its behavior, so that looking up the objects with a
+ * behavior doesn't have to walk its whole object list. Each bucket is kept in allocation order, which
+ * for the objects of one list is the same as their order in it.
+ */
+struct BehaviorBucket gBehaviorBuckets[BEHAVIOR_BUCKET_COUNT];
+static u32 sObjectAllocCount = 0;
+
+struct ObjectPoolStats gObjectPoolStats;
+
+static const u8 sObjectListReservedSlots[NUM_OBJ_LISTS] = OBJECT_LIST_RESERVED_SLOTS;
+// The free slots still reserved for the lists that have fewer objects than their reservation
+static s32 sNumReservedFreeSlots = 0;
+
+/**
+ * Objects that have been deactivated since the last unload, by pool slot, so that unloading them doesn't
+ * have to walk every object list. Each slot's place in the queue is kept so that objects unloaded some
+ * other way can be taken out of it.
+ */
+#define PENDING_UNLOAD_NONE 0xFFFF // Allocated, but not in the queue
+#define PENDING_UNLOAD_FREE 0xFFFE // In the free list
+static u16 sPendingUnloads[OBJECT_POOL_CAPACITY];
+static u16 sPendingUnloadIndex[OBJECT_POOL_CAPACITY];
+static u32 sNumPendingUnloads = 0;
+
+static void behavior_bucket_insert(struct Object *obj) {
+    struct BehaviorBucket *bucket = &gBehaviorBuckets[BEHAVIOR_BUCKET_INDEX(obj->behavior)];
+    struct Object *prevObj = bucket->tail;
+
+    // New objects always go at the end, but objects changing behavior might not.
+    while (prevObj != NULL && prevObj->allocOrder > obj->allocOrder) {
+        prevObj = prevObj->bhvBucketPrev;
+    }
+
+    obj->bhvBucketPrev = prevObj;
+    if (prevObj != NULL) {
+        obj->bhvBucketNext = prevObj->bhvBucketNext;
+        prevObj->bhvBucketNext = obj;
+    } else {
+        obj->bhvBucketNext = bucket->head;
+        bucket->head = obj;
+    }
+
+    if (obj->bhvBucketNext != NULL) {
+        obj->bhvBucketNext->bhvBucketPrev = obj;
+    } else {
+        bucket->tail = obj;
+    }
+}
+
+static void behavior_bucket_remove(struct Object *obj) {
+    struct BehaviorBucket *bucket = &gBehaviorBuckets[BEHAVIOR_BUCKET_INDEX(obj->behavior)];
+
+    if (obj->bhvBucketPrev != NULL) {
+        obj->bhvBucketPrev->bhvBucketNext = obj->bhvBucketNext;
+    } else {
+        bucket->head = obj->bhvBucketNext;
+    }
+
+    if (obj->bhvBucketNext != NULL) {
+        obj->bhvBucketNext->bhvBucketPrev = obj->bhvBucketPrev;
+    } else {
+        bucket->tail = obj->bhvBucketPrev;
+    }
+
+    obj->bhvBucketNext = NULL;
+    obj->bhvBucketPrev = NULL;
+}
+
 /**
  * Attempt to allocate an object from freeList (singly linked) and append it
  * to the end of destList (doubly linked). Return the object, or NULL if
@@ -73,10 +145,16 @@ void init_free_object_list(void) {
 
     // End the list
     obj->header.next = NULL;
+
+    for (i = 0; i < poolLength; i++) {
+        sPendingUnloadIndex[i] = PENDING_UNLOAD_FREE;
+    }
+    sNumPendingUnloads = 0;
 }
 
 /**
- * Clear each object list, without adding the objects back to the free list.
+ * Clear each object list and behavior bucket, without adding the objects back to the free list.
+ * The pool's stats start over, so their peaks are for the level being loaded.
  */
 void clear_object_lists(struct ObjectNode *objLists) {
     s32 i;
@@ -85,6 +163,96 @@ void clear_object_lists(struct ObjectNode *objLists) {
         objLists[i].next = &objLists[i];
         objLists[i].prev = &objLists[i];
     }
+
+    for (i = 0; i < BEHAVIOR_BUCKET_COUNT; i++) {
+        gBehaviorBuckets[i].head = NULL;
+        gBehaviorBuckets[i].tail = NULL;
+    }
+    sObjectAllocCount = 0;
+
+    bzero(&gObjectPoolStats, sizeof(gObjectPoolStats));
+    sNumReservedFreeSlots = 0;
+    for (i = 0; i < NUM_OBJ_LISTS; i++) {
+        sNumReservedFreeSlots += sObjectListReservedSlots[i];
+    }
+}
+
+/**
+ * Count an object going into or out of its list, keeping the reserved free slots up to date.
+ */
+static void object_pool_count_allocated(s32 objListIndex) {
+    u16 count = ++gObjectPoolStats.listCounts[objListIndex];
+
+    if (count <= sObjectListReservedSlots[objListIndex]) {
+        sNumReservedFreeSlots--;
+    }
+    if (count > gObjectPoolStats.listPeaks[objListIndex]) {
+        gObjectPoolStats.listPeaks[objListIndex] = count;
+    }
+    if (++gObjectPoolStats.numAllocated > gObjectPoolStats.peakAllocated) {
+        gObjectPoolStats.peakAllocated = gObjectPoolStats.numAllocated;
+    }
+}
+
+static void object_pool_count_freed(s32 objListIndex) {
+    if (gObjectPoolStats.listCounts[objListIndex]-- <= sObjectListReservedSlots[objListIndex]) {
+        sNumReservedFreeSlots++;
+    }
+    gObjectPoolStats.numAllocated--;
+}
+
+/**
+ * Whether an object can go into the given list without taking a free slot reserved for another list.
+ */
+static s32 object_pool_has_room(s32 objListIndex) {
+    s32 numReservedForOthers = sNumReservedFreeSlots;
+
+    if (gObjectPoolStats.listCounts[objListIndex] < sObjectListReservedSlots[objListIndex]) {
+        numReservedForOthers -= sObjectListReservedSlots[objListIndex] - gObjectPoolStats.listCounts[objListIndex];
+    }
+
+    return (OBJECT_POOL_CAPACITY - gObjectPoolStats.numAllocated > numReservedForOthers);
+}
+
+/**
+ * Queue a deactivated object to be unloaded at the end of the frame. Called by obj_mark_for_deletion and
+ * after each object updates, which between them see every object that gets deactivated.
+ */
+void queue_object_unload(struct Object *obj) {
+    u16 slot = obj - gObjectPool;
+
+    if (sPendingUnloadIndex[slot] == PENDING_UNLOAD_NONE) {
+        sPendingUnloadIndex[slot] = sNumPendingUnloads;
+        sPendingUnloads[sNumPendingUnloads++] = slot;
+    }
+}
+
+/**
+ * Take the next object out of the unload queue, or return NULL once it's empty. The object might have
+ * been activated again since it was queued.
+ */
+struct Object *next_pending_unload(void) {
+    u16 slot;
+
+    if (sNumPendingUnloads == 0) {
+        return NULL;
+    }
+
+    slot = sPendingUnloads[--sNumPendingUnloads];
+    sPendingUnloadIndex[slot] = PENDING_UNLOAD_NONE;
+    return &gObjectPool[slot];
+}
+
+static void remove_pending_unload(u16 slot) {
+    u16 index = sPendingUnloadIndex[slot];
+
+    if (index < sNumPendingUnloads) {
+        u16 lastSlot = sPendingUnloads[--sNumPendingUnloads];
+
+        sPendingUnloads[index] = lastSlot;
+        sPendingUnloadIndex[lastSlot] = index;
+    }
+    sPendingUnloadIndex[slot] = PENDING_UNLOAD_FREE;
 }
 
 /**
@@ -102,17 +270,26 @@ void unload_object(struct Object *obj) {
 
     obj->header.gfx.node.flags &= ~(GRAPH_RENDER_BILLBOARD | GRAPH_RENDER_ACTIVE);
 
+    behavior_bucket_remove(obj);
+    remove_pending_unload(obj - gObjectPool);
+    object_pool_count_freed(obj->objListIndex);
     deallocate_object(&gFreeObjectList, &obj->header);
 }
 
 /**
  * Attempt to allocate a new object slot into the given object list, freeing
  * an unimportant object if necessary. If this is not possible, hang using an
- * infinite loop.
+ * infinite loop. Unimportant objects are also freed when the only free slots
+ * left are reserved for other lists, but those are taken if there are none.
  */
-struct Object *allocate_object(struct ObjectNode *objList) {
+struct Object *allocate_object(s32 objListIndex) {
     s32 i;
-    struct Object *obj = try_allocate_object(objList, &gFreeObjectList);
+    struct ObjectNode *objList = &gObjectLists[objListIndex];
+    struct Object *obj = NULL;
+
+    if (object_pool_has_room(objListIndex)) {
+        obj = try_allocate_object(objList, &gFreeObjectList);
+    }
 
     // The object list is full if the newly created pointer is NULL.
     // If this happens, we first attempt to unload unimportant objects
@@ -121,24 +298,34 @@ struct Object *allocate_object(struct ObjectNode *objList) {
         // Look for an unimportant object to kick out.
         struct Object *unimportantObj = find_unimportant_object();
 
-        // If no unimportant object exists, then the object pool is exhausted.
-        if (unimportantObj == NULL) {
-            // We've met with a terrible fate.
-            while (TRUE) {
-            }
-        } else {
+        if (unimportantObj != NULL) {
             // If an unimportant object does exist, unload it and take its slot.
             unload_object(unimportantObj);
-            obj = try_allocate_object(objList, &gFreeObjectList);
-            if (gCurrentObject == obj) {
+            gObjectPoolStats.numUnimportantUnloaded++;
+            if (gCurrentObject == unimportantObj) {
                 //! Uh oh, the unimportant object was in the middle of
                 //  updating! This could cause some interesting logic errors,
                 //  but I don't know of any unimportant objects that spawn
                 //  other objects.
             }
+        } else if (gFreeObjectList.next != NULL) {
+            // Nothing could be unloaded, so use a slot reserved for another list.
+            gObjectPoolStats.numReserveOverruns++;
+        }
+
+        obj = try_allocate_object(objList, &gFreeObjectList);
+
+        // If there's still no slot, then the object pool is exhausted.
+        if (obj == NULL) {
+            // We've met with a terrible fate.
+            while (TRUE) {
+            }
         }
     }
 
+    sPendingUnloadIndex[obj - gObjectPool] = PENDING_UNLOAD_NONE;
+    object_pool_count_allocated(objListIndex);
+
     // Initialize object fields
 
     obj->activeFlags = ACTIVE_FLAG_ACTIVE | ACTIVE_FLAG_ALLOCATED;
@@ -199,7 +386,6 @@ struct Object *allocate_object(struct ObjectNode *objList) {
 struct Object *create_object(const BehaviorScript *bhvScript) {
     s32 objListIndex;
     struct Object *obj;
-    struct ObjectNode *objList;
 
     // If the first behavior script command is "begin <object list>", then
     // extract the object list from it
@@ -209,11 +395,16 @@ struct Object *create_object(const BehaviorScript *bhvScript) {
         objListIndex = OBJ_LIST_DEFAULT;
     }
 
-    objList = &gObjectLists[objListIndex];
-    obj = allocate_object(objList);
+    obj = allocate_object(objListIndex);
 
     obj->curBhvCommand = bhvScript;
     obj->behavior = bhvScript;
+    obj->objListIndex = objListIndex;
+    obj->allocOrder = sObjectAllocCount++;
+    obj->lodSkippedFrames = 0;
+    obj->lastInViewFrame = gGlobalTimer;
+    behavior_bucket_insert(obj);
+    object_grid_add_spawned(obj);
 
     if (objListIndex == OBJ_LIST_UNIMPORTANT) {
         obj->activeFlags |= ACTIVE_FLAG_UNIMPORTANT;
@@ -221,3 +412,12 @@ struct Object *create_object(const BehaviorScript *bhvScript) {
 
     return obj;
 }
+
+/**
+ * Change an object's behavior, moving it to the bucket of the new one. The object stays in its object list.
+ */
+void set_object_behavior(struct Object *obj, const BehaviorScript *behaviorAddr) {
+    behavior_bucket_remove(obj);
+    obj->behavior = behaviorAddr;
+    behavior_bucket_insert(obj);
+}
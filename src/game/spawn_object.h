@@ -2,10 +2,48 @@
 #define SPAWN_OBJECT_H
 
 #include "types.h"
+#include "object_list_processor.h"
+
+#define BEHAVIOR_BUCKET_COUNT 64
+#define BEHAVIOR_BUCKET_INDEX(behaviorAddr) \
+    ((((uintptr_t)(behaviorAddr) >> 2) ^ ((uintptr_t)(behaviorAddr) >> 8)) & (BEHAVIOR_BUCKET_COUNT - 1))
+
+struct BehaviorBucket {
+    struct Object *head;
+    struct Object *tail;
+};
+
+extern struct BehaviorBucket gBehaviorBuckets[BEHAVIOR_BUCKET_COUNT];
+
+/**
+ * The first allocated object whose behavior is in the same bucket as behaviorAddr (a virtual address).
+ * Follow bhvBucketNext for the rest, checking their behavior. Objects in the same list come in list order.
+ */
+static inline struct Object *behavior_bucket_first(const BehaviorScript *behaviorAddr) {
+    return gBehaviorBuckets[BEHAVIOR_BUCKET_INDEX(behaviorAddr)].head;
+}
+
+/**
+ * How full the object pool is, for tuning OBJECT_POOL_CAPACITY and OBJECT_LIST_RESERVED_SLOTS.
+ * Cleared whenever the objects are, so the peaks are for the current level.
+ */
+struct ObjectPoolStats {
+    u16 numAllocated;
+    u16 peakAllocated;
+    u16 listCounts[NUM_OBJ_LISTS];
+    u16 listPeaks[NUM_OBJ_LISTS];
+    u16 numUnimportantUnloaded; // Unimportant objects unloaded to make room for another object
+    u16 numReserveOverruns;     // Objects that took a slot reserved for another list, as nothing could be unloaded
+};
+
+extern struct ObjectPoolStats gObjectPoolStats;
 
 void init_free_object_list(void);
 void clear_object_lists(struct ObjectNode *objLists);
 void unload_object(struct Object *obj);
+void queue_object_unload(struct Object *obj);
+struct Object *next_pending_unload(void);
 struct Object *create_object(const BehaviorScript *bhvScript);
+void set_object_behavior(struct Object *obj, const BehaviorScript *behaviorAddr);
 
 #endif // SPAWN_OBJECT_H
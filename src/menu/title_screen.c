@@ -3,6 +3,7 @@
 #include "audio/external.h"
 #include "engine/math_util.h"
 #include "game/area.h"
+#include "game/demo_benchmark.h"
 #include "game/game_init.h"
 #include "game/level_update.h"
 #include "game/main.h"
@@ -255,6 +256,11 @@ s32 intro_play_its_a_me_mario(void) {
  * Returns a level ID after their criteria is met.
  */
 s32 lvl_intro_update(s16 arg, UNUSED s32 unusedArg) {
+#ifdef ENABLE_DEMO_BENCHMARK
+    if (arg == LVL_INTRO_REGULAR) {
+        return demo_benchmark_next_level();
+    }
+#endif
     switch (arg) {
         case LVL_INTRO_PLAY_ITS_A_ME_MARIO: return intro_play_its_a_me_mario();
 #ifdef KEEP_MARIO_HEAD
@@ -0,0 +1,430 @@
+/**
+ * Static collision partition baker.
+ *
+ * Loads every area's collision through the real load_area_terrain, then writes the resulting
+ * static surface pool and partition tables in the N64's layout, so that the game can read an
+ * area's partition with a single DMA instead of building it when the area loads. See
+ * struct BakedCollisionHeader in surface_load.h for the format.
+ *
+ * The pool is walked from the partition tables: every surface, node, skip table and sub-cell
+ * array is found by its host address, given its offset in the N64 pool in host address order
+ * (which is the order they were allocated in), and written out big-endian with each pointer
+ * replaced by an offset from the start of the blob.
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ultra64.h>
+#include "sm64.h"
+#include "surface_terrains.h"
+#include "level_misc_macros.h"
+#include "special_preset_names.h"
+#include "engine/surface_collision.h"
+#include "engine/surface_load.h"
+#include "game/object_list_processor.h"
+
+#include "bench_stubs.h"
+
+#include "bake_data.inc"
+
+// Unused, but referenced by the benchmark's stubs.
+const Collision *gBenchCollision = NULL;
+const char *gBenchCollisionName = NULL;
+
+struct BakeArea {
+    const char *file;
+    const char *level;
+    s32 areaIndex;
+    const Collision *collision;
+    const RoomData *rooms;
+    const char *collisionSymbol;
+    const char *roomsSymbol;
+};
+
+#define BAKE_AREA(file, level, areaIndex, collision, rooms) { file, #level, areaIndex, collision, rooms, #collision, #rooms },
+static const struct BakeArea sBakeAreas[] = {
+#include "bake_areas.inc"
+};
+#undef BAKE_AREA
+
+/**
+ * Sizes of the pool objects on the N64, where pointers are 4 bytes.
+ */
+#define N64_PTR_SIZE        4
+#define N64_SURFACE_OBJECT  (offsetof(struct Surface, originOffset) + sizeof(f32))
+#define N64_SURFACE_SIZE    (N64_SURFACE_OBJECT + N64_PTR_SIZE)
+#define N64_NODE_SIZE       (2 * N64_PTR_SIZE)
+#define N64_SKIP_TABLE_SIZE (sizeof(s32) + 2 * sizeof(u16) + NUM_SURFACE_SKIP_BANDS * sizeof(u16))
+#define N64_SUBCELL_SIZE    (4 * N64_PTR_SIZE)
+
+#ifdef STATIC_SURFACE_SUBCELLS
+#define NUM_BAKE_SUBCELLS (STATIC_SURFACE_SUBCELLS * STATIC_SURFACE_SUBCELLS)
+#else
+#define NUM_BAKE_SUBCELLS 0
+#endif
+
+enum BakeObjectType {
+    BAKE_OBJ_SURFACE,
+    BAKE_OBJ_NODE,
+    BAKE_OBJ_SKIP_TABLE,
+    BAKE_OBJ_SUBCELLS,
+};
+
+static const u32 sBakeObjectSizes[] = {
+    [BAKE_OBJ_SURFACE]    = N64_SURFACE_SIZE,
+    [BAKE_OBJ_NODE]       = N64_NODE_SIZE,
+    [BAKE_OBJ_SKIP_TABLE] = N64_SKIP_TABLE_SIZE,
+    [BAKE_OBJ_SUBCELLS]   = NUM_BAKE_SUBCELLS * N64_SUBCELL_SIZE,
+};
+
+struct BakeObject {
+    const void *addr;
+    u32 type;
+    u32 offset;
+};
+
+static struct BakeObject *sObjects;
+static u32 sNumObjects;
+static u32 sMaxObjects;
+
+/**
+ * The blob being written, and its relocation bitmap with one bit for each word.
+ */
+static u8 *sBlob;
+static u32 sBlobSize;
+static u32 *sRelocs;
+
+static void add_object(const void *addr, u32 type) {
+    if (addr == NULL) {
+        return;
+    }
+    if (sNumObjects == sMaxObjects) {
+        sMaxObjects = (sMaxObjects == 0) ? 0x4000 : (sMaxObjects * 2);
+        sObjects = realloc(sObjects, sMaxObjects * sizeof(struct BakeObject));
+    }
+    sObjects[sNumObjects].addr = addr;
+    sObjects[sNumObjects].type = type;
+    sNumObjects++;
+}
+
+static void add_list(const struct SurfaceNode *node) {
+    for (; node != NULL; node = node->next) {
+        add_object(node, BAKE_OBJ_NODE);
+    }
+}
+
+static int compare_objects(const void *a, const void *b) {
+    const struct BakeObject *objA = a;
+    const struct BakeObject *objB = b;
+
+    if (objA->addr != objB->addr) {
+        return ((uintptr_t) objA->addr < (uintptr_t) objB->addr) ? -1 : 1;
+    }
+    return 0;
+}
+
+static const struct BakeObject *find_object(const void *addr) {
+    struct BakeObject key = { .addr = addr };
+    const struct BakeObject *obj = bsearch(&key, sObjects, sNumObjects, sizeof(struct BakeObject), compare_objects);
+
+    if (obj == NULL) {
+        fprintf(stderr, "collision_bake: pointer %p is not in the pool\n", addr);
+        exit(1);
+    }
+    return obj;
+}
+
+static void write_be(u32 offset, u32 value, u32 size) {
+    for (u32 i = 0; i < size; i++) {
+        sBlob[offset + i] = value >> (8 * (size - 1 - i));
+    }
+}
+
+static void write_float(u32 offset, f32 value) {
+    u32 bits;
+    memcpy(&bits, &value, sizeof(bits));
+    write_be(offset, bits, sizeof(bits));
+}
+
+/**
+ * Write a pointer into the pool as an offset from the start of the blob. NULL stays NULL.
+ */
+static void write_pointer(u32 offset, const void *addr) {
+    if (addr == NULL) {
+        write_be(offset, 0, N64_PTR_SIZE);
+        return;
+    }
+    write_be(offset, find_object(addr)->offset, N64_PTR_SIZE);
+    sRelocs[offset / 32 / sizeof(u32)] |= 1 << ((offset / sizeof(u32)) % 32);
+}
+
+#define WRITE_FIELD(offset, object, field) \
+    write_be((offset) + offsetof(__typeof__(*(object)), field), (object)->field, sizeof((object)->field))
+
+static void write_surface(u32 offset, const struct Surface *surf) {
+    WRITE_FIELD(offset, surf, type);
+    WRITE_FIELD(offset, surf, force);
+    WRITE_FIELD(offset, surf, flags);
+    WRITE_FIELD(offset, surf, room);
+    WRITE_FIELD(offset, surf, lowerY);
+    WRITE_FIELD(offset, surf, upperY);
+    for (s32 i = 0; i < 3; i++) {
+        write_be(offset + offsetof(struct Surface, vertex1) + i * sizeof(Collision), surf->vertex1[i], sizeof(Collision));
+        write_be(offset + offsetof(struct Surface, vertex2) + i * sizeof(Collision), surf->vertex2[i], sizeof(Collision));
+        write_be(offset + offsetof(struct Surface, vertex3) + i * sizeof(Collision), surf->vertex3[i], sizeof(Collision));
+    }
+    write_float(offset + offsetof(struct Surface, normal.x), surf->normal.x);
+    write_float(offset + offsetof(struct Surface, normal.y), surf->normal.y);
+    write_float(offset + offsetof(struct Surface, normal.z), surf->normal.z);
+    write_float(offset + offsetof(struct Surface, originOffset), surf->originOffset);
+    write_pointer(offset + N64_SURFACE_OBJECT, surf->object);
+}
+
+static void write_node(u32 offset, const struct SurfaceNode *node) {
+    write_pointer(offset, node->next);
+    write_pointer(offset + N64_PTR_SIZE, node->surface);
+}
+
+static void write_skip_table(u32 offset, const struct SurfaceSkipTable *table) {
+    write_be(offset + 0, table->base, sizeof(s32));
+    write_be(offset + 4, table->shift, sizeof(u16));
+    write_be(offset + 6, table->numSurfaces, sizeof(u16));
+    for (s32 i = 0; i < NUM_SURFACE_SKIP_BANDS; i++) {
+        write_be(offset + 8 + i * sizeof(u16), table->skip[i], sizeof(u16));
+    }
+}
+
+#ifdef STATIC_SURFACE_SUBCELLS
+static void write_subcells(u32 offset, const struct SurfaceSubCell *subCells) {
+    for (s32 i = 0; i < NUM_BAKE_SUBCELLS; i++, offset += N64_SUBCELL_SIZE) {
+        write_pointer(offset + 0 * N64_PTR_SIZE, subCells[i].lists[SPATIAL_PARTITION_FLOORS]);
+        write_pointer(offset + 1 * N64_PTR_SIZE, subCells[i].lists[SPATIAL_PARTITION_CEILS]);
+        write_pointer(offset + 2 * N64_PTR_SIZE, subCells[i].skipTables[SPATIAL_PARTITION_FLOORS]);
+        write_pointer(offset + 3 * N64_PTR_SIZE, subCells[i].skipTables[SPATIAL_PARTITION_CEILS]);
+    }
+}
+#endif
+
+/**
+ * Find every object in the static pool, and give each its offset in the N64 pool.
+ * Returns the size of the N64 pool.
+ */
+static u32 collect_objects(void) {
+    s32 i, j, k;
+
+    sNumObjects = 0;
+
+    for (i = 0; i < gSurfacesAllocated; i++) {
+        add_object((struct Surface *) gCurrStaticSurfacePool + i, BAKE_OBJ_SURFACE);
+    }
+
+    for (i = 0; i < NUM_CELLS; i++) {
+        for (j = 0; j < NUM_CELLS; j++) {
+            for (k = 0; k < NUM_SPATIAL_PARTITIONS; k++) {
+                add_list(gStaticSurfacePartition[i][j][k]);
+            }
+            for (k = 0; k <= SPATIAL_PARTITION_CEILS; k++) {
+                add_object(gStaticSurfaceSkipTables[i][j][k], BAKE_OBJ_SKIP_TABLE);
+            }
+#ifdef STATIC_SURFACE_SUBCELLS
+            struct SurfaceSubCell *subCells = gStaticSurfaceSubCells[i][j];
+
+            if (subCells != NULL) {
+                add_object(subCells, BAKE_OBJ_SUBCELLS);
+                for (s32 n = 0; n < NUM_BAKE_SUBCELLS; n++) {
+                    for (k = 0; k <= SPATIAL_PARTITION_CEILS; k++) {
+                        add_list(subCells[n].lists[k]);
+                        add_object(subCells[n].skipTables[k], BAKE_OBJ_SKIP_TABLE);
+                    }
+                }
+            }
+#endif
+        }
+    }
+
+    // Lists and skip tables may be shared, so keep only the first of each address.
+    qsort(sObjects, sNumObjects, sizeof(struct BakeObject), compare_objects);
+
+    u32 numUnique = 0;
+    u32 offset = 0;
+
+    for (u32 n = 0; n < sNumObjects; n++) {
+        if (numUnique > 0 && sObjects[numUnique - 1].addr == sObjects[n].addr) {
+            continue;
+        }
+        sObjects[numUnique] = sObjects[n];
+        sObjects[numUnique].offset = offset;
+        offset += sBakeObjectSizes[sObjects[n].type];
+        numUnique++;
+    }
+    sNumObjects = numUnique;
+
+    return ALIGN8(offset);
+}
+
+/**
+ * Size of the sub-cell data in the N64 pool. It was all allocated at the end of the pool.
+ */
+static u32 get_subcell_data_size(u32 poolSize) {
+#ifdef STATIC_SURFACE_SUBCELLS
+    uintptr_t start = (uintptr_t) gCurrStaticSurfacePoolEnd - gStaticSubCellData;
+
+    for (u32 n = 0; n < sNumObjects; n++) {
+        if ((uintptr_t) sObjects[n].addr >= start) {
+            return poolSize - sObjects[n].offset;
+        }
+    }
+#endif
+    return 0;
+}
+
+/**
+ * Bake the area that was just loaded. The blob is left in sBlob.
+ */
+static void bake_area(void) {
+    u32 poolSize = collect_objects();
+    u32 partitionOffset = poolSize;
+    u32 skipTablesOffset = partitionOffset + NUM_CELLS * NUM_CELLS * NUM_SPATIAL_PARTITIONS * N64_PTR_SIZE;
+    u32 subCellsOffset = skipTablesOffset + NUM_CELLS * NUM_CELLS * (SPATIAL_PARTITION_CEILS + 1) * N64_PTR_SIZE;
+    u32 cellHeightsOffset = subCellsOffset;
+    s32 i, j, k;
+
+#ifdef STATIC_SURFACE_SUBCELLS
+    cellHeightsOffset += NUM_CELLS * NUM_CELLS * N64_PTR_SIZE;
+#endif
+    u32 relocOffset = cellHeightsOffset + NUM_CELLS * NUM_CELLS * sizeof(struct SurfaceCellHeights);
+
+    u32 numRelocWords = (relocOffset / sizeof(u32) + 31) / 32;
+    u32 headerOffset = ALIGN16(relocOffset + numRelocWords * sizeof(u32));
+
+    sBlobSize = headerOffset + sizeof(struct BakedCollisionHeader);
+    sBlob = calloc(sBlobSize, 1);
+    sRelocs = calloc(numRelocWords, sizeof(u32));
+
+    for (u32 n = 0; n < sNumObjects; n++) {
+        switch (sObjects[n].type) {
+            case BAKE_OBJ_SURFACE:    write_surface(sObjects[n].offset, sObjects[n].addr);    break;
+            case BAKE_OBJ_NODE:       write_node(sObjects[n].offset, sObjects[n].addr);       break;
+            case BAKE_OBJ_SKIP_TABLE: write_skip_table(sObjects[n].offset, sObjects[n].addr); break;
+#ifdef STATIC_SURFACE_SUBCELLS
+            case BAKE_OBJ_SUBCELLS:   write_subcells(sObjects[n].offset, sObjects[n].addr);   break;
+#endif
+        }
+    }
+
+    u32 cellIndex = 0;
+
+    for (i = 0; i < NUM_CELLS; i++) {
+        for (j = 0; j < NUM_CELLS; j++, cellIndex++) {
+            for (k = 0; k < NUM_SPATIAL_PARTITIONS; k++) {
+                write_pointer(partitionOffset + (cellIndex * NUM_SPATIAL_PARTITIONS + k) * N64_PTR_SIZE,
+                              gStaticSurfacePartition[i][j][k]);
+            }
+            for (k = 0; k <= SPATIAL_PARTITION_CEILS; k++) {
+                write_pointer(skipTablesOffset + (cellIndex * (SPATIAL_PARTITION_CEILS + 1) + k) * N64_PTR_SIZE,
+                              gStaticSurfaceSkipTables[i][j][k]);
+            }
+#ifdef STATIC_SURFACE_SUBCELLS
+            write_pointer(subCellsOffset + cellIndex * N64_PTR_SIZE, gStaticSurfaceSubCells[i][j]);
+#endif
+            write_be(cellHeightsOffset + cellIndex * sizeof(struct SurfaceCellHeights),
+                     gStaticSurfaceCellHeights[i][j].lowerY, sizeof(s16));
+            write_be(cellHeightsOffset + cellIndex * sizeof(struct SurfaceCellHeights) + sizeof(s16),
+                     gStaticSurfaceCellHeights[i][j].upperY, sizeof(s16));
+        }
+    }
+
+    for (u32 n = 0; n < numRelocWords; n++) {
+        write_be(relocOffset + n * sizeof(u32), sRelocs[n], sizeof(u32));
+    }
+
+    u32 header[] = {
+        BAKED_COLLISION_MAGIC,
+        BAKED_COLLISION_LAYOUT,
+        poolSize,
+        partitionOffset,
+        skipTablesOffset,
+        subCellsOffset,
+        cellHeightsOffset,
+        relocOffset,
+        gSurfacesAllocated,
+        gSurfaceNodesAllocated,
+#ifdef STATIC_SURFACE_SUBCELLS
+        gNumStaticSubdividedCells,
+#else
+        0,
+#endif
+        get_subcell_data_size(poolSize),
+    };
+
+    for (u32 n = 0; n < ARRAY_COUNT(header); n++) {
+        write_be(headerOffset + n * sizeof(u32), header[n], sizeof(u32));
+    }
+
+    free(sRelocs);
+}
+
+int main(void) {
+    u8 *blobs[ARRAY_COUNT(sBakeAreas)];
+    u32 blobSizes[ARRAY_COUNT(sBakeAreas)];
+    u32 i, n;
+
+    for (i = 0; i < ARRAY_COUNT(sBakeAreas); i++) {
+        bench_reset_main_pool();
+        alloc_surface_pools();
+        load_area_terrain(0, (TerrainData *) sBakeAreas[i].collision, (RoomData *) sBakeAreas[i].rooms, NULL);
+        bake_area();
+
+        blobs[i] = sBlob;
+        blobSizes[i] = sBlobSize;
+        fprintf(stderr, "collision_bake: %s: %d surfaces, %d nodes, 0x%X bytes\n",
+                sBakeAreas[i].file, gSurfacesAllocated, gSurfaceNodesAllocated, sBlobSize);
+    }
+
+    printf("#include <ultra64.h>\n");
+    printf("#include <stddef.h>\n");
+    printf("#include \"types.h\"\n");
+    printf("#include \"level_table.h\"\n");
+    printf("#include \"engine/surface_load.h\"\n\n");
+
+    for (i = 0; i < ARRAY_COUNT(sBakeAreas); i++) {
+        printf("extern const Collision %s[];\n", sBakeAreas[i].collisionSymbol);
+        if (sBakeAreas[i].rooms != NULL) {
+            printf("extern const RoomData %s[];\n", sBakeAreas[i].roomsSymbol);
+        }
+    }
+
+    printf("\nstruct BakedCollisionObj {\n");
+    printf("    u32 count;\n");
+    printf("    const void *addrPlaceholder;\n");
+    printf("    struct BakedCollisionEntry entries[%u];\n", (u32) ARRAY_COUNT(sBakeAreas));
+    for (i = 0; i < ARRAY_COUNT(sBakeAreas); i++) {
+        printf("    ALIGNED16 u8 %s[%u];\n", sBakeAreas[i].collisionSymbol, blobSizes[i]);
+    }
+    printf("} gBakedCollision = {\n");
+    printf("    %u,\n", (u32) ARRAY_COUNT(sBakeAreas));
+    printf("    NULL,\n");
+    printf("    {\n");
+    for (i = 0; i < ARRAY_COUNT(sBakeAreas); i++) {
+        printf("        { %s, %d, %s, %s, offsetof(struct BakedCollisionObj, %s), sizeof(gBakedCollision.%s) },\n",
+               sBakeAreas[i].level, sBakeAreas[i].areaIndex, sBakeAreas[i].collisionSymbol, sBakeAreas[i].roomsSymbol,
+               sBakeAreas[i].collisionSymbol, sBakeAreas[i].collisionSymbol);
+    }
+    printf("    },\n");
+
+    for (i = 0; i < ARRAY_COUNT(sBakeAreas); i++) {
+        printf("    // %s\n", sBakeAreas[i].file);
+        printf("    {");
+        for (n = 0; n < blobSizes[i]; n++) {
+            printf("%s0x%02X,", (n % 16 == 0) ? "\n        " : " ", blobs[i][n]);
+        }
+        printf("\n    },\n");
+        free(blobs[i]);
+    }
+    printf("};\n");
+
+    return 0;
+}
@@ -0,0 +1,164 @@
+/**
+ * Host stand-ins for the game state that surface_load.c and surface_collision.c
+ * reference. Only what the static collision path actually touches does any work;
+ * everything else is inert.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ultra64.h>
+#include "sm64.h"
+#include "types.h"
+#include "behavior_data.h"
+#include "engine/graph_node.h"
+#include "engine/math_util.h"
+#include "game/area.h"
+#include "game/camera.h"
+#include "game/debug.h"
+#include "game/ingame_menu.h"
+#include "game/level_update.h"
+#include "game/macro_special_objects.h"
+#include "game/memory.h"
+#include "game/object_helpers.h"
+#include "game/object_list_processor.h"
+#include "game/save_file.h"
+
+#include "bench_stubs.h"
+
+/**
+ * Object / area globals.
+ */
+struct Object gObjectPool[OBJECT_POOL_CAPACITY];
+struct Object *gCurrentObject = NULL;
+struct Object *gMarioObject = NULL;
+struct MarioState *gMarioState = NULL;
+struct Area *gCurrentArea = NULL;
+struct LakituState gLakituState;
+Mat4 gCameraTransform;
+const BehaviorScript bhvDddWarp[1];
+
+s16 gCollisionFlags = COLLISION_FLAGS_NONE;
+TerrainData *gEnvironmentRegions;
+s32 gEnvironmentLevels[20];
+s32 gSurfaceNodesAllocated;
+s32 gSurfacesAllocated;
+s32 gNumStaticSurfaceNodes;
+s32 gNumStaticSurfaces;
+s32 gNumFindFloorMisses;
+s16 gCCMEnteredSlide;
+s16 gCurrSaveFileNum = 1;
+u32 gTimeStopState;
+
+/**
+ * Main pool. A single malloc'd arena, allocated from the left only.
+ */
+static u8 *sBenchPool;
+static u32 sBenchPoolUsed;
+
+void bench_reset_main_pool(void) {
+    if (sBenchPool == NULL) {
+        sBenchPool = malloc(BENCH_MAIN_POOL_SIZE);
+    }
+    sBenchPoolUsed = 0;
+}
+
+u32 bench_main_pool_used(void) {
+    return sBenchPoolUsed;
+}
+
+void *main_pool_alloc(u32 size, UNUSED u32 side) {
+    size = ALIGN16(size);
+    if (sBenchPoolUsed + size > BENCH_MAIN_POOL_SIZE) {
+        return NULL;
+    }
+    void *addr = sBenchPool + sBenchPoolUsed;
+    sBenchPoolUsed += size;
+    return addr;
+}
+
+void *main_pool_realloc(void *addr, u32 size) {
+    // Only ever called on the most recent allocation, so just move the end back.
+    sBenchPoolUsed = ((u8 *) addr - sBenchPool) + ALIGN16(size);
+    return addr;
+}
+
+u32 main_pool_available(void) {
+    return BENCH_MAIN_POOL_SIZE - sBenchPoolUsed;
+}
+
+void __n64Assert(char *fileName, u32 lineNum, char *message) {
+    fprintf(stderr, "%s:%u: assertion failed: %s\n", fileName, lineNum, message);
+    abort();
+}
+
+void *segmented_to_virtual(const void *addr) {
+    return (void *) addr;
+}
+
+/**
+ * Special objects are not spawned, but their data still has to be skipped.
+ */
+#define BENCH_SPECIAL_PRESET(id, type) { id, type },
+static const struct {
+    u8 presetID;
+    u8 type;
+} sSpecialPresetTypes[] = {
+#include "special_preset_types.inc"
+};
+#undef BENCH_SPECIAL_PRESET
+
+void spawn_special_objects(UNUSED s32 areaIndex, TerrainData **specialObjList) {
+    s32 numOfSpecialObjects = *(*specialObjList)++;
+
+    for (s32 i = 0; i < numOfSpecialObjects; i++) {
+        u8 presetID = (u8) *(*specialObjList)++;
+        *specialObjList += 3;
+
+        for (u32 offset = 0; offset < ARRAY_COUNT(sSpecialPresetTypes); offset++) {
+            if (sSpecialPresetTypes[offset].presetID != presetID) {
+                continue;
+            }
+            switch (sSpecialPresetTypes[offset].type) {
+                case SPTYPE_YROT_NO_PARAMS:     *specialObjList += 1; break;
+                case SPTYPE_PARAMS_AND_YROT:    *specialObjList += 2; break;
+                case SPTYPE_UNKNOWN:            *specialObjList += 3; break;
+                case SPTYPE_DEF_PARAM_AND_YROT: *specialObjList += 1; break;
+                default: break;
+            }
+            break;
+        }
+    }
+}
+
+void spawn_macro_objects(UNUSED s32 areaIndex, UNUSED MacroObject *macroObjList) {
+}
+
+void spawn_macro_objects_hardcoded(UNUSED s32 areaIndex, UNUSED MacroObject *macroObjList) {
+}
+
+void reset_red_coins_collected(void) {
+}
+
+void clear_dynamic_surface_references(void) {
+}
+
+s32 save_file_get_total_star_count(UNUSED s32 fileIndex, UNUSED s32 minCourse, UNUSED s32 maxCourse) {
+    return 0;
+}
+
+f32 dist_between_objects(struct Object *obj1, struct Object *obj2) {
+    Vec3f d;
+    vec3_diff(d, &obj1->oPosVec, &obj2->oPosVec);
+    return sqrtf(vec3_sumsq(d));
+}
+
+void obj_build_transform_from_pos_and_angle(struct Object *obj, s16 posIndex, s16 angleIndex) {
+    Vec3f translate;
+    Vec3s rotation;
+
+    vec3i_to_vec3s(rotation, &obj->rawData.asS32[angleIndex]);
+    vec3f_copy(translate, &obj->rawData.asF32[posIndex]);
+    mtxf_rotate_zxy_and_translate(obj->transform, translate, rotation);
+}
@@ -0,0 +1,15 @@
+#ifndef BENCH_STUBS_H
+#define BENCH_STUBS_H
+
+#include "types.h"
+
+// Large enough for the static surface pool of any vanilla area.
+#define BENCH_MAIN_POOL_SIZE 0x1000000
+
+extern const Collision *gBenchCollision;
+extern const char *gBenchCollisionName;
+
+void bench_reset_main_pool(void);
+u32 bench_main_pool_used(void);
+
+#endif // BENCH_STUBS_H
@@ -0,0 +1,625 @@
+/**
+ * Host-native collision benchmark.
+ *
+ * Loads one area's collision through the real load_area_terrain, then replays a Mario
+ * trajectory through find_floor, find_ceil, find_wall_collisions and a camera raycast, and
+ * reports the time per query along with how many surface nodes each query had to walk.
+ *
+ * Trajectory files are plain text with one "x y z" position per line ('#' starts a comment),
+ * for example a RAM watch of gMarioState->pos dumped from an emulator. Without one, a random
+ * walk across the area's floors is synthesized instead.
+ *
+ * The checksums only depend on which surfaces were found and at what height, so they stay
+ * comparable across changes to the spatial partition.
+ *
+ * With REUSE_UNMOVED_DYNAMIC_SURFACES, it then checks that a stationary platform's surfaces are
+ * reused across frames, and exits with an error if they aren't.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <ultra64.h>
+#include "sm64.h"
+#include "engine/math_util.h"
+#include "engine/surface_collision.h"
+#include "engine/surface_load.h"
+#include "game/object_list_processor.h"
+
+#include "bench_stubs.h"
+
+#define DEFAULT_NUM_QUERIES  1000000
+#define DEFAULT_NUM_SAMPLES  4096
+#define DEFAULT_TOP_CELLS    8
+#define NUM_LOAD_ITERATIONS  16
+
+// Distance moved per synthesized trajectory step, roughly Mario's running speed.
+#define TRAJECTORY_STEP      32.0f
+// Largest step up or drop before the synthesized walk is restarted somewhere else.
+#define TRAJECTORY_MAX_STEP  100.0f
+#define TRAJECTORY_MAX_DROP  1000.0f
+
+// Raycasts go from Mario's head to where puppycam would place the camera.
+#define RAY_HEIGHT           120.0f
+#define RAY_DISTANCE         1000.0f
+#define RAY_PITCH            0x800
+
+enum BenchQuery {
+    BENCH_QUERY_FLOOR,
+    BENCH_QUERY_CEIL,
+    BENCH_QUERY_WALL,
+    BENCH_QUERY_RAY,
+    BENCH_QUERY_COUNT
+};
+
+static const char *sQueryNames[BENCH_QUERY_COUNT] = {
+    "floor",
+    "ceil",
+    "wall",
+    "ray",
+};
+
+struct BenchStats {
+    f64 nsPerQuery;
+    u32 hits;
+    u64 nodes;
+    u32 checksum;
+};
+
+struct BenchCellStats {
+    u16 cellX;
+    u16 cellZ;
+    u32 queries;
+    u64 nodes[BENCH_QUERY_COUNT];
+};
+
+static struct BenchStats sStats[BENCH_QUERY_COUNT];
+static struct BenchCellStats sCellStats[NUM_CELLS][NUM_CELLS];
+
+static f64 get_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec * 1e9) + ts.tv_nsec;
+}
+
+/**
+ * Small xorshift generator, so trajectories are identical on every host.
+ */
+static u32 sRandomState = 0x2545F491;
+
+static u32 bench_random_u32(void) {
+    sRandomState ^= sRandomState << 13;
+    sRandomState ^= sRandomState >> 17;
+    sRandomState ^= sRandomState << 5;
+    return sRandomState;
+}
+
+static f32 bench_random_range(f32 min, f32 max) {
+    return min + ((bench_random_u32() & 0xFFFFFF) / (f32) 0x1000000) * (max - min);
+}
+
+/**
+ * FNV-1a over the identity of a found surface, independent of where it lives in memory.
+ */
+static u32 checksum_add(u32 hash, const void *data, size_t size) {
+    const u8 *bytes = data;
+    while (size--) {
+        hash = (hash ^ *bytes++) * 0x01000193;
+    }
+    return hash;
+}
+
+static u32 checksum_surface(u32 hash, struct Surface *surf, f32 value) {
+    hash = checksum_add(hash, surf->vertex1, sizeof(surf->vertex1));
+    hash = checksum_add(hash, surf->vertex2, sizeof(surf->vertex2));
+    hash = checksum_add(hash, surf->vertex3, sizeof(surf->vertex3));
+    hash = checksum_add(hash, &surf->type, sizeof(surf->type));
+    return checksum_add(hash, &value, sizeof(value));
+}
+
+/**
+ * Number of surface nodes in one partition of a cell, static and dynamic.
+ * The static list starts from staticList, so that skipped nodes are not counted.
+ */
+static u32 cell_list_length(s32 cellX, s32 cellZ, s32 partition, struct SurfaceNode *staticList) {
+    struct SurfaceNode *node;
+    u32 count = 0;
+
+    for (node = staticList; node != NULL; node = node->next) {
+        count++;
+    }
+    for (node = gDynamicSurfacePartition[cellZ][cellX][partition]; node != NULL; node = node->next) {
+        count++;
+    }
+
+    return count;
+}
+
+/**
+ * Mirrors the cell ranges walked by find_floor, find_ceil and find_wall_collisions.
+ */
+static u32 count_query_nodes(enum BenchQuery query, Vec3f pos, f32 radius) {
+    s32 x = pos[0];
+    s32 z = pos[2];
+    u32 count = 0;
+
+    if (is_outside_level_bounds(x, z)) {
+        return 0;
+    }
+
+    if (query == BENCH_QUERY_WALL) {
+        for (s32 cellX = GET_CELL_COORD(x - radius); cellX <= GET_CELL_COORD(x + radius); cellX++) {
+            for (s32 cellZ = GET_CELL_COORD(z - radius); cellZ <= GET_CELL_COORD(z + radius); cellZ++) {
+                count += cell_list_length(cellX, cellZ, SPATIAL_PARTITION_WALLS,
+                                          gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WALLS]);
+            }
+        }
+        return count;
+    }
+
+    s32 cellX = GET_CELL_COORD(x);
+    s32 cellZ = GET_CELL_COORD(z);
+
+    if (query == BENCH_QUERY_FLOOR) {
+        return cell_list_length(cellX, cellZ, SPATIAL_PARTITION_FLOORS,
+                                get_static_floor_list(x, z, (s32) pos[1] + FIND_FLOOR_BUFFER));
+    }
+
+    return cell_list_length(cellX, cellZ, SPATIAL_PARTITION_CEILS,
+                            get_static_ceil_list(x, z, (s32) (pos[1] + 3.0f)));
+}
+
+/**
+ * The queries themselves, matching how mario_step.c performs them.
+ */
+static f32 run_floor_query(Vec3f pos, struct Surface **surf) {
+    return find_floor(pos[0], pos[1], pos[2], surf);
+}
+
+static f32 run_ceil_query(Vec3f pos, struct Surface **surf) {
+    return find_ceil(pos[0], pos[1] + 3.0f, pos[2], surf);
+}
+
+static s32 run_wall_query(Vec3f pos, f32 offsetY, f32 radius, struct WallCollisionData *data) {
+    data->x = pos[0];
+    data->y = pos[1];
+    data->z = pos[2];
+    data->offsetY = offsetY;
+    data->radius = radius;
+    return find_wall_collisions(data);
+}
+
+/**
+ * A different yaw for each sample, so the rays point every which way.
+ */
+static f32 run_ray_query(Vec3f pos, s32 index, struct Surface **surf, Vec3f hitPos) {
+    s16 yaw = index * 0x2F1D;
+    Vec3f orig = { pos[0], pos[1] + RAY_HEIGHT, pos[2] };
+    Vec3f dir = {
+        sins(yaw) * coss(RAY_PITCH) * RAY_DISTANCE,
+        sins(RAY_PITCH) * RAY_DISTANCE,
+        coss(yaw) * coss(RAY_PITCH) * RAY_DISTANCE,
+    };
+    return find_surface_on_ray(orig, dir, surf, hitPos, RAYCAST_FIND_FLOOR | RAYCAST_FIND_CEIL | RAYCAST_FIND_WALL);
+}
+
+/**
+ * Load the area's collision, averaged over several reloads.
+ */
+static f64 load_collision(void) {
+    f64 total = 0.0;
+
+    for (s32 i = 0; i < NUM_LOAD_ITERATIONS; i++) {
+        bench_reset_main_pool();
+        alloc_surface_pools();
+
+        f64 start = get_time_ns();
+        load_area_terrain(0, (TerrainData *) gBenchCollision, NULL, NULL);
+        total += get_time_ns() - start;
+    }
+
+    clear_dynamic_surfaces();
+
+    return total / NUM_LOAD_ITERATIONS;
+}
+
+#ifdef REUSE_UNMOVED_DYNAMIC_SURFACES
+// Height of the test platform's top, above any vanilla area's floors.
+#define PLATFORM_HEIGHT      8000.0f
+
+static const BehaviorScript bhvBenchPlatform[1];
+
+/**
+ * A 400 unit cube, like a typical moving platform.
+ */
+static const Collision sBenchPlatformCollision[] = {
+    COL_INIT(),
+    COL_VERTEX_INIT(8),
+    COL_VERTEX(-200, -400, -200),
+    COL_VERTEX( 200, -400, -200),
+    COL_VERTEX( 200, -400,  200),
+    COL_VERTEX(-200, -400,  200),
+    COL_VERTEX(-200,    0, -200),
+    COL_VERTEX( 200,    0, -200),
+    COL_VERTEX( 200,    0,  200),
+    COL_VERTEX(-200,    0,  200),
+    COL_TRI_INIT(SURFACE_DEFAULT, 12),
+    COL_TRI(4, 6, 5),
+    COL_TRI(4, 7, 6),
+    COL_TRI(0, 1, 2),
+    COL_TRI(0, 2, 3),
+    COL_TRI(0, 4, 5),
+    COL_TRI(0, 5, 1),
+    COL_TRI(1, 5, 6),
+    COL_TRI(1, 6, 2),
+    COL_TRI(2, 6, 7),
+    COL_TRI(2, 7, 3),
+    COL_TRI(3, 7, 4),
+    COL_TRI(3, 4, 0),
+    COL_TRI_STOP(),
+    COL_END(),
+};
+
+/**
+ * Run one frame of dynamic collision for the platform, returning how many of its surfaces were reused.
+ * Like geo_process_object, the throw matrix is cleared before every frame.
+ */
+static s32 load_platform_frame(struct Object *platform, f32 *floorHeight) {
+    struct Surface *floor;
+
+    clear_dynamic_surfaces();
+
+    platform->header.gfx.throwMatrix = NULL;
+    gCurrentObject = platform;
+    load_object_collision_model();
+
+    *floorHeight = find_floor(platform->oPosX, PLATFORM_HEIGHT + 100.0f, platform->oPosZ, &floor);
+    if (floor == NULL || floor->object != platform) {
+        *floorHeight = FLOOR_LOWER_LIMIT;
+    }
+
+    return gNumReusedDynamicSurfaces;
+}
+
+/**
+ * Check that a stationary platform's surfaces are reused, and that they're rebuilt once it moves.
+ */
+static s32 check_dynamic_surface_reuse(void) {
+    struct Object *mario = &gObjectPool[0];
+    struct Object *platform = &gObjectPool[1];
+    f32 floorHeight[3];
+    s32 numReused[3];
+
+    memset(mario, 0, sizeof(*mario));
+    memset(platform, 0, sizeof(*platform));
+    gMarioObject = mario;
+    vec3f_set(&mario->oPosVec, 0.0f, PLATFORM_HEIGHT, 0.0f);
+
+    platform->behavior = bhvBenchPlatform;
+    platform->collisionData = (TerrainData *) sBenchPlatformCollision;
+    platform->oFlags = OBJ_FLAG_DONT_CALC_COLL_DIST;
+    platform->oCollisionDistance = 2000.0f;
+    platform->oDistanceToMario = 0.0f;
+    vec3f_set(&platform->oPosVec, 0.0f, PLATFORM_HEIGHT, 0.0f);
+    vec3f_set(platform->header.gfx.scale, 1.0f, 1.0f, 1.0f);
+
+    load_platform_frame(platform, &floorHeight[0]);
+    numReused[0] = load_platform_frame(platform, &floorHeight[0]);
+    numReused[1] = load_platform_frame(platform, &floorHeight[1]);
+    platform->oPosY += 10.0f;
+    numReused[2] = load_platform_frame(platform, &floorHeight[2]);
+
+    clear_dynamic_surfaces();
+    gMarioObject = NULL;
+    gCurrentObject = NULL;
+
+    printf("dynamic: platform surfaces reused %d, %d, then %d after moving; floor %.0f, %.0f, %.0f\n",
+           numReused[0], numReused[1], numReused[2], floorHeight[0], floorHeight[1], floorHeight[2]);
+
+    return (numReused[0] == 12 && numReused[1] == 12 && numReused[2] == 0
+         && floorHeight[0] == PLATFORM_HEIGHT && floorHeight[1] == PLATFORM_HEIGHT
+         && floorHeight[2] == PLATFORM_HEIGHT + 10.0f);
+}
+#endif
+
+static s32 read_trajectory(const char *path, Vec3f **samples) {
+    FILE *file = fopen(path, "r");
+    char line[256];
+    s32 numSamples = 0;
+    s32 capacity = 0;
+
+    if (file == NULL) {
+        perror(path);
+        exit(1);
+    }
+
+    while (fgets(line, sizeof(line), file) != NULL) {
+        Vec3f pos;
+        if (line[0] == '#' || sscanf(line, "%f %f %f", &pos[0], &pos[1], &pos[2]) != 3) {
+            continue;
+        }
+        if (numSamples == capacity) {
+            capacity = (capacity == 0) ? 1024 : (capacity * 2);
+            *samples = realloc(*samples, capacity * sizeof(Vec3f));
+        }
+        vec3f_copy((*samples)[numSamples], pos);
+        numSamples++;
+    }
+
+    fclose(file);
+    return numSamples;
+}
+
+/**
+ * Drop a position somewhere above the area's vertex bounds and land it on the highest floor.
+ */
+static s32 place_on_random_floor(Vec3f pos, Vec3f boundsMin, Vec3f boundsMax) {
+    struct Surface *floor;
+
+    for (s32 attempt = 0; attempt < 1000; attempt++) {
+        pos[0] = bench_random_range(boundsMin[0], boundsMax[0]);
+        pos[2] = bench_random_range(boundsMin[2], boundsMax[2]);
+        pos[1] = find_floor(pos[0], boundsMax[1], pos[2], &floor);
+        if (floor != NULL) {
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+static s32 synthesize_trajectory(s32 numSamples, Vec3f **samples) {
+    const TerrainData *data = gBenchCollision;
+    Vec3f boundsMin = { LEVEL_BOUNDARY_MAX, LEVEL_BOUNDARY_MAX, LEVEL_BOUNDARY_MAX };
+    Vec3f boundsMax = { -LEVEL_BOUNDARY_MAX, -LEVEL_BOUNDARY_MAX, -LEVEL_BOUNDARY_MAX };
+    struct Surface *floor;
+    Vec3f pos;
+    s16 yaw = 0;
+
+    if (*data++ != TERRAIN_LOAD_VERTICES) {
+        return 0;
+    }
+    for (s32 numVertices = *data++; numVertices > 0; numVertices--, data += 3) {
+        for (s32 i = 0; i < 3; i++) {
+            boundsMin[i] = MIN(boundsMin[i], data[i]);
+            boundsMax[i] = MAX(boundsMax[i], data[i]);
+        }
+    }
+
+    *samples = malloc(numSamples * sizeof(Vec3f));
+    if (!place_on_random_floor(pos, boundsMin, boundsMax)) {
+        return 0;
+    }
+
+    for (s32 i = 0; i < numSamples; i++) {
+        yaw += (s16)(bench_random_u32() & 0xFFF) - 0x800;
+
+        f32 nextX = pos[0] + (sins(yaw) * TRAJECTORY_STEP);
+        f32 nextZ = pos[2] + (coss(yaw) * TRAJECTORY_STEP);
+        f32 floorHeight = find_floor(nextX, pos[1] + TRAJECTORY_MAX_STEP, nextZ, &floor);
+
+        if (floor == NULL || floorHeight < pos[1] - TRAJECTORY_MAX_DROP) {
+            if (!place_on_random_floor(pos, boundsMin, boundsMax)) {
+                return i;
+            }
+        } else {
+            pos[0] = nextX;
+            pos[1] = floorHeight;
+            pos[2] = nextZ;
+        }
+
+        vec3f_copy((*samples)[i], pos);
+    }
+
+    return numSamples;
+}
+
+/**
+ * One untimed pass over every sample, for hit counts, checksums and node walk lengths.
+ */
+static void gather_sample_stats(Vec3f *samples, s32 numSamples) {
+    struct WallCollisionData wallData;
+    struct Surface *surf;
+    Vec3f hitPos;
+    f32 height;
+
+    for (s32 i = 0; i < numSamples; i++) {
+        f32 *pos = samples[i];
+        s32 x = pos[0];
+        s32 z = pos[2];
+        u32 nodes[BENCH_QUERY_COUNT];
+
+        height = run_floor_query(pos, &surf);
+        if (surf != NULL) {
+            sStats[BENCH_QUERY_FLOOR].hits++;
+            sStats[BENCH_QUERY_FLOOR].checksum = checksum_surface(sStats[BENCH_QUERY_FLOOR].checksum, surf, height);
+        }
+
+        height = run_ceil_query(pos, &surf);
+        if (surf != NULL) {
+            sStats[BENCH_QUERY_CEIL].hits++;
+            sStats[BENCH_QUERY_CEIL].checksum = checksum_surface(sStats[BENCH_QUERY_CEIL].checksum, surf, height);
+        }
+
+        if (run_wall_query(pos, 60.0f, 50.0f, &wallData) > 0) {
+            sStats[BENCH_QUERY_WALL].hits++;
+            for (s32 w = 0; w < wallData.numWalls; w++) {
+                sStats[BENCH_QUERY_WALL].checksum = checksum_surface(sStats[BENCH_QUERY_WALL].checksum, wallData.walls[w], wallData.x + wallData.z);
+            }
+        }
+
+        run_ray_query(pos, i, &surf, hitPos);
+        if (surf != NULL) {
+            sStats[BENCH_QUERY_RAY].hits++;
+            sStats[BENCH_QUERY_RAY].checksum = checksum_surface(sStats[BENCH_QUERY_RAY].checksum, surf, hitPos[1]);
+        }
+
+        nodes[BENCH_QUERY_FLOOR] = count_query_nodes(BENCH_QUERY_FLOOR, pos, 0.0f);
+        nodes[BENCH_QUERY_CEIL]  = count_query_nodes(BENCH_QUERY_CEIL,  pos, 0.0f);
+        nodes[BENCH_QUERY_WALL]  = count_query_nodes(BENCH_QUERY_WALL,  pos, 50.0f);
+        nodes[BENCH_QUERY_RAY]   = 0;
+
+        if (is_outside_level_bounds(x, z)) {
+            continue;
+        }
+
+        struct BenchCellStats *cell = &sCellStats[GET_CELL_COORD(z)][GET_CELL_COORD(x)];
+        cell->cellX = GET_CELL_COORD(x);
+        cell->cellZ = GET_CELL_COORD(z);
+        cell->queries++;
+        for (s32 q = 0; q < BENCH_QUERY_COUNT; q++) {
+            cell->nodes[q] += nodes[q];
+            sStats[q].nodes += nodes[q];
+        }
+    }
+}
+
+static void time_queries(Vec3f *samples, s32 numSamples, u32 numQueries) {
+    struct WallCollisionData wallData;
+    struct Surface *surf;
+    Vec3f hitPos;
+    volatile f32 sink = 0.0f;
+    f64 start;
+
+    start = get_time_ns();
+    for (u32 q = 0; q < numQueries; q++) {
+        sink += run_floor_query(samples[q % numSamples], &surf);
+    }
+    sStats[BENCH_QUERY_FLOOR].nsPerQuery = (get_time_ns() - start) / numQueries;
+
+    start = get_time_ns();
+    for (u32 q = 0; q < numQueries; q++) {
+        sink += run_ceil_query(samples[q % numSamples], &surf);
+    }
+    sStats[BENCH_QUERY_CEIL].nsPerQuery = (get_time_ns() - start) / numQueries;
+
+    start = get_time_ns();
+    for (u32 q = 0; q < numQueries; q++) {
+        sink += run_wall_query(samples[q % numSamples], 60.0f, 50.0f, &wallData);
+    }
+    sStats[BENCH_QUERY_WALL].nsPerQuery = (get_time_ns() - start) / numQueries;
+
+    start = get_time_ns();
+    for (u32 q = 0; q < numQueries; q++) {
+        sink += run_ray_query(samples[q % numSamples], q % numSamples, &surf, hitPos);
+    }
+    sStats[BENCH_QUERY_RAY].nsPerQuery = (get_time_ns() - start) / numQueries;
+}
+
+static int compare_cell_nodes(const void *a, const void *b) {
+    const struct BenchCellStats *cellA = *(const struct BenchCellStats **) a;
+    const struct BenchCellStats *cellB = *(const struct BenchCellStats **) b;
+    u64 nodesA = cellA->nodes[BENCH_QUERY_FLOOR] + cellA->nodes[BENCH_QUERY_CEIL] + cellA->nodes[BENCH_QUERY_WALL];
+    u64 nodesB = cellB->nodes[BENCH_QUERY_FLOOR] + cellB->nodes[BENCH_QUERY_CEIL] + cellB->nodes[BENCH_QUERY_WALL];
+    return (nodesA < nodesB) - (nodesA > nodesB);
+}
+
+static void print_cell_stats(s32 numTopCells) {
+    struct BenchCellStats *cells[NUM_CELLS * NUM_CELLS];
+    s32 numCells = 0;
+
+    for (s32 cellZ = 0; cellZ < NUM_CELLS; cellZ++) {
+        for (s32 cellX = 0; cellX < NUM_CELLS; cellX++) {
+            if (sCellStats[cellZ][cellX].queries != 0) {
+                cells[numCells++] = &sCellStats[cellZ][cellX];
+            }
+        }
+    }
+
+    qsort(cells, numCells, sizeof(cells[0]), compare_cell_nodes);
+
+    printf("\nnodes walked per query, busiest %d of %d visited cells:\n", MIN(numTopCells, numCells), numCells);
+    printf("  cell x,z   queries   floor    ceil    wall\n");
+    for (s32 i = 0; i < MIN(numTopCells, numCells); i++) {
+        struct BenchCellStats *cell = cells[i];
+        printf("  %4d,%-4d %8u %7.1f %7.1f %7.1f\n", cell->cellX, cell->cellZ, cell->queries,
+               (f64) cell->nodes[BENCH_QUERY_FLOOR] / cell->queries,
+               (f64) cell->nodes[BENCH_QUERY_CEIL]  / cell->queries,
+               (f64) cell->nodes[BENCH_QUERY_WALL]  / cell->queries);
+    }
+}
+
+static void usage(const char *name) {
+    fprintf(stderr,
+            "Usage: %s [-n queries] [-s samples] [-t trajectory.txt] [-r seed] [-c cells]\n"
+            "  -n  number of timed queries of each kind (default %d)\n"
+            "  -s  number of synthesized trajectory samples (default %d)\n"
+            "  -t  replay positions from a text file of \"x y z\" lines instead\n"
+            "  -r  seed for the synthesized trajectory\n"
+            "  -c  number of cells to list in the per-cell breakdown (default %d)\n",
+            name, DEFAULT_NUM_QUERIES, DEFAULT_NUM_SAMPLES, DEFAULT_TOP_CELLS);
+    exit(1);
+}
+
+int main(int argc, char **argv) {
+    u32 numQueries = DEFAULT_NUM_QUERIES;
+    s32 numSamples = DEFAULT_NUM_SAMPLES;
+    s32 numTopCells = DEFAULT_TOP_CELLS;
+    const char *trajectoryPath = NULL;
+    Vec3f *samples = NULL;
+
+    for (s32 i = 1; i < argc; i++) {
+        if (i + 1 >= argc || argv[i][0] != '-') {
+            usage(argv[0]);
+        }
+        switch (argv[i][1]) {
+            case 'n': numQueries = strtoul(argv[++i], NULL, 0); break;
+            case 's': numSamples = strtol(argv[++i], NULL, 0); break;
+            case 't': trajectoryPath = argv[++i]; break;
+            case 'r': sRandomState = strtoul(argv[++i], NULL, 0) | 1; break;
+            case 'c': numTopCells = strtol(argv[++i], NULL, 0); break;
+            default: usage(argv[0]);
+        }
+    }
+
+    f64 loadTime = load_collision();
+
+    printf("collision: %s\n", gBenchCollisionName);
+    printf("  surfaces %d, nodes %d, static pool 0x%X bytes, load %.3f ms\n",
+           gNumStaticSurfaces, gNumStaticSurfaceNodes, gTotalStaticSurfaceData, loadTime / 1e6);
+
+    if (trajectoryPath != NULL) {
+        numSamples = read_trajectory(trajectoryPath, &samples);
+        printf("trajectory: %s, %d samples\n", trajectoryPath, numSamples);
+    } else {
+        numSamples = synthesize_trajectory(numSamples, &samples);
+        printf("trajectory: synthesized, %d samples\n", numSamples);
+    }
+
+    if (numSamples <= 0 || numQueries == 0) {
+        fprintf(stderr, "nothing to replay\n");
+        return 1;
+    }
+
+    gather_sample_stats(samples, numSamples);
+    time_queries(samples, numSamples, numQueries);
+
+    printf("\nquery    queries   ns/query   nodes/query   hit rate   checksum\n");
+    for (s32 q = 0; q < BENCH_QUERY_COUNT; q++) {
+        printf("%-6s %9u %10.1f", sQueryNames[q], numQueries, sStats[q].nsPerQuery);
+        // Raycast node walks aren't mirrored.
+        if (q == BENCH_QUERY_RAY) {
+            printf(" %13s", "-");
+        } else {
+            printf(" %13.1f", (f64) sStats[q].nodes / numSamples);
+        }
+        printf(" %9.1f%%   %08X\n", (100.0 * sStats[q].hits) / numSamples, sStats[q].checksum);
+    }
+
+    print_cell_stats(numTopCells);
+
+    free(samples);
+
+#ifdef REUSE_UNMOVED_DYNAMIC_SURFACES
+    printf("\n");
+    if (!check_dynamic_surface_reuse()) {
+        fprintf(stderr, "dynamic surfaces weren't reused as expected\n");
+        return 1;
+    }
+#endif
+    return 0;
+}
@@ -0,0 +1,15 @@
+/**
+ * Wraps one area's collision.inc.c so the benchmark can link against it.
+ * COLLISION_FILE and COLLISION_SYMBOL are passed in by the Makefile.
+ */
+
+#include <ultra64.h>
+#include "sm64.h"
+#include "surface_terrains.h"
+#include "level_misc_macros.h"
+#include "special_preset_names.h"
+
+#include COLLISION_FILE
+
+const Collision *gBenchCollision = COLLISION_SYMBOL;
+const char *gBenchCollisionName = COLLISION_FILE;
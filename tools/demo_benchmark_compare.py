@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+"""
+Compares the results of two runs of the demo benchmark (ENABLE_DEMO_BENCHMARK in config_benchmark.h).
+
+Pass the logs that UNFLoader or the emulator printed for each build. Everything but the benchmark's
+CSV lines is ignored, so the whole log can be passed as is:
+
+    demo_benchmark_compare.py before.txt after.txt
+    demo_benchmark_compare.py --stat p99 --threshold 5 before.txt after.txt
+
+Prints every level's chosen stat of each time in both runs, with the difference in percent. With
+--threshold, exits with 1 if any of them got slower by more than that many percent.
+"""
+import argparse
+import sys
+
+TIMES = ["frame", "cpu", "rsp", "rdp"]
+STATS = ["min", "avg", "p99", "max"]
+
+
+def read_results(path):
+    results = {}
+    columns = None
+    with open(path, errors="replace") as file:
+        for line in file:
+            # Logs can have other output on the same line, so look for the start of the CSV.
+            line = line.strip()
+            start = line.find("level,frames,")
+            if start >= 0:
+                columns = line[start:].split(",")
+                continue
+            if columns is None:
+                continue
+            values = line.split(",")
+            if len(values) != len(columns):
+                continue
+            row = dict(zip(columns, values))
+            try:
+                results[row["level"]] = {key: int(value) for key, value in row.items() if key not in ("level", "result")}
+            except ValueError:
+                continue
+            results[row["level"]]["result"] = row["result"]
+    if not results:
+        sys.exit("{}: no demo benchmark results found".format(path))
+    return results
+
+
+def percent(before, after):
+    if before == 0:
+        return 0.0
+    return (after - before) * 100.0 / before
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare the results of two demo benchmark runs.")
+    parser.add_argument("before", help="log of the build to compare against")
+    parser.add_argument("after", help="log of the new build")
+    parser.add_argument("--stat", choices=STATS, default="avg", help="stat to compare (default avg)")
+    parser.add_argument("--threshold", type=float, default=0, help="fail if a time got slower by more than this many percent")
+    args = parser.parse_args()
+
+    before = read_results(args.before)
+    after = read_results(args.after)
+
+    header = "{:<16}".format("level")
+    for time in TIMES:
+        header += " {:>22}".format("{} {} (us)".format(time, args.stat))
+    print(header)
+
+    regressions = []
+    for level, old in before.items():
+        new = after.get(level)
+        if new is None:
+            print("{:<16} missing from {}".format(level, args.after))
+            continue
+        line = "{:<16}".format(level)
+        for time in TIMES:
+            key = "{}_{}".format(time, args.stat)
+            change = percent(old[key], new[key])
+            line += " {:>7} -> {:>6} {:>+6.1f}%".format(old[key], new[key], change)
+            if args.threshold and change > args.threshold:
+                regressions.append("{} {} {:+.1f}%".format(level, key, change))
+        if new["result"] != old["result"]:
+            line += "  {} -> {}".format(old["result"], new["result"])
+        print(line)
+
+    if regressions:
+        print()
+        print("{} regressions over {}%:".format(len(regressions), args.threshold))
+        for regression in regressions:
+            print("  " + regression)
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -3,6 +3,22 @@ import re
 import os
 import traceback
 import sys
+import argparse
+
+parser = argparse.ArgumentParser(description="Converts assets/anims into the Mario animation table.")
+parser.add_argument("--compress", action="store_true",
+                    help="store each channel as a compressed track, decoded at runtime (ANIM_FLAG_COMPRESSED)")
+parser.add_argument("--quantize-rotations", type=int, default=0, metavar="BITS",
+                    help="with --compress, drop this many low bits from the rotation channels (lossy)")
+args = parser.parse_args()
+
+# Must match the track types, keyframe interval and channel limit in src/engine/graph_node.c
+ANIM_FLAG_COMPRESSED = 0x80
+ANIM_TRACK_CONSTANT = 0
+ANIM_TRACK_RAW = 1
+ANIM_TRACK_DELTA = 2
+ANIM_TRACK_KEYFRAME_INTERVAL = 16
+ANIM_MAX_CHANNELS = (1 + 64) * 3
 
 num_headers = 0
 items = []
@@ -49,6 +65,111 @@ def parse_array(filename, lines, lineindex, name, is_indices):
     lineindex += 1
     return lineindex
 
+def to_s16(value):
+    value &= 0xFFFF
+    return value - 0x10000 if value >= 0x8000 else value
+
+def wrap_signed(value, bits):
+    value &= (1 << bits) - 1
+    return value - (1 << bits) if value >= (1 << (bits - 1)) else value
+
+def quantize(value, shift):
+    if shift == 0:
+        return value
+    return wrap_signed((value + (1 << (shift - 1))) >> shift, 16 - shift)
+
+def s16_bytes(value):
+    return [(value >> 8) & 0xFF, value & 0xFF]
+
+def encode_track(values, shift):
+    """
+    Encode one channel's values. Each track starts with its type, quantize shift and frame count (big endian),
+    followed by either a single value, a value per frame, or the number of bits per delta, a keyframe every
+    ANIM_TRACK_KEYFRAME_INTERVAL frames and the bit packed deltas to each frame in between, whichever is smallest.
+    """
+    q = [quantize(v, shift) for v in values]
+    n = len(q)
+
+    def header(type):
+        return [type, shift, n >> 8, n & 0xFF]
+
+    if all(v == q[0] for v in q):
+        return header(ANIM_TRACK_CONSTANT) + s16_bytes(q[0])
+
+    raw = header(ANIM_TRACK_RAW) + [b for v in q for b in s16_bytes(v)]
+
+    keys = []
+    deltas = []
+    for i, v in enumerate(q):
+        if i % ANIM_TRACK_KEYFRAME_INTERVAL == 0:
+            keys.extend(s16_bytes(v))
+        else:
+            deltas.append(wrap_signed(v - q[i - 1], 16 - shift))
+
+    bits = 1
+    while any(not -(1 << (bits - 1)) <= d < (1 << (bits - 1)) for d in deltas):
+        bits += 1
+
+    packed = 0
+    for d in deltas:
+        packed = (packed << bits) | (d & ((1 << bits) - 1))
+    num_bytes = (len(deltas) * bits + 7) // 8
+    packed <<= num_bytes * 8 - len(deltas) * bits
+    delta = header(ANIM_TRACK_DELTA) + [bits] + keys + list(packed.to_bytes(num_bytes, "big"))
+
+    return delta if len(delta) < len(raw) else raw
+
+def decode_track(track, frame):
+    """Mirror of decode_animation_track in src/engine/graph_node.c, to check the encoded tracks."""
+    type, shift, n = track[0], track[1], (track[2] << 8) | track[3]
+    frame = max(0, min(frame, n - 1))
+    read_s16 = lambda i: to_s16((track[i] << 8) | track[i + 1])
+    if type == ANIM_TRACK_CONSTANT:
+        value = read_s16(4)
+    elif type == ANIM_TRACK_RAW:
+        value = read_s16(4 + frame * 2)
+    else:
+        bits = track[4]
+        key = frame // ANIM_TRACK_KEYFRAME_INTERVAL
+        num_keys = (n + ANIM_TRACK_KEYFRAME_INTERVAL - 1) // ANIM_TRACK_KEYFRAME_INTERVAL
+        deltas = (5 + num_keys * 2) * 8
+        value = read_s16(5 + key * 2)
+        for i in range(frame % ANIM_TRACK_KEYFRAME_INTERVAL):
+            pos = deltas + (key * (ANIM_TRACK_KEYFRAME_INTERVAL - 1) + i) * bits
+            word = int.from_bytes(bytes(track[pos // 8:pos // 8 + 3]).ljust(3, b"\0"), "big")
+            value += wrap_signed(word >> (24 - bits - pos % 8), bits)
+    return to_s16(value << shift)
+
+def compress_animation(name, indices, values):
+    """
+    Compress an index/values array pair into an index array of the channel count followed by each channel's
+    byte offset, and the channels' tracks. The first 3 channels are the translation, the rest are rotations.
+    """
+    indices = [int(i, 0) for i in indices]
+    values = [to_s16(int(v, 0)) for v in values]
+    num_channels = len(indices) // 2
+    if num_channels > ANIM_MAX_CHANNELS:
+        raise SyntaxError("Error: " + name + " has " + str(num_channels) + " channels, compressed animations can have at most " + str(ANIM_MAX_CHANNELS))
+    offsets = []
+    data = []
+
+    for channel in range(num_channels):
+        num_frames, start = indices[channel * 2], indices[channel * 2 + 1]
+        channel_values = values[start:start + num_frames]
+        shift = args.quantize_rotations if channel >= 3 else 0
+        track = encode_track(channel_values, shift)
+        for frame, value in enumerate(channel_values):
+            if decode_track(track, frame) != to_s16(quantize(value, shift) << shift):
+                raise SyntaxError("Error: compressed track " + str(channel) + " of " + name + " does not decode to its values")
+        offsets.append(len(data))
+        data.extend(track)
+
+    # The deltas are read 3 bytes at a time, which can go up to 2 bytes past the last track
+    data.extend([0, 0])
+    if len(data) > 0xFFFF:
+        raise SyntaxError("Error: compressed values of " + name + " do not fit in 64 KiB")
+    return [num_channels] + offsets, data
+
 def parse_file(filename, lines):
     global num_headers
     lineindex = 0
@@ -93,6 +214,24 @@ try:
             if lines:
                 parse_file(filename, lines)
 
+    if args.quantize_rotations < 0 or args.quantize_rotations > 8:
+        raise SyntaxError("Error: --quantize-rotations must be between 0 and 8")
+
+    # The values array each indices array is used with, as they're compressed together
+    compressed = {}
+    if args.compress:
+        values_for_indices = {}
+        for type, name, obj in items:
+            if type == "header":
+                values, indices = obj[5], obj[6]
+                if values_for_indices.setdefault(indices, values) != values:
+                    raise SyntaxError("Error: " + indices + " is used with more than one values array")
+        arrays = {name: obj[1] for type, name, obj in items if type == "array"}
+        for indices, values in values_for_indices.items():
+            if values in compressed:
+                raise SyntaxError("Error: " + values + " is used with more than one indices array")
+            compressed[indices], compressed[values] = compress_animation(indices, arrays[indices], arrays[values])
+
     structdef = ["u32 numEntries;", "const struct Animation *addrPlaceholder;", "struct OffsetSizePair entries[" + str(num_headers) + "];"]
     structobj = [str(num_headers) + ",", "NULL,","{"]
 
@@ -120,7 +259,7 @@ try:
             offset_to_end = "offsetof(struct MarioAnimsObj, " + values + ") + sizeof(gMarioAnims." + values + ")"
             structdef.append("struct Animation " + name + ";")
             structobj.append("{" + ", ".join([
-                str(v1),
+                str(v1 | ANIM_FLAG_COMPRESSED) if args.compress else str(v1),
                 str(v2),
                 str(v3),
                 str(v4),
@@ -133,6 +272,9 @@ try:
         else:
             is_indices, arr = obj
             type = "u16" if is_indices else "s16"
+            if name in compressed:
+                arr = [str(v) for v in compressed[name]]
+                type = "u16" if is_indices else "u8"
             structdef.append("{} {}[{}];".format(type, name, len(arr)))
             structobj.append("{" + ",".join(arr) + "},")
 
@@ -0,0 +1,170 @@
+#!/usr/bin/env python3
+"""
+Decodes per-frame profiler captures sent over USB with PROFILER_CAPTURE (see src/game/profiling.c).
+
+UNFLoader saves every packet the game sends as its own binaryout file. Pass them in the order they
+were received (their names sort that way), or a single file with the packets concatenated:
+
+    profiler_capture.py binaryout-*.bin
+    profiler_capture.py --csv frames.csv --flame frames.folded binaryout-*.bin
+
+Prints the min/avg/p99/max of every field and the worst frame time spikes, with the timings that
+grew the most compared to a typical frame. --csv writes one row per frame. --flame writes the nested
+timings ("cpu;mario") in the folded format used by flamegraph.pl and speedscope, with each parent's
+own time being what isn't accounted for by its children.
+"""
+import argparse
+import struct
+import sys
+
+HEADER_MAGIC = 0x50435031  # "PCP1"
+FRAMES_MAGIC = 0x5046524D  # "PFRM"
+PACKET_FORMAT = ">IHH"
+PACKET_SIZE = struct.calcsize(PACKET_FORMAT)
+
+UNIT_MICROSECONDS = 0
+UNIT_COUNT = 1
+
+
+class Field:
+    def __init__(self, name, unit):
+        self.name = name
+        self.unit = unit
+
+    def suffix(self):
+        return "us" if self.unit == UNIT_MICROSECONDS else ""
+
+
+class Capture:
+    def __init__(self, fields):
+        self.fields = fields
+        self.frames = []  # (gGlobalTimer, [values])
+
+
+def read_packets(data, captures, path):
+    offset = 0
+    while offset + PACKET_SIZE <= len(data):
+        magic, numFields, numFrames = struct.unpack_from(PACKET_FORMAT, data, offset)
+        offset += PACKET_SIZE
+
+        if magic == HEADER_MAGIC:
+            fields = []
+            for _ in range(numFields):
+                unit = data[offset]
+                end = data.index(b"\0", offset + 1)
+                fields.append(Field(data[offset + 1:end].decode("ascii"), unit))
+                offset = end + 1
+            offset = (offset + 3) & ~3
+            captures.append(Capture(fields))
+        elif magic == FRAMES_MAGIC:
+            if not captures or len(captures[-1].fields) != numFields:
+                sys.exit("{}: frame packet without a matching header packet".format(path))
+            recordFormat = ">I{}H".format(numFields)
+            recordSize = (struct.calcsize(recordFormat) + 3) & ~3
+            for _ in range(numFrames):
+                values = struct.unpack_from(recordFormat, data, offset)
+                captures[-1].frames.append((values[0], list(values[1:])))
+                offset += recordSize
+        else:
+            sys.exit("{}: unknown packet 0x{:08X} at offset 0x{:X}".format(path, magic, offset - PACKET_SIZE))
+
+
+def percentile(sortedValues, fraction):
+    index = min(len(sortedValues) - 1, int(fraction * len(sortedValues)))
+    return sortedValues[index]
+
+
+def print_summary(capture, numSpikes, spikeThreshold):
+    fields = capture.fields
+    columns = list(zip(*[values for _, values in capture.frames]))
+    medians = []
+
+    print("{} frames, timers {} to {}".format(len(capture.frames), capture.frames[0][0], capture.frames[-1][0]))
+    print()
+    print("{:<28} {:>9} {:>9} {:>9} {:>9}".format("field", "min", "avg", "p99", "max"))
+    for field, column in zip(fields, columns):
+        ordered = sorted(column)
+        medians.append(percentile(ordered, 0.5))
+        print("{:<28} {:>9} {:>9.0f} {:>9} {:>9} {}".format(field.name, ordered[0], sum(ordered) / len(ordered),
+                                                         percentile(ordered, 0.99), ordered[-1], field.suffix()))
+
+    names = [field.name for field in fields]
+    if "frame" not in names:
+        return
+    frameIndex = names.index("frame")
+    threshold = spikeThreshold if spikeThreshold else medians[frameIndex] * 1.5
+
+    spikes = [frame for frame in capture.frames if frame[1][frameIndex] > threshold]
+    spikes.sort(key=lambda frame: frame[1][frameIndex], reverse=True)
+
+    print()
+    print("{} frames over {:.0f}us (median frame {}us)".format(len(spikes), threshold, medians[frameIndex]))
+    for timer, values in spikes[:numSpikes]:
+        # The timings that grew the most compared to the median frame.
+        growth = []
+        for i, field in enumerate(fields):
+            if field.unit == UNIT_MICROSECONDS and i != frameIndex and ";" in field.name:
+                growth.append((values[i] - medians[i], field.name, values[i]))
+        growth.sort(reverse=True)
+        causes = ", ".join("{} {}us (+{})".format(name, value, delta) for delta, name, value in growth[:3] if delta > 0)
+        print("  timer {:>8}: {:>6}us  {}".format(timer, values[frameIndex], causes))
+
+
+def write_csv(captures, path):
+    with open(path, "w") as file:
+        for capture in captures:
+            file.write(",".join(["timer"] + [field.name for field in capture.fields]) + "\n")
+            for timer, values in capture.frames:
+                file.write(",".join(str(value) for value in [timer] + values) + "\n")
+
+
+def write_flame(captures, path):
+    totals = {}
+    for capture in captures:
+        names = [field.name for field in capture.fields]
+        timed = [i for i, field in enumerate(capture.fields) if field.unit == UNIT_MICROSECONDS]
+        nested = [i for i in timed if ";" in names[i] or any(other.startswith(names[i] + ";") for other in names)]
+
+        for _, values in capture.frames:
+            for i in nested:
+                children = [j for j in nested if names[j].startswith(names[i] + ";") and names[j].count(";") == names[i].count(";") + 1]
+                own = values[i] - sum(values[j] for j in children) if children else values[i]
+                totals[names[i]] = totals.get(names[i], 0) + max(own, 0)
+
+    with open(path, "w") as file:
+        for name, total in totals.items():
+            file.write("{} {}\n".format(name, total))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode per-frame profiler captures sent over USB.")
+    parser.add_argument("files", nargs="+", help="binaryout files saved by UNFLoader, in order")
+    parser.add_argument("--csv", help="write every frame's values to this CSV file")
+    parser.add_argument("--flame", help="write the total nested timings to this folded stack file")
+    parser.add_argument("--spikes", type=int, default=10, help="number of spike frames to list (default 10)")
+    parser.add_argument("--spike-us", type=int, default=0, help="frame time that counts as a spike (default 1.5x the median)")
+    args = parser.parse_args()
+
+    captures = []
+    for path in args.files:
+        with open(path, "rb") as file:
+            read_packets(file.read(), captures, path)
+
+    captures = [capture for capture in captures if capture.frames]
+    if not captures:
+        sys.exit("no frames captured")
+
+    for i, capture in enumerate(captures):
+        if len(captures) > 1:
+            print("capture {}:".format(i + 1))
+        print_summary(capture, args.spikes, args.spike_us)
+        print()
+
+    if args.csv:
+        write_csv(captures, args.csv)
+    if args.flame:
+        write_flame(captures, args.flame)
+
+
+if __name__ == "__main__":
+    main()